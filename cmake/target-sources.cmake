@@ -1,9 +1,51 @@
 # a function which adds otest2 sources to a specified target
 #
-# Usage: target_otest2_sources(<target> [DOMAIN <domain>] sources...)
+# Usage: target_otest2_sources(<target> [DOMAIN <domain>] [BATCH] [UNITY]
+#                               [PCH <header>] sources...)
+#
+# If the BATCH option is set or the OTEST2_BATCH_SOURCES variable is true, all
+# the sources are processed by one invocation of the preprocessor.
+#
+# If the UNITY option is set or the OTEST2_UNITY_SOURCES variable is true, all
+# the generated sources are compiled as one translation unit. Sources defining
+# a suite or a class whose name is already defined in the unit are compiled
+# separately.
+#
+# The PCH header is precompiled and included into all the sources by the
+# preprocessor.
+#
+# The preprocessor doesn't touch generated sources whose content hasn't
+# changed. Hence, the custom commands produce stamp files and the generated
+# sources are just their byproducts. Otherwise, the unchanged sources would
+# stay older than their dependencies and the preprocessor would run again
+# at every build.
+
+# -- Collect names of the suites and classes defined in a test source. The
+#    source is scanned by regular expressions, hence the list may contain
+#    more names than the source really defines. The project is configured
+#    again when the source changes.
+function(_OTEST2_DEFINED_NAMES src result)
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS ${src})
+  file(READ ${src} content)
+  set(space "[ \t\r\n]*")
+  set(ident "[A-Za-z_][A-Za-z0-9_]*")
+  string(REGEX MATCHALL "(TEST_SUITE|OT2_SUITE)${space}\\(${space}${ident}"
+      suites "${content}")
+  string(REGEX MATCHALL "(class|struct)[ \t\r\n]+${ident}${space}[:{]"
+      classes "${content}")
+  set(names "")
+  foreach(item IN LISTS suites classes)
+    string(REGEX REPLACE "^(TEST_SUITE|OT2_SUITE|class|struct)" "" item "${item}")
+    string(REGEX MATCH "${ident}" name "${item}")
+    list(APPEND names ${name})
+  endforeach()
+  set(${result} ${names} PARENT_SCOPE)
+endfunction()
+
 function(TARGET_OTEST2_SOURCES target)
-  set(one_value_args DOMAIN)
-  cmake_parse_arguments(OTEST2 "" "${one_value_args}" "" ${ARGN})
+  set(options BATCH UNITY)
+  set(one_value_args DOMAIN PCH)
+  cmake_parse_arguments(OTEST2 "${options}" "${one_value_args}" "" ${ARGN})
   
   if(OTEST2_DOMAIN)
     set(domain_arg "-d${OTEST2_DOMAIN}")
@@ -11,26 +53,140 @@ function(TARGET_OTEST2_SOURCES target)
     set(domain_arg "")
   endif()
 
-  foreach(src IN LISTS OTEST2_UNPARSED_ARGUMENTS)
-    set(gensrc "${CMAKE_CURRENT_SOURCE_DIR}/${src}.cpp")
-    set(includes "$<TARGET_PROPERTY:${target},INCLUDE_DIRECTORIES>")
-    set(cdefs "$<TARGET_PROPERTY:${target},COMPILE_DEFINITIONS>")
+  if(OTEST2_PCH)
+    set(pch_header "${CMAKE_CURRENT_SOURCE_DIR}/${OTEST2_PCH}")
+    get_filename_component(pch_name ${OTEST2_PCH} NAME)
+    set(pch_args
+        -p ${pch_header}
+        -P "${CMAKE_CURRENT_BINARY_DIR}/${target}.${pch_name}.otest2.pch")
+  else()
+    set(pch_header "")
+    set(pch_args "")
+  endif()
+
+  set(includes "$<TARGET_PROPERTY:${target},INCLUDE_DIRECTORIES>")
+  set(cdefs "$<TARGET_PROPERTY:${target},COMPILE_DEFINITIONS>")
+  # -- the test files are parsed in the language standard of the target
+  set(cxxstd "$<TARGET_PROPERTY:${target},CXX_STANDARD>")
+
+  if(OTEST2_BATCH OR OTEST2_BATCH_SOURCES)
+    # -- one list file per an invocation of this function
+    get_property(batch_index TARGET ${target} PROPERTY OTEST2_BATCH_INDEX)
+    if(NOT batch_index)
+      set(batch_index 0)
+    endif()
+    math(EXPR next_index "${batch_index} + 1")
+    set_property(TARGET ${target} PROPERTY OTEST2_BATCH_INDEX ${next_index})
+    set(batch_file
+        "${CMAKE_CURRENT_BINARY_DIR}/${target}.otest2-${batch_index}.list")
+    set(stamps
+        "${CMAKE_CURRENT_BINARY_DIR}/${target}.otest2-${batch_index}.stamp")
+
+    set(batch_content "")
+    set(gensrcs "")
+    set(srcs "")
+    foreach(src IN LISTS OTEST2_UNPARSED_ARGUMENTS)
+      set(gensrc "${CMAKE_CURRENT_SOURCE_DIR}/${src}.cpp")
+      string(APPEND batch_content
+          "${CMAKE_CURRENT_SOURCE_DIR}/${src}\t${gensrc}\n")
+      list(APPEND gensrcs ${gensrc})
+      list(APPEND srcs ${src})
+    endforeach()
+    file(GENERATE OUTPUT ${batch_file} CONTENT "${batch_content}")
+
     add_custom_command(
-        OUTPUT ${gensrc}
+        OUTPUT ${stamps}
+        BYPRODUCTS ${gensrcs}
         COMMAND otest2
-            -s ${CMAKE_CURRENT_SOURCE_DIR}/${src}
-            -o ${gensrc} 
+            -b ${batch_file}
             ${domain_arg}
+            ${pch_args}
             --
             "$<$<BOOL:${includes}>:-I$<JOIN:${includes},;-I>>"
             "$<$<BOOL:${cdefs}>:-D$<JOIN:${cdefs},;-D>>"
+            "$<$<BOOL:${cxxstd}>:-std=c++${cxxstd}>"
             "$<JOIN:$<TARGET_PROPERTY:${target},COMPILE_OPTIONS>,;>"
-        DEPENDS ${src} otest2
+        COMMAND ${CMAKE_COMMAND} -E touch ${stamps}
+        DEPENDS ${srcs} ${batch_file} ${pch_header} otest2
         COMMAND_EXPAND_LISTS
     )
-    target_sources(${target} PRIVATE ${gensrc})
-    set_directory_properties(PROPERTIES ADDITIONAL_MAKE_CLEAN_FILES ${gensrc})
-  endforeach()
+  else()
+    set(gensrcs "")
+    set(stamps "")
+    foreach(src IN LISTS OTEST2_UNPARSED_ARGUMENTS)
+      set(gensrc "${CMAKE_CURRENT_SOURCE_DIR}/${src}.cpp")
+      string(MAKE_C_IDENTIFIER ${src} stamp_name)
+      set(stamp "${CMAKE_CURRENT_BINARY_DIR}/${target}.${stamp_name}.otest2.stamp")
+      add_custom_command(
+          OUTPUT ${stamp}
+          BYPRODUCTS ${gensrc}
+          COMMAND otest2
+              -s ${CMAKE_CURRENT_SOURCE_DIR}/${src}
+              -o ${gensrc} 
+              ${domain_arg}
+              ${pch_args}
+              --
+              "$<$<BOOL:${includes}>:-I$<JOIN:${includes},;-I>>"
+              "$<$<BOOL:${cdefs}>:-D$<JOIN:${cdefs},;-D>>"
+              "$<$<BOOL:${cxxstd}>:-std=c++${cxxstd}>"
+              "$<JOIN:$<TARGET_PROPERTY:${target},COMPILE_OPTIONS>,;>"
+          COMMAND ${CMAKE_COMMAND} -E touch ${stamp}
+          DEPENDS ${src} ${pch_header} otest2
+          COMMAND_EXPAND_LISTS
+      )
+      list(APPEND gensrcs ${gensrc})
+      list(APPEND stamps ${stamp})
+    endforeach()
+  endif()
+
+  if(OTEST2_UNITY OR OTEST2_UNITY_SOURCES)
+    # -- The generated sources are included into one unity source. They are
+    #    still listed in the target to be generated, but they're not compiled
+    #    separately.
+    get_property(unity_index TARGET ${target} PROPERTY OTEST2_UNITY_INDEX)
+    if(NOT unity_index)
+      set(unity_index 0)
+    endif()
+    math(EXPR next_index "${unity_index} + 1")
+    set_property(TARGET ${target} PROPERTY OTEST2_UNITY_INDEX ${next_index})
+    set(unity_file
+        "${CMAKE_CURRENT_BINARY_DIR}/${target}.otest2-unity-${unity_index}.cpp")
+
+    # -- The suites are generated as classes in place of the suite
+    #    namespaces. Two suites of the same name (or two classes of the same
+    #    name) are legal in separate files if they are placed in anonymous
+    #    namespaces, but they would collide in one translation unit. Such
+    #    sources are compiled separately.
+    set(unity_content "")
+    set(unity_srcs "")
+    set(separate_srcs "")
+    set(unity_names "")
+    foreach(src IN LISTS OTEST2_UNPARSED_ARGUMENTS)
+      set(gensrc "${CMAKE_CURRENT_SOURCE_DIR}/${src}.cpp")
+      _otest2_defined_names("${CMAKE_CURRENT_SOURCE_DIR}/${src}" names)
+      set(conflict FALSE)
+      foreach(name IN LISTS names)
+        if(name IN_LIST unity_names)
+          set(conflict TRUE)
+        endif()
+      endforeach()
+      if(conflict)
+        list(APPEND separate_srcs ${gensrc})
+      else()
+        list(APPEND unity_names ${names})
+        list(APPEND unity_srcs ${gensrc})
+        string(APPEND unity_content "#include \"${gensrc}\"\n")
+      endif()
+    endforeach()
+    file(GENERATE OUTPUT ${unity_file} CONTENT "${unity_content}")
+
+    set_source_files_properties(${unity_srcs} PROPERTIES HEADER_FILE_ONLY ON)
+    set_source_files_properties(${unity_file} PROPERTIES OBJECT_DEPENDS "${unity_srcs}")
+    target_sources(${target} PRIVATE ${unity_file} ${gensrcs} ${stamps})
+  else()
+    target_sources(${target} PRIVATE ${gensrcs} ${stamps})
+  endif()
+  set_directory_properties(PROPERTIES ADDITIONAL_MAKE_CLEAN_FILES "${gensrcs}")
 endfunction()
 
 # -- name of the default template of the main.cpp
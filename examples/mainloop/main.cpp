@@ -21,33 +21,70 @@
 #include <otest2/dfltenvironment.h>
 #include <otest2/runner.h>
 #include <sys/time.h>
+#include <vector>
 
 namespace {
 
 struct Loop {
     event_base* base;
     event* ev;
+    std::vector<event*> wait_events;
     ::OTest2::Runner* runner;
     bool result;
 };
 
+void timerCallback(
+    evutil_socket_t,
+    short,
+    void* udata_);
+
 void scheduleTimer(
     Loop* loop_,
     int delay_) {
-  struct timeval period_ = {delay_ / 1000, (delay_ % 1000) * 1000000};
+  struct timeval period_ = {delay_ / 1000, (delay_ % 1000) * 1000};
   event_add(loop_->ev, &period_);
 }
 
+void scheduleWaitSources(
+    Loop* loop_,
+    const ::OTest2::WaitSources& sources_) {
+  for(const auto& source_ : sources_) {
+    short what_(0);
+    if(source_.getEvents() & ::OTest2::WaitSource::READ)
+      what_ |= EV_READ;
+    if(source_.getEvents() & ::OTest2::WaitSource::WRITE)
+      what_ |= EV_WRITE;
+    event* ev_(event_new(
+        loop_->base, source_.getFD(), what_, timerCallback, loop_));
+    event_add(ev_, nullptr);
+    loop_->wait_events.push_back(ev_);
+  }
+}
+
+void cancelWaitSources(
+    Loop* loop_) {
+  event_del(loop_->ev);
+  for(event* ev_ : loop_->wait_events)
+    event_free(ev_);
+  loop_->wait_events.clear();
+}
+
 void timerCallback(
     evutil_socket_t,
     short,
     void* udata_) {
   Loop* loop_(static_cast<Loop*>(udata_));
 
+  /* -- The test step is run either by the timer or by any of the events
+   *    the test waits for. Cancel the others. */
+  cancelWaitSources(loop_);
+
   ::OTest2::RunnerResult result_(loop_->runner->runNext());
   if(!result_.isFinished()) {
-    /* -- The test is not finished yet, schedule next test step. */
+    /* -- The test is not finished yet, schedule next test step. The delay
+     *    works as a timeout if the test waits for some events. */
     scheduleTimer(loop_, result_.getDelayMS());
+    scheduleWaitSources(loop_, result_.getWaitSources());
   }
   else {
     /* -- The test is finished. Stop the main loop and return the test
@@ -78,6 +115,7 @@ int main(
   event_base_dispatch(loop_.base);
 
   /* -- clean up the main loop */
+  cancelWaitSources(&loop_);
   event_free(loop_.ev);
   event_base_free(loop_.base);
 
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2_INCLUDE_OTEST2_ALLOCATIONTRACKER_H_
+#define OTest2_INCLUDE_OTEST2_ALLOCATIONTRACKER_H_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OTest2 {
+
+/**
+ * @brief Counters of heap allocations
+ */
+struct AllocationStats {
+    std::int64_t allocations;       /**< number of allocations */
+    std::int64_t deallocations;     /**< number of deallocations */
+    std::int64_t bytes;             /**< number of allocated bytes */
+};
+
+/**
+ * @brief Counting of heap allocations
+ *
+ * The allocations are counted just if the instrumentation library
+ * (otest2alloc) is linked into the test binary. The library replaces
+ * the global operators new and delete and records the calls. The counters
+ * are kept per a thread, so the allocations are attributed to the testing
+ * object running in the thread.
+ */
+class AllocationTracker {
+  public:
+    /* -- the class is just a namespace of static functions */
+    AllocationTracker() = delete;
+
+    /**
+     * @brief Check whether the instrumentation library is linked
+     */
+    static bool isInstalled() noexcept;
+
+    /**
+     * @brief Get current counters of the running thread
+     */
+    static AllocationStats sample() noexcept;
+
+    /**
+     * @brief Mark the instrumentation as present
+     *
+     * This function is invoked by the instrumentation library.
+     */
+    static void install() noexcept;
+
+    /**
+     * @brief Record one allocation
+     *
+     * This function is invoked by the instrumentation library.
+     *
+     * @param size_ Size of the allocated block
+     */
+    static void recordAllocation(
+        std::size_t size_) noexcept;
+
+    /**
+     * @brief Record one deallocation
+     *
+     * This function is invoked by the instrumentation library.
+     */
+    static void recordDeallocation() noexcept;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_ALLOCATIONTRACKER_H_ */
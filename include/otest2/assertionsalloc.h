@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2_INCLUDE_OTEST2_ASSERTIONSALLOC_H_
+#define OTest2_INCLUDE_OTEST2_ASSERTIONSALLOC_H_
+
+#include <cstdint>
+#include <functional>
+
+#include <otest2/assertcontext.h>
+#include <otest2/assertionannotation.h>
+
+namespace OTest2 {
+
+/**
+ * @brief Implementation class of the allocation assertions
+ */
+class AllocationAssertion : public AssertContext {
+  public:
+    /* -- avoid copying */
+    AllocationAssertion(
+        const AllocationAssertion&) = delete;
+    AllocationAssertion& operator = (
+        const AllocationAssertion&) = delete;
+
+    /* -- inherit the constructor - the parent constructor is invoked
+     *    from the test suite generated code. */
+    using AssertContext::AssertContext;
+
+    /* -- allocation budgets */
+    bool testAssertMaxAllocations(
+        std::int64_t limit_,
+        const std::function<void()>& fce_);
+};
+
+namespace Assertions {
+
+/**
+ * @brief Check number of heap allocations made by a code block
+ *
+ * The assertion invokes the function @a fce_ and counts the allocations
+ * made by the running thread meanwhile. The assertion fails if there are
+ * more allocations than @a limit_:
+ * @code
+ * testAssertMaxAllocations(0, [&]() {
+ *   parser.parse(input);
+ * });
+ * @endcode
+ *
+ * The allocations are counted just if the instrumentation library
+ * (otest2alloc) is linked into the test binary. Otherwise the assertion
+ * fails.
+ *
+ * @param limit_ Maximal number of allocations
+ * @param fce_ The checked code
+ * @return True if the assertion passes
+ */
+bool testAssertMaxAllocations(
+    std::int64_t limit_,
+    const std::function<void()>& fce_)
+TEST_ASSERTION_MARK(::OTest2::AllocationAssertion, testAssertMaxAllocations);
+
+} /* -- namespace Assertions */
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_ASSERTIONSALLOC_H_ */
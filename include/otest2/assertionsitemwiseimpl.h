@@ -32,6 +32,7 @@
 #include <vector>
 
 #include <otest2/assertstream.h>
+#include <otest2/bulkcompare.h>
 #include <otest2/comparisons.h>
 #include <otest2/containertrait.h>
 #include <otest2/printtraits.h>
@@ -56,9 +57,11 @@ bool compareListsItemWise(
   typedef typename AssertionParameter<decltype(*begin_b_)>::Type BType_;
   typedef Compare_<AType_, BType_> Comparator_;
 
+  /* -- skip leading items of contiguous ranges checked in bulk */
+  int index_(bulkSkipPassingItems<Compare_>(begin_a_, end_a_, begin_b_, end_b_));
+
   /* -- iterate and check items */
   Comparator_ cmp_;
-  int index_(0);
   while(begin_a_ != end_a_ && begin_b_ != end_b_) {
     bool condition_(cmp_(*begin_a_, *begin_b_));
     if(!condition_) {
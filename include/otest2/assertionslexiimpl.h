@@ -29,6 +29,7 @@
 #include <vector>
 
 #include <otest2/assertstream.h>
+#include <otest2/bulkcompare.h>
 #include <otest2/containertrait.h>
 #include <otest2/printtraits.h>
 #include <otest2/printutils.h>
@@ -49,7 +50,8 @@ bool compareListsLexicographically(
   typedef typename AssertionParameter<decltype(*begin_b_)>::Type BType_;
   typedef Compare_<AType_, BType_> Comparator_;
 
-  int index_(0);
+  /* -- skip common prefix of contiguous ranges checked in bulk */
+  int index_(bulkSkipCommonPrefix<Compare_>(begin_a_, end_a_, begin_b_, end_b_));
   Comparator_ cmp_;
   std::ostringstream sos_;
   while(begin_a_ != end_a_ && begin_b_ != end_b_) {
@@ -22,6 +22,7 @@
 
 #include <otest2/assertcontext.h>
 #include <otest2/assertionannotation.h>
+#include <otest2/const.h>
 
 namespace OTest2 {
 
@@ -44,6 +45,12 @@ namespace OTest2 {
  *
  * The algorithm is controlled by the MapContainerTrait. The default
  * implementation works with STL-like maps.
+ *
+ * The testAssertMapFull() assertion doesn't stop at the first difference.
+ * It computes complete counts of missing, extra and different keys in one
+ * pass and it reports a bounded number of them. Two ordered maps with
+ * the same key comparator are compared by one merge pass, other maps
+ * are compared by a hash join (probing the other map by the keys).
  */
 class MapAssertion : public AssertContext {
   private:
@@ -64,6 +71,11 @@ class MapAssertion : public AssertContext {
     bool testAssertMap(
         const ContainerA_& a_,
         const ContainerB_& b_);
+    template<template<typename, typename> class Compare_, typename ContainerA_, typename ContainerB_>
+    bool testAssertMapFull(
+        const ContainerA_& a_,
+        const ContainerB_& b_,
+        int max_reported_ = DEFAULT_MAP_REPORTED_KEYS);
 };
 
 namespace Assertions {
@@ -82,6 +94,24 @@ bool testAssertMap(
     const ContainerB_& b_)
 TEST_ASSERTION_MARK_TMPL("::OTest2::MapAssertion", "testAssertMap< ::$1 >");
 
+/**
+ * @brief Compare content of two maps and report all differences
+ *
+ * @tparam Compare_ The relation comparator template
+ * @param a_ The first container
+ * @param b_ The second container
+ * @param max_reported_ Maximal number of reported keys per a kind
+ *     of the difference (missing in b, missing in a, different values).
+ *     The counts are always complete.
+ * @return True if the values fit the comparator
+ */
+template<template<typename, typename> class Compare_, typename ContainerA_, typename ContainerB_>
+bool testAssertMapFull(
+    const ContainerA_& a_,
+    const ContainerB_& b_,
+    int max_reported_ = DEFAULT_MAP_REPORTED_KEYS)
+TEST_ASSERTION_MARK_TMPL("::OTest2::MapAssertion", "testAssertMapFull< ::$1 >");
+
 } /* -- namespace Assertions */
 
 } /* -- namespace OTest2 */
@@ -23,9 +23,12 @@
 #include <otest2/assertionsmap.h>
 
 #include <assert.h>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include <otest2/assertstream.h>
@@ -54,6 +57,7 @@ bool compareMaps(
   first_line_ << "the assertion a ";
   PrintTrait<Comparator_>::print(first_line_, cmp_);
   first_line_ << " b has ";
+  const std::string prefix_(first_line_.str());
 
   /* -- compare left map against the right one */
   auto iter_a_(MapContainerTrait<ContainerA_>::begin(a_));
@@ -64,7 +68,7 @@ bool compareMaps(
     if(range_b_.first == range_b_.second) {
       /* -- the key is not found in the second map */
       std::ostringstream sos_;
-      sos_ << first_line_.str() << "failed: the item <";
+      sos_ << prefix_ << "failed: the item <";
       PrintTrait<AKey_>::print(sos_, (*iter_a_).first);
       sos_ << ", ";
       PrintTrait<AValue_>::print(sos_, (*iter_a_).second);
@@ -80,7 +84,7 @@ bool compareMaps(
          || !MapContainerTrait<ContainerA_>::keyEqual(a_, (*iter_a_).first, (*range_b_.first).first)) {
         /* -- the subsequence is shorter in the map a */
         std::ostringstream sos_;
-        sos_ << first_line_.str() << "failed: the subsequence of items with the key ";
+        sos_ << prefix_ << "failed: the subsequence of items with the key ";
         PrintTrait<BKey_>::print(sos_, (*range_b_.first).first);
         sos_ << " is shorter in the map a than in the map b";
         messages_.push_back(sos_.str());
@@ -91,7 +95,7 @@ bool compareMaps(
       if(!cmp_((*iter_a_).second, (*range_b_.first).second)) {
         /* -- the values dont't fit operator */
         std::ostringstream sos_;
-        sos_ << first_line_.str() << "failed: check a[";
+        sos_ << prefix_ << "failed: check a[";
         PrintTrait<AKey_>::print(sos_, (*iter_a_).first);
         sos_ << "] ";
         PrintTrait<Comparator_>::print(sos_, cmp_);
@@ -130,7 +134,7 @@ bool compareMaps(
         }
 
         std::ostringstream sos_;
-        sos_ << first_line_.str() << "failed: the subsequence of items with the key ";
+        sos_ << prefix_ << "failed: the subsequence of items with the key ";
         PrintTrait<AKey_>::print(sos_, (*iter_a_).first);
         sos_ << " is longer in the map a than in the map b";
         messages_.push_back(sos_.str());
@@ -152,7 +156,7 @@ bool compareMaps(
     if(range_a_.first == range_a_.second) {
       /* -- the key is not found in the first map */
       std::ostringstream sos_;
-      sos_ << first_line_.str() << "failed: the item <";
+      sos_ << prefix_ << "failed: the item <";
       PrintTrait<BKey_>::print(sos_, (*iter_b_).first);
       sos_ << ", ";
       PrintTrait<BValue_>::print(sos_, (*iter_b_).second);
@@ -167,12 +171,342 @@ bool compareMaps(
   }
 
   std::ostringstream sos_;
-  sos_ << first_line_.str() << "passed";
+  sos_ << prefix_ << "passed";
   messages_.push_back(sos_.str());
 
   return true;
 }
 
+
+/**
+ * @brief One kind of differences found by the full map comparison
+ */
+struct MapDiffCategory {
+    std::size_t count;
+    std::vector<std::string> messages;
+
+    MapDiffCategory() :
+      count(0),
+      messages() {
+
+    }
+};
+
+/**
+ * @brief Bounded report of the full map comparison
+ *
+ * The counts are complete. The messages are formatted only for the first
+ * @a limit keys of each category.
+ */
+struct MapDiffReport {
+    const std::size_t limit;
+    MapDiffCategory missing_in_b;
+    MapDiffCategory missing_in_a;
+    MapDiffCategory different;
+
+    explicit MapDiffReport(
+        int limit_) :
+      limit(limit_ > 0 ? limit_ : 0),
+      missing_in_b(),
+      missing_in_a(),
+      different() {
+
+    }
+
+    bool passed() const {
+      return missing_in_b.count == 0
+          && missing_in_a.count == 0
+          && different.count == 0;
+    }
+
+    /**
+     * @brief Count a difference and check whether it should be reported
+     */
+    bool countDifference(
+        MapDiffCategory& category_) const {
+      ++category_.count;
+      return category_.messages.size() < limit;
+    }
+};
+
+/**
+ * @brief Get end of a subsequence of items with the same key
+ */
+template<typename Container_, typename Iter_>
+Iter_ mapKeyGroupEnd(
+    const Container_& cont_,
+    Iter_ iter_,
+    Iter_ end_) {
+  Iter_ next_(iter_);
+  ++next_;
+  while(next_ != end_
+        && MapContainerTrait<Container_>::keyEqual(cont_, (*next_).first, (*iter_).first)) {
+    ++next_;
+  }
+  return next_;
+}
+
+template<typename Key_, typename Value_, typename Iter_>
+void reportMissingMapItem(
+    MapDiffReport& report_,
+    MapDiffCategory& category_,
+    Iter_ item_,
+    const char* map_name_) {
+  if(report_.countDifference(category_)) {
+    std::ostringstream sos_;
+    sos_ << "the item <";
+    PrintTrait<Key_>::print(sos_, (*item_).first);
+    sos_ << ", ";
+    PrintTrait<Value_>::print(sos_, (*item_).second);
+    sos_ << "> is not present in the map " << map_name_;
+    category_.messages.push_back(sos_.str());
+  }
+}
+
+/**
+ * @brief Compare two subsequences of items with the same key
+ */
+template<
+    typename Comparator_,
+    typename AKey_,
+    typename AValue_,
+    typename BKey_,
+    typename BValue_,
+    typename IterA_,
+    typename IterB_>
+void compareMapKeyGroups(
+    MapDiffReport& report_,
+    const Comparator_& cmp_,
+    IterA_ iter_a_,
+    IterA_ end_a_,
+    IterB_ iter_b_,
+    IterB_ end_b_) {
+  for(; iter_a_ != end_a_ && iter_b_ != end_b_; ++iter_a_, ++iter_b_) {
+    if(!cmp_((*iter_a_).second, (*iter_b_).second)) {
+      if(report_.countDifference(report_.different)) {
+        std::ostringstream sos_;
+        sos_ << "check a[";
+        PrintTrait<AKey_>::print(sos_, (*iter_a_).first);
+        sos_ << "] ";
+        PrintTrait<Comparator_>::print(sos_, cmp_);
+        sos_ << " b[";
+        PrintTrait<BKey_>::print(sos_, (*iter_b_).first);
+        sos_ << "] has failed: a[";
+        PrintTrait<AKey_>::print(sos_, (*iter_a_).first);
+        sos_ << "] = ";
+        PrintTrait<AValue_>::print(sos_, (*iter_a_).second);
+        sos_ << ", b[";
+        PrintTrait<BKey_>::print(sos_, (*iter_b_).first);
+        sos_ << "] = ";
+        PrintTrait<BValue_>::print(sos_, (*iter_b_).second);
+        report_.different.messages.push_back(sos_.str());
+      }
+      return;
+    }
+  }
+
+  if(iter_a_ != end_a_) {
+    if(report_.countDifference(report_.different)) {
+      std::ostringstream sos_;
+      sos_ << "the subsequence of items with the key ";
+      PrintTrait<AKey_>::print(sos_, (*iter_a_).first);
+      sos_ << " is longer in the map a than in the map b";
+      report_.different.messages.push_back(sos_.str());
+    }
+  }
+  else if(iter_b_ != end_b_) {
+    if(report_.countDifference(report_.different)) {
+      std::ostringstream sos_;
+      sos_ << "the subsequence of items with the key ";
+      PrintTrait<BKey_>::print(sos_, (*iter_b_).first);
+      sos_ << " is shorter in the map a than in the map b";
+      report_.different.messages.push_back(sos_.str());
+    }
+  }
+}
+
+template<typename ContainerA_, typename ContainerB_, bool ordered_>
+struct CanMergeMaps {
+    static constexpr bool value = false;
+};
+
+template<typename ContainerA_, typename ContainerB_>
+struct CanMergeMaps<ContainerA_, ContainerB_, true> {
+    static constexpr bool value =
+        std::is_same<
+            typename MapContainerTrait<ContainerA_>::KeyType,
+            typename MapContainerTrait<ContainerB_>::KeyType>::value
+        && std::is_same<
+            typename MapContainerTrait<ContainerA_>::KeyCompare,
+            typename MapContainerTrait<ContainerB_>::KeyCompare>::value;
+};
+
+template<
+    template<typename, typename> class Compare_,
+    typename ContainerA_,
+    typename ContainerB_,
+    bool merge_>
+struct MapDiffer;
+
+/**
+ * @brief Full comparison of two ordered maps - one merge pass
+ */
+template<template<typename, typename> class Compare_, typename ContainerA_, typename ContainerB_>
+struct MapDiffer<Compare_, ContainerA_, ContainerB_, true> {
+    template<typename Comparator_, typename AKey_, typename AValue_, typename BKey_, typename BValue_>
+    static void diff(
+        MapDiffReport& report_,
+        const Comparator_& cmp_,
+        const ContainerA_& a_,
+        const ContainerB_& b_) {
+      typedef MapContainerTrait<ContainerA_> TraitA_;
+      typedef MapContainerTrait<ContainerB_> TraitB_;
+
+      auto iter_a_(TraitA_::begin(a_));
+      auto end_a_(TraitA_::end(a_));
+      auto iter_b_(TraitB_::begin(b_));
+      auto end_b_(TraitB_::end(b_));
+      while(iter_a_ != end_a_ && iter_b_ != end_b_) {
+        if(TraitA_::keyLess(a_, (*iter_a_).first, (*iter_b_).first)) {
+          reportMissingMapItem<AKey_, AValue_>(report_, report_.missing_in_b, iter_a_, "b");
+          iter_a_ = mapKeyGroupEnd(a_, iter_a_, end_a_);
+        }
+        else if(TraitA_::keyLess(a_, (*iter_b_).first, (*iter_a_).first)) {
+          reportMissingMapItem<BKey_, BValue_>(report_, report_.missing_in_a, iter_b_, "a");
+          iter_b_ = mapKeyGroupEnd(b_, iter_b_, end_b_);
+        }
+        else {
+          auto group_a_(mapKeyGroupEnd(a_, iter_a_, end_a_));
+          auto group_b_(mapKeyGroupEnd(b_, iter_b_, end_b_));
+          compareMapKeyGroups<Comparator_, AKey_, AValue_, BKey_, BValue_>(
+              report_, cmp_, iter_a_, group_a_, iter_b_, group_b_);
+          iter_a_ = group_a_;
+          iter_b_ = group_b_;
+        }
+      }
+
+      /* -- the rests of the maps */
+      while(iter_a_ != end_a_) {
+        reportMissingMapItem<AKey_, AValue_>(report_, report_.missing_in_b, iter_a_, "b");
+        iter_a_ = mapKeyGroupEnd(a_, iter_a_, end_a_);
+      }
+      while(iter_b_ != end_b_) {
+        reportMissingMapItem<BKey_, BValue_>(report_, report_.missing_in_a, iter_b_, "a");
+        iter_b_ = mapKeyGroupEnd(b_, iter_b_, end_b_);
+      }
+    }
+};
+
+/**
+ * @brief Full comparison of two generic maps - the hash join
+ *
+ * Each key of the map a is looked up in the map b. The map b is probed
+ * against the map a only if some items of the map b have not been matched.
+ */
+template<template<typename, typename> class Compare_, typename ContainerA_, typename ContainerB_>
+struct MapDiffer<Compare_, ContainerA_, ContainerB_, false> {
+    template<typename Comparator_, typename AKey_, typename AValue_, typename BKey_, typename BValue_>
+    static void diff(
+        MapDiffReport& report_,
+        const Comparator_& cmp_,
+        const ContainerA_& a_,
+        const ContainerB_& b_) {
+      typedef MapContainerTrait<ContainerA_> TraitA_;
+      typedef MapContainerTrait<ContainerB_> TraitB_;
+
+      std::size_t matched_b_(0);
+      auto iter_a_(TraitA_::begin(a_));
+      auto end_a_(TraitA_::end(a_));
+      while(iter_a_ != end_a_) {
+        auto group_a_(mapKeyGroupEnd(a_, iter_a_, end_a_));
+        auto range_b_(TraitB_::equalRange(b_, (*iter_a_).first));
+        if(range_b_.first == range_b_.second) {
+          reportMissingMapItem<AKey_, AValue_>(report_, report_.missing_in_b, iter_a_, "b");
+        }
+        else {
+          compareMapKeyGroups<Comparator_, AKey_, AValue_, BKey_, BValue_>(
+              report_, cmp_, iter_a_, group_a_, range_b_.first, range_b_.second);
+          matched_b_ += std::distance(range_b_.first, range_b_.second);
+        }
+        iter_a_ = group_a_;
+      }
+
+      /* -- all items of the map b are matched */
+      if(matched_b_ == TraitB_::size(b_))
+        return;
+
+      auto iter_b_(TraitB_::begin(b_));
+      auto end_b_(TraitB_::end(b_));
+      while(iter_b_ != end_b_) {
+        auto group_b_(mapKeyGroupEnd(b_, iter_b_, end_b_));
+        auto range_a_(TraitA_::equalRange(a_, (*iter_b_).first));
+        if(range_a_.first == range_a_.second)
+          reportMissingMapItem<BKey_, BValue_>(report_, report_.missing_in_a, iter_b_, "a");
+        iter_b_ = group_b_;
+      }
+    }
+};
+
+template<template<typename, typename> class Compare_, typename ContainerA_, typename ContainerB_>
+bool compareMapsFull(
+    std::vector<std::string>& messages_,
+    const ContainerA_& a_,
+    const ContainerB_& b_,
+    int max_reported_) {
+  typedef typename AssertionParameter<typename MapContainerTrait<ContainerA_>::KeyType>::Type AKey_;
+  typedef typename AssertionParameter<typename MapContainerTrait<ContainerA_>::ValueType>::Type AValue_;
+  typedef typename AssertionParameter<typename MapContainerTrait<ContainerB_>::KeyType>::Type BKey_;
+  typedef typename AssertionParameter<typename MapContainerTrait<ContainerB_>::ValueType>::Type BValue_;
+  typedef Compare_<AValue_, BValue_> Comparator_;
+  typedef MapDiffer<
+      Compare_,
+      ContainerA_,
+      ContainerB_,
+      CanMergeMaps<
+          ContainerA_,
+          ContainerB_,
+          MapContainerTrait<ContainerA_>::ordered
+              && MapContainerTrait<ContainerB_>::ordered>::value> Differ_;
+
+  Comparator_ cmp_;
+  MapDiffReport report_(max_reported_);
+  Differ_::template diff<Comparator_, AKey_, AValue_, BKey_, BValue_>(report_, cmp_, a_, b_);
+
+  std::ostringstream sos_;
+  sos_ << "the assertion a ";
+  PrintTrait<Comparator_>::print(sos_, cmp_);
+  sos_ << " b has ";
+  if(report_.passed()) {
+    sos_ << "passed";
+    messages_.push_back(sos_.str());
+    return true;
+  }
+  sos_ << "failed: missing in the map b: " << report_.missing_in_b.count
+      << ", missing in the map a: " << report_.missing_in_a.count
+      << ", different: " << report_.different.count;
+  messages_.push_back(sos_.str());
+
+  const std::pair<const MapDiffCategory*, const char*> categories_[] = {
+      {&report_.missing_in_b, "keys not present in the map b"},
+      {&report_.missing_in_a, "keys not present in the map a"},
+      {&report_.different, "different keys"},
+  };
+  for(const auto& category_ : categories_) {
+    messages_.insert(
+        messages_.end(),
+        category_.first->messages.begin(),
+        category_.first->messages.end());
+    if(category_.first->count > category_.first->messages.size()) {
+      sos_.str("");
+      sos_ << "... and " << (category_.first->count - category_.first->messages.size())
+          << " more " << category_.second;
+      messages_.push_back(sos_.str());
+    }
+  }
+
+  return false;
+}
+
 } /* -- namespace Private */
 
 template<template<typename, typename> class Compare_, typename ContainerA_, typename ContainerB_>
@@ -189,6 +523,21 @@ bool MapAssertion::testAssertMap(
   return report_.getResult();
 }
 
+template<template<typename, typename> class Compare_, typename ContainerA_, typename ContainerB_>
+bool MapAssertion::testAssertMapFull(
+    const ContainerA_& a_,
+    const ContainerB_& b_,
+    int max_reported_) {
+  std::vector<std::string> messages_;
+  bool result_(Private::compareMapsFull<Compare_>(messages_, a_, b_, max_reported_));
+  assert(!messages_.empty());
+
+  AssertStream report_(enterAssertion(result_));
+  for(const auto& message_ : messages_)
+    report_ << message_ << commitMsg();
+  return report_.getResult();
+}
+
 } /* -- namespace OTest2 */
 
 #endif /* -- OTest2_INCLUDE_OTEST2_ASSERTIONSMAPIMPL_H_ */
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2020 Ondrej Starek
+ *
+ * This file is part of OTest2
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OTest2_INCLUDE_OTEST2_ASSERTIONSNEAR_H_
+#define OTest2_INCLUDE_OTEST2_ASSERTIONSNEAR_H_
+
+#include <otest2/assertcontext.h>
+#include <otest2/assertionannotation.h>
+#include <otest2/const.h>
+
+namespace OTest2 {
+
+/**
+ * @brief Implementation of item-wise floating point assertions
+ *
+ * The assertions check whether each pair of items with the same index
+ * in two lists is near each other. Two items pass if
+ *
+ *     |a - b| <= max(abs_tol, rel_tol * max(|a|, |b|))
+ *
+ * The NaN values never pass. Both lists must be of the same size.
+ *
+ * The assertions are designated for big numeric arrays. The lists are
+ * checked in one pass which computes error statistics. Contiguous ranges
+ * are processed by a blocked kernel which can be vectorized by the compiler.
+ * The report contains the worst item, the error statistics and the first
+ * DEFAULT_NEAR_OFFENDERS failed items. No message is constructed
+ * for the other items.
+ */
+class NearItemWiseAssertion : public AssertContext {
+  private:
+    template<typename IterA_, typename IterB_>
+    bool testAssertNearList(
+        IterA_ begin_a_,
+        IterA_ end_a_,
+        IterB_ begin_b_,
+        IterB_ end_b_,
+        long double abs_tol_,
+        long double rel_tol_);
+
+  public:
+    /* -- avoid copying */
+    NearItemWiseAssertion(
+        const NearItemWiseAssertion&) = delete;
+    NearItemWiseAssertion& operator = (
+        const NearItemWiseAssertion&) = delete;
+
+    /* -- inherit the constructor - the parent constructor is invoked
+     *    from the test suite generated code. */
+    using AssertContext::AssertContext;
+
+    /* -- floating point item-wise assertions */
+    template<typename ContainerA_, typename ContainerB_>
+    bool testAssertNearItemWise(
+        const ContainerA_& a_,
+        const ContainerB_& b_,
+        long double abs_tol_ = DEFAULT_FLOAT_PRECISION,
+        long double rel_tol_ = 0.0);
+    template<typename IterA_, typename IterB_>
+    bool testAssertNearItemWiseIter(
+        IterA_ begin_a_,
+        IterA_ end_a_,
+        IterB_ begin_b_,
+        IterB_ end_b_,
+        long double abs_tol_ = DEFAULT_FLOAT_PRECISION,
+        long double rel_tol_ = 0.0);
+};
+
+namespace Assertions {
+
+/**
+ * @brief Check whether items of two lists are near each other
+ *
+ * @param a_ The first list
+ * @param b_ The second list
+ * @param abs_tol_ Absolute tolerance
+ * @param rel_tol_ Relative tolerance (relative to the bigger magnitude
+ *     of the items)
+ * @return True if all items are near
+ */
+template<typename ContainerA_, typename ContainerB_>
+bool testAssertNearItemWise(
+    const ContainerA_& a_,
+    const ContainerB_& b_,
+    long double abs_tol_ = DEFAULT_FLOAT_PRECISION,
+    long double rel_tol_ = 0.0)
+TEST_ASSERTION_MARK_TMPL("::OTest2::NearItemWiseAssertion", "testAssertNearItemWise");
+
+/**
+ * @brief Check whether items of two lists are near each other
+ *
+ * @param begin_a_ Beginning iterator of the first list
+ * @param end_a_ Ending iterator of the first list
+ * @param begin_b_ Beginning iterator of the second list
+ * @param end_b_ Ending iterator of the second list
+ * @param abs_tol_ Absolute tolerance
+ * @param rel_tol_ Relative tolerance (relative to the bigger magnitude
+ *     of the items)
+ * @return True if all items are near
+ */
+template<typename IterA_, typename IterB_>
+bool testAssertNearItemWiseIter(
+    IterA_ begin_a_,
+    IterA_ end_a_,
+    IterB_ begin_b_,
+    IterB_ end_b_,
+    long double abs_tol_ = DEFAULT_FLOAT_PRECISION,
+    long double rel_tol_ = 0.0)
+TEST_ASSERTION_MARK_TMPL("::OTest2::NearItemWiseAssertion", "testAssertNearItemWiseIter");
+
+} /* -- namespace Assertions */
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_ASSERTIONSNEAR_H_ */
@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2020 Ondrej Starek
+ *
+ * This file is part of OTest2
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OTest2_INCLUDE_OTEST2_ASSERTIONSNEARIMPL_H_
+#define OTest2_INCLUDE_OTEST2_ASSERTIONSNEARIMPL_H_
+
+#include <otest2/assertionsnear.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include <otest2/assertstream.h>
+#include <otest2/bulkcompare.h>
+#include <otest2/const.h>
+#include <otest2/containertrait.h>
+#include <otest2/printtraits.h>
+#include <otest2/typetraits.h>
+
+namespace OTest2 {
+
+namespace Private {
+
+template<typename Common_, bool floating_>
+struct NearValueTypeImpl {
+    typedef long double Type;
+};
+
+template<typename Common_>
+struct NearValueTypeImpl<Common_, true> {
+    typedef Common_ Type;
+};
+
+/**
+ * @brief Type used for computation of the errors
+ *
+ * The floating point items are computed in their common type. Other
+ * arithmetic types are converted to the long double.
+ */
+template<typename A_, typename B_>
+struct NearValueType {
+    typedef typename std::common_type<A_, B_>::type Common;
+    typedef typename NearValueTypeImpl<
+        Common, std::is_floating_point<Common>::value>::Type Type;
+};
+
+/**
+ * @brief One checked pair of items
+ */
+template<typename Value_>
+struct NearItem {
+    std::size_t index;
+    Value_ a;
+    Value_ b;
+    Value_ error;
+};
+
+/**
+ * @brief Error statistics of the near item-wise assertion
+ */
+template<typename Value_>
+struct NearStatistics {
+    const Value_ abs_tol;
+    const Value_ rel_tol;
+    std::size_t items;
+    std::size_t failures;
+    bool has_worst;
+    NearItem<Value_> worst;
+    long double error_sum;       /**< sum of the non-NaN errors */
+    std::size_t error_count;     /**< number of the non-NaN errors */
+    std::vector<NearItem<Value_> > offenders;
+
+    explicit NearStatistics(
+        long double abs_tol_,
+        long double rel_tol_) :
+      abs_tol(static_cast<Value_>(abs_tol_)),
+      rel_tol(static_cast<Value_>(rel_tol_)),
+      items(0),
+      failures(0),
+      has_worst(false),
+      worst(),
+      error_sum(0.0),
+      error_count(0),
+      offenders() {
+
+    }
+
+    static bool isWorse(
+        Value_ error_,
+        Value_ worst_) {
+      if(std::isnan(error_))
+        return !std::isnan(worst_);
+      return !std::isnan(worst_) && error_ > worst_;
+    }
+
+    /**
+     * @brief Check one pair of items and update the statistics
+     */
+    void checkItem(
+        std::size_t index_,
+        Value_ a_,
+        Value_ b_) {
+      const Value_ error_(a_ == b_ ? Value_(0) : std::fabs(a_ - b_));
+      const Value_ tolerance_(std::max(
+          abs_tol, rel_tol * std::max(std::fabs(a_), std::fabs(b_))));
+
+      ++items;
+      if(!std::isnan(error_)) {
+        error_sum += error_;
+        ++error_count;
+      }
+      if(!has_worst || isWorse(error_, worst.error)) {
+        worst = {index_, a_, b_, error_};
+        has_worst = true;
+      }
+      if(!(error_ <= tolerance_)) {
+        ++failures;
+        if(offenders.size() < static_cast<std::size_t>(DEFAULT_NEAR_OFFENDERS))
+          offenders.push_back({index_, a_, b_, error_});
+      }
+    }
+};
+
+/**
+ * @brief Kernel of the near assertion for contiguous ranges
+ *
+ * The blocks are evaluated in several independent lanes so that
+ * the compiler can vectorize the loop without relaxing the floating
+ * point semantics. Only blocks containing a failed item or a new maximal
+ * error are checked again item by item.
+ */
+template<typename Value_, typename A_, typename B_>
+void nearScanContiguous(
+    NearStatistics<Value_>& stats_,
+    const A_* a_,
+    const B_* b_,
+    std::size_t size_) {
+  constexpr std::size_t LANES_(8);
+  static_assert(BULK_COMPARE_BLOCK % LANES_ == 0, "invalid count of the lanes");
+
+  const Value_ abs_tol_(stats_.abs_tol);
+  const Value_ rel_tol_(stats_.rel_tol);
+
+  std::size_t index_(0);
+  while(index_ + BULK_COMPARE_BLOCK <= size_) {
+    Value_ max_[LANES_] = {};
+    Value_ sum_[LANES_] = {};
+    int fails_[LANES_] = {};
+    for(std::size_t i_(index_); i_ < index_ + BULK_COMPARE_BLOCK; i_ += LANES_) {
+      for(std::size_t j_(0); j_ < LANES_; ++j_) {
+        const Value_ a_item_(a_[i_ + j_]);
+        const Value_ b_item_(b_[i_ + j_]);
+        const Value_ error_(
+            a_item_ == b_item_ ? Value_(0) : std::fabs(a_item_ - b_item_));
+        const Value_ magnitude_(std::max(std::fabs(a_item_), std::fabs(b_item_)));
+        const Value_ tolerance_(std::max(abs_tol_, rel_tol_ * magnitude_));
+        fails_[j_] += !(error_ <= tolerance_);
+        max_[j_] = error_ > max_[j_] ? error_ : max_[j_];
+        sum_[j_] += error_;
+      }
+    }
+
+    /* -- reduce the lanes */
+    int block_fails_(0);
+    Value_ block_max_(0);
+    Value_ block_sum_(0);
+    for(std::size_t j_(0); j_ < LANES_; ++j_) {
+      block_fails_ += fails_[j_];
+      block_max_ = std::max(block_max_, max_[j_]);
+      block_sum_ += sum_[j_];
+    }
+
+    if(block_fails_ > 0 || !stats_.has_worst || block_max_ > stats_.worst.error) {
+      /* -- check the block again and record details */
+      for(std::size_t i_(index_); i_ < index_ + BULK_COMPARE_BLOCK; ++i_)
+        stats_.checkItem(i_, a_[i_], b_[i_]);
+    }
+    else {
+      stats_.items += BULK_COMPARE_BLOCK;
+      stats_.error_sum += block_sum_;
+      stats_.error_count += BULK_COMPARE_BLOCK;
+    }
+    index_ += BULK_COMPARE_BLOCK;
+  }
+
+  /* -- the rest of the items */
+  for(; index_ < size_; ++index_)
+    stats_.checkItem(index_, a_[index_], b_[index_]);
+}
+
+template<typename Value_, typename IterA_, typename IterB_, bool contiguous_>
+struct NearScanner {
+    static void scan(
+        NearStatistics<Value_>& stats_,
+        IterA_& begin_a_,
+        IterA_ end_a_,
+        IterB_& begin_b_,
+        IterB_ end_b_) {
+      std::size_t index_(0);
+      while(begin_a_ != end_a_ && begin_b_ != end_b_) {
+        stats_.checkItem(index_, *begin_a_, *begin_b_);
+        ++begin_a_;
+        ++begin_b_;
+        ++index_;
+      }
+    }
+};
+
+template<typename Value_, typename IterA_, typename IterB_>
+struct NearScanner<Value_, IterA_, IterB_, true> {
+    static void scan(
+        NearStatistics<Value_>& stats_,
+        IterA_& begin_a_,
+        IterA_ end_a_,
+        IterB_& begin_b_,
+        IterB_ end_b_) {
+      const auto size_a_(end_a_ - begin_a_);
+      const auto size_b_(end_b_ - begin_b_);
+      const std::size_t size_(size_a_ < size_b_ ? size_a_ : size_b_);
+      if(size_ > 0) {
+        nearScanContiguous(
+            stats_,
+            ContiguousIteratorTrait<IterA_>::address(begin_a_),
+            ContiguousIteratorTrait<IterB_>::address(begin_b_),
+            size_);
+      }
+      begin_a_ += size_;
+      begin_b_ += size_;
+    }
+};
+
+} /* -- namespace Private */
+
+template<typename IterA_, typename IterB_>
+bool NearItemWiseAssertion::testAssertNearList(
+    IterA_ begin_a_,
+    IterA_ end_a_,
+    IterB_ begin_b_,
+    IterB_ end_b_,
+    long double abs_tol_,
+    long double rel_tol_) {
+  typedef typename AssertionParameter<decltype(*begin_a_)>::Type AType_;
+  typedef typename AssertionParameter<decltype(*begin_b_)>::Type BType_;
+  typedef typename Private::NearValueType<AType_, BType_>::Type Value_;
+
+  /* -- check the items */
+  Private::NearStatistics<Value_> stats_(abs_tol_, rel_tol_);
+  Private::NearScanner<
+      Value_, IterA_, IterB_, Private::IsBulkRange<IterA_, IterB_>::value>::scan(
+          stats_, begin_a_, end_a_, begin_b_, end_b_);
+
+  /* -- the lists are different size */
+  if(begin_a_ != end_a_) {
+    AssertStream report_(enterAssertion(false));
+    report_ << "left container is bigger then the right one" << commitMsg();
+    return report_.getResult();
+  }
+  if(begin_b_ != end_b_) {
+    AssertStream report_(enterAssertion(false));
+    report_ << "left container is smaller then the right one" << commitMsg();
+    return report_.getResult();
+  }
+
+  AssertStream report_(enterAssertion(stats_.failures == 0));
+  if(stats_.failures == 0) {
+    report_ << "the check has passed" << commitMsg();
+    return report_.getResult();
+  }
+
+  /* -- report the summary */
+  report_ << stats_.failures << " of " << stats_.items
+      << " items have failed: |a[i] - b[i]| <= max(" << abs_tol_ << ", "
+      << rel_tol_ << " * max(|a[i]|, |b[i]|))" << commitMsg();
+  report_ << "the worst item: a[" << stats_.worst.index << "] = ";
+  PrintTrait<Value_>::print(report_, stats_.worst.a);
+  report_ << ", b[" << stats_.worst.index << "] = ";
+  PrintTrait<Value_>::print(report_, stats_.worst.b);
+  report_ << commitMsg();
+  report_ << "error statistics: max = ";
+  PrintTrait<Value_>::print(report_, stats_.worst.error);
+  if(stats_.error_count > 0)
+    report_ << ", mean = " << stats_.error_sum / stats_.error_count;
+  report_ << commitMsg();
+
+  /* -- report the first failed items */
+  for(const auto& item_ : stats_.offenders) {
+    report_ << "a[" << item_.index << "] = ";
+    PrintTrait<Value_>::print(report_, item_.a);
+    report_ << ", b[" << item_.index << "] = ";
+    PrintTrait<Value_>::print(report_, item_.b);
+    report_ << ", |a - b| = ";
+    PrintTrait<Value_>::print(report_, item_.error);
+    report_ << commitMsg();
+  }
+  if(stats_.failures > stats_.offenders.size()) {
+    report_ << "... and " << (stats_.failures - stats_.offenders.size())
+        << " more failed items" << commitMsg();
+  }
+
+  return report_.getResult();
+}
+
+template<typename ContainerA_, typename ContainerB_>
+bool NearItemWiseAssertion::testAssertNearItemWise(
+    const ContainerA_& a_,
+    const ContainerB_& b_,
+    long double abs_tol_,
+    long double rel_tol_) {
+  return testAssertNearList(
+      ListContainerTrait<ContainerA_>::begin(a_),
+      ListContainerTrait<ContainerA_>::end(a_),
+      ListContainerTrait<ContainerB_>::begin(b_),
+      ListContainerTrait<ContainerB_>::end(b_),
+      abs_tol_,
+      rel_tol_);
+}
+
+template<typename IterA_, typename IterB_>
+bool NearItemWiseAssertion::testAssertNearItemWiseIter(
+    IterA_ begin_a_,
+    IterA_ end_a_,
+    IterB_ begin_b_,
+    IterB_ end_b_,
+    long double abs_tol_,
+    long double rel_tol_) {
+  return testAssertNearList(
+      begin_a_, end_a_, begin_b_, end_b_, abs_tol_, rel_tol_);
+}
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_ASSERTIONSNEARIMPL_H_ */
@@ -26,6 +26,13 @@ namespace OTest2 {
 
 /**
  * @brief Input base64 stream
+ *
+ * The stream decodes a base64 sequence read from the decorated stream.
+ * Whitespaces are skipped. The sequence finishes at the padding, at an
+ * invalid character or at the end of the decorated stream.
+ *
+ * @note The decorated stream is read in large blocks. Hence, the data
+ *     following the base64 sequence may be consumed too.
  */
 class Base64IStream : public std::istream {
   private:
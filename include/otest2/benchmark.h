@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2_INCLUDE_OTEST2_BENCHMARK_H_
+#define OTest2_INCLUDE_OTEST2_BENCHMARK_H_
+
+#include <cstdint>
+
+#include <otest2/benchmarkresult.h>
+
+namespace OTest2 {
+
+class Context;
+
+/**
+ * @brief Measurement of a benchmark state
+ *
+ * The object drives the loop of the benchmark body. The generated code
+ * of a benchmark state looks like:
+ *
+ *     Benchmark benchmark_(context_);
+ *     while(benchmark_.nextSample()) {
+ *       for(std::uint64_t i_(benchmark_.getIterations()); i_ > 0; --i_)
+ *         body();
+ *     }
+ *     benchmark_.report();
+ *
+ * The body is warmed up first. The number of iterations of one sample
+ * is scaled to take approximately BENCHMARK_SAMPLE_TIME milliseconds.
+ * Then BENCHMARK_SAMPLES samples are measured. The time is measured by
+ * the steady clock, not by the time source of the context. Hence,
+ * the measurement is not influenced by the virtual time.
+ */
+class Benchmark {
+  private:
+    struct Impl;
+    Impl* pimpl;
+
+  public:
+    /* -- avoid copying */
+    Benchmark(
+        const Benchmark&) = delete;
+    Benchmark& operator = (
+        const Benchmark&) = delete;
+
+    /**
+     * @brief Ctor
+     *
+     * @param context_ The OTest2 context
+     */
+    explicit Benchmark(
+        const Context& context_);
+
+    /**
+     * @brief Dtor
+     */
+    ~Benchmark();
+
+    /**
+     * @brief Finish current sample and start the next one
+     *
+     * @return False if the measurement is finished
+     */
+    bool nextSample();
+
+    /**
+     * @brief Get number of iterations of current sample
+     */
+    std::uint64_t getIterations() const noexcept;
+
+    /**
+     * @brief Compute statistics of the measured samples
+     *
+     * @pre The measurement is finished (nextSample() has returned false)
+     */
+    BenchmarkResult getResult() const;
+
+    /**
+     * @brief Report the result of the measurement
+     */
+    void report();
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_BENCHMARK_H_ */
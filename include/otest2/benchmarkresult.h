@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2_INCLUDE_OTEST2_BENCHMARKRESULT_H_
+#define OTest2_INCLUDE_OTEST2_BENCHMARKRESULT_H_
+
+#include <cstdint>
+
+namespace OTest2 {
+
+/**
+ * @brief Statistics of a benchmark measurement
+ *
+ * The times are in nanoseconds per one operation (one invocation
+ * of the benchmark body).
+ */
+struct BenchmarkResult {
+    std::uint64_t iterations;   /**< number of operations in one sample */
+    int samples;                /**< number of samples */
+    double mean;                /**< mean time of the samples */
+    double median;              /**< median time of the samples */
+    double stddev;              /**< standard deviation of the samples */
+    double mad;                 /**< median absolute deviation of the samples */
+    double min;                 /**< time of the fastest sample */
+    double max;                 /**< time of the slowest sample */
+
+    /**
+     * @brief Get number of operations per second (computed from the median)
+     */
+    double getThroughput() const noexcept;
+
+    /**
+     * @brief Get the coefficient of variation (stddev / mean)
+     */
+    double getVariation() const noexcept;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_BENCHMARKRESULT_H_ */
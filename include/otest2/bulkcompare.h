@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2020 Ondrej Starek
+ *
+ * This file is part of OTest2
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef OTest2_INCLUDE_OTEST2_BULKCOMPARE_H_
+#define OTest2_INCLUDE_OTEST2_BULKCOMPARE_H_
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+#include <otest2/comparisons.h>
+#include <otest2/comparisonslexi.h>
+#include <otest2/containertrait.h>
+#include <otest2/typetraits.h>
+
+namespace OTest2 {
+
+namespace Private {
+
+/**
+ * @brief Number of items checked in one step of the bulk kernels
+ *
+ * The kernels evaluate whole blocks without branching so that the compiler
+ * may vectorize them. The items of the first failing block are left
+ * to the ordinary item by item comparison.
+ */
+constexpr std::size_t BULK_COMPARE_BLOCK(256);
+
+/**
+ * @brief Whitelist of item comparators which may be evaluated in bulk
+ *
+ * Only the library comparators are listed as they are known to be pure
+ * functions without side effects.
+ */
+template<template<typename, typename> class Compare_>
+struct IsBulkComparator : public std::false_type {};
+template<> struct IsBulkComparator<Equal> : public std::true_type {};
+template<> struct IsBulkComparator<NotEqual> : public std::true_type {};
+template<> struct IsBulkComparator<Less> : public std::true_type {};
+template<> struct IsBulkComparator<LessOrEqual> : public std::true_type {};
+template<> struct IsBulkComparator<Greater> : public std::true_type {};
+template<> struct IsBulkComparator<GreaterOrEqual> : public std::true_type {};
+
+/**
+ * @brief Whitelist of lexicographical comparators which may skip common
+ *     prefix of the lists in bulk
+ */
+template<template<typename, typename> class Compare_>
+struct IsBulkLexiComparator : public std::false_type {};
+template<> struct IsBulkLexiComparator<LexiLess> : public std::true_type {};
+template<> struct IsBulkLexiComparator<LexiLessOrEqual> : public std::true_type {};
+template<> struct IsBulkLexiComparator<LexiGreater> : public std::true_type {};
+template<> struct IsBulkLexiComparator<LexiGreaterOrEqual> : public std::true_type {};
+
+/**
+ * @brief Bulk kernel - memory comparison of blocks of bitwise comparable items
+ *
+ * @return Number of leading items which are equal for sure.
+ */
+template<typename Type_>
+std::size_t bulkSkipEqualBlocks(
+    const Type_* a_,
+    const Type_* b_,
+    std::size_t size_) {
+  std::size_t index_(0);
+  while(index_ + BULK_COMPARE_BLOCK <= size_) {
+    if(std::memcmp(a_ + index_, b_ + index_, BULK_COMPARE_BLOCK * sizeof(Type_)) != 0)
+      break;
+    index_ += BULK_COMPARE_BLOCK;
+  }
+  return index_;
+}
+
+/**
+ * @brief Bulk kernel - branchless evaluation of a comparator over blocks
+ *     of items
+ *
+ * @return Number of leading items which pass the comparator for sure.
+ */
+template<typename Comparator_, typename A_, typename B_>
+std::size_t bulkSkipPassingBlocks(
+    const Comparator_& cmp_,
+    const A_* a_,
+    const B_* b_,
+    std::size_t size_) {
+  std::size_t index_(0);
+  while(index_ + BULK_COMPARE_BLOCK <= size_) {
+    bool passed_(true);
+    for(std::size_t i_(0); i_ < BULK_COMPARE_BLOCK; ++i_)
+      passed_ &= cmp_(a_[index_ + i_], b_[index_ + i_]);
+    if(!passed_)
+      break;
+    index_ += BULK_COMPARE_BLOCK;
+  }
+  return index_;
+}
+
+template<typename Comparator_, typename A_, typename B_>
+std::size_t bulkSkipItems(
+    std::true_type,   /* -- bitwise equality */
+    const Comparator_& cmp_,
+    const A_* a_,
+    const B_* b_,
+    std::size_t size_) {
+  return bulkSkipEqualBlocks(a_, b_, size_);
+}
+
+template<typename Comparator_, typename A_, typename B_>
+std::size_t bulkSkipItems(
+    std::false_type,  /* -- bitwise equality */
+    const Comparator_& cmp_,
+    const A_* a_,
+    const B_* b_,
+    std::size_t size_) {
+  return bulkSkipPassingBlocks(cmp_, a_, b_, size_);
+}
+
+template<
+    template<typename, typename> class Compare_,
+    typename IterA_,
+    typename IterB_,
+    bool bulk_>
+struct BulkSkipper {
+    static int skip(
+        IterA_& begin_a_,
+        IterA_ end_a_,
+        IterB_& begin_b_,
+        IterB_ end_b_) {
+      return 0;
+    }
+};
+
+template<
+    template<typename, typename> class Compare_,
+    typename IterA_,
+    typename IterB_>
+struct BulkSkipper<Compare_, IterA_, IterB_, true> {
+    static int skip(
+        IterA_& begin_a_,
+        IterA_ end_a_,
+        IterB_& begin_b_,
+        IterB_ end_b_) {
+      typedef typename ContiguousIteratorTrait<IterA_>::ValueType AType_;
+      typedef typename ContiguousIteratorTrait<IterB_>::ValueType BType_;
+      typedef Compare_<AType_, BType_> Comparator_;
+      typedef std::integral_constant<
+          bool,
+          std::is_same<Comparator_, Equal<AType_, AType_> >::value
+              && std::is_same<AType_, BType_>::value
+              && IsBitwiseComparable<AType_>::value> Bitwise_;
+
+      const auto size_a_(end_a_ - begin_a_);
+      const auto size_b_(end_b_ - begin_b_);
+      const std::size_t size_(size_a_ < size_b_ ? size_a_ : size_b_);
+      if(size_ < BULK_COMPARE_BLOCK)
+        return 0;
+
+      const std::size_t skipped_(bulkSkipItems(
+          Bitwise_(),
+          Comparator_(),
+          ContiguousIteratorTrait<IterA_>::address(begin_a_),
+          ContiguousIteratorTrait<IterB_>::address(begin_b_),
+          size_));
+      begin_a_ += skipped_;
+      begin_b_ += skipped_;
+      return static_cast<int>(skipped_);
+    }
+};
+
+template<typename IterA_, typename IterB_>
+struct IsBulkRange {
+    static constexpr bool value =
+        ContiguousIteratorTrait<IterA_>::contiguous
+        && ContiguousIteratorTrait<IterB_>::contiguous
+        && std::is_arithmetic<typename ContiguousIteratorTrait<IterA_>::ValueType>::value
+        && std::is_arithmetic<typename ContiguousIteratorTrait<IterB_>::ValueType>::value;
+};
+
+/**
+ * @brief Skip leading items of two lists which pass an item-wise comparator
+ *
+ * If both lists are contiguous ranges of arithmetic values and the comparator
+ * is one of the library comparators the leading items are checked by a bulk
+ * kernel. Otherwise, nothing is skipped.
+ *
+ * @param[in,out] begin_a_ Beginning iterator of the first list. The iterator
+ *     is moved behind the skipped items.
+ * @param[in] end_a_ Ending iterator of the first list
+ * @param[in,out] begin_b_ Beginning iterator of the second list. The iterator
+ *     is moved behind the skipped items.
+ * @param[in] end_b_ Ending iterator of the second list
+ * @return Number of skipped items. The items behind are not checked yet.
+ */
+template<template<typename, typename> class Compare_, typename IterA_, typename IterB_>
+int bulkSkipPassingItems(
+    IterA_& begin_a_,
+    IterA_ end_a_,
+    IterB_& begin_b_,
+    IterB_ end_b_) {
+  return BulkSkipper<
+      Compare_,
+      IterA_,
+      IterB_,
+      IsBulkComparator<Compare_>::value && IsBulkRange<IterA_, IterB_>::value>
+          ::skip(begin_a_, end_a_, begin_b_, end_b_);
+}
+
+/**
+ * @brief Skip common prefix of two lists compared lexicographically
+ *
+ * This is a counterpart of the bulkSkipPassingItems() for the lexicographical
+ * comparators. The skipped items are equal, thus, they don't decide
+ * the lexicographical relation.
+ */
+template<template<typename, typename> class Compare_, typename IterA_, typename IterB_>
+int bulkSkipCommonPrefix(
+    IterA_& begin_a_,
+    IterA_ end_a_,
+    IterB_& begin_b_,
+    IterB_ end_b_) {
+  return BulkSkipper<
+      Equal,
+      IterA_,
+      IterB_,
+      IsBulkLexiComparator<Compare_>::value && IsBulkRange<IterA_, IterB_>::value>
+          ::skip(begin_a_, end_a_, begin_b_, end_b_);
+}
+
+} /* -- namespace Private */
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_BULKCOMPARE_H_ */
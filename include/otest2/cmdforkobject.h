@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OTest2_INCLUDE_OTEST2_CMDFORKOBJECT_H_
+#define OTest2_INCLUDE_OTEST2_CMDFORKOBJECT_H_
+
+#include <otest2/command.h>
+#include <otest2/objectptr.h>
+#include <otest2/scenarioiterptr.h>
+
+namespace OTest2 {
+
+/**
+ * @brief Run next testing object in a forked process
+ *
+ * The child process runs the object with its own command stack and
+ * main loop. The reports are passed back into the parent process through
+ * a pipe. The parent continues with the CmdJoinObject command.
+ */
+class CmdForkObject : public Command {
+  private:
+    ScenarioIterPtr scenario_iter;
+    ObjectPtr parent;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param scenario_iter_ An iterator of current level of the scenario
+     * @param parent_ Parent object of the testing object
+     */
+    explicit CmdForkObject(
+        ScenarioIterPtr scenario_iter_,
+        ObjectPtr parent_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~CmdForkObject();
+
+    /* -- avoid copying */
+    CmdForkObject(
+        const CmdForkObject&) = delete;
+    CmdForkObject& operator = (
+        const CmdForkObject&) = delete;
+
+    /* -- command interface */
+    virtual void run(
+        const Context& context_) override;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_CMDFORKOBJECT_H_ */
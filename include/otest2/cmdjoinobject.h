@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OTest2_INCLUDE_OTEST2_CMDJOINOBJECT_H_
+#define OTest2_INCLUDE_OTEST2_CMDJOINOBJECT_H_
+
+#include <memory>
+
+#include <otest2/command.h>
+
+namespace OTest2 {
+
+class ForkedChild;
+
+/**
+ * @brief Collect the report of a testing object running in a forked process
+ *
+ * The command waits for the data of the child process. When the child
+ * finishes, its report is passed into the reporter of the context and its
+ * result is joined into the top of the semantic stack.
+ */
+class CmdJoinObject : public Command {
+  private:
+    std::unique_ptr<ForkedChild> child;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param child_ The forked child
+     */
+    explicit CmdJoinObject(
+        std::unique_ptr<ForkedChild>&& child_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~CmdJoinObject();
+
+    /* -- avoid copying */
+    CmdJoinObject(
+        const CmdJoinObject&) = delete;
+    CmdJoinObject& operator = (
+        const CmdJoinObject&) = delete;
+
+    /* -- command interface */
+    virtual bool shouldWait(
+        const Context& context_,
+        int& delay_,
+        WaitSources& wait_sources_) override;
+    virtual void run(
+        const Context& context_) override;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_CMDJOINOBJECT_H_ */
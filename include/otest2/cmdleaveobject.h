@@ -21,8 +21,10 @@
 #define OTest2_INCLUDE_OTEST2_CMDLEAVEOBJECT_H_
 
 #include <string>
+#include <sys/types.h>
 
 #include <otest2/command.h>
+#include <otest2/resourceusage.h>
 #include <otest2/scenarioptr.h>
 
 namespace OTest2 {
@@ -33,11 +35,16 @@ namespace OTest2 {
 class CmdLeaveObject : public Command {
   private:
     ScenarioPtr scenario;
+    pid_t start_pid;
+    ResourceUsage start_usage;
 
   public:
     /**
      * @brief Ctor
      *
+     * The ctor samples the resource counters. The command must be created
+     * when the object is entered.
+     *
      * @param scenario_ The scenario object representing the testing object
      */
     explicit CmdLeaveObject(
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2_INCLUDE_OTEST2_CMDREPEATPARALLEL_H_
+#define OTest2_INCLUDE_OTEST2_CMDREPEATPARALLEL_H_
+
+#include <deque>
+#include <memory>
+#include <string>
+
+#include <otest2/command.h>
+#include <otest2/objectptr.h>
+#include <otest2/objectrepeaterptr.h>
+#include <otest2/scenarioptr.h>
+
+namespace OTest2 {
+
+class ForkedChild;
+
+/**
+ * @brief Schedule parallel runs of a repeated testing object
+ *
+ * The command runs in a forked spawning process, so the user code
+ * of the runs is never executed in the main process. The runs are created
+ * one by one in the spawning process as the repeater requires. Each run
+ * is executed in a process forked from the spawning one and the spawning
+ * process destroys its copy of the run right after the fork. Several runs
+ * are executed at once. Their reports are passed in the order of the runs.
+ */
+class CmdRepeatParallel : public Command {
+  public:
+    typedef std::deque<std::unique_ptr<ForkedChild>> Children;
+
+  private:
+    ScenarioPtr scenario;
+    ObjectRepeaterPtr repeater;
+    std::string name;
+    ObjectPtr parent;
+    Children children;
+    bool spawning;
+
+    void spawnRun(
+        const Context& context_);
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param scenario_ Scenario object representing the testing object
+     * @param repeater_ The repeater
+     * @param name_ Name of the repeated testing object
+     * @param parent_ Parent object of the testing object
+     */
+    explicit CmdRepeatParallel(
+        ScenarioPtr scenario_,
+        ObjectRepeaterPtr repeater_,
+        const std::string& name_,
+        ObjectPtr parent_);
+
+    /**
+     * @brief Ctor - continuation of the runs
+     *
+     * @param scenario_ Scenario object representing the testing object
+     * @param repeater_ The repeater
+     * @param name_ Name of the repeated testing object
+     * @param parent_ Parent object of the testing object
+     * @param children_ Currently running children
+     * @param spawning_ False if no more runs should be started
+     */
+    explicit CmdRepeatParallel(
+        ScenarioPtr scenario_,
+        ObjectRepeaterPtr repeater_,
+        const std::string& name_,
+        ObjectPtr parent_,
+        Children&& children_,
+        bool spawning_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~CmdRepeatParallel();
+
+    /* -- avoid copying */
+    CmdRepeatParallel(
+        const CmdRepeatParallel&) = delete;
+    CmdRepeatParallel& operator = (
+        const CmdRepeatParallel&) = delete;
+
+    /* -- command interface */
+    virtual bool shouldWait(
+        const Context& context_,
+        int& delay_,
+        WaitSources& wait_sources_) override;
+    virtual void run(
+        const Context& context_) override;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_CMDREPEATPARALLEL_H_ */
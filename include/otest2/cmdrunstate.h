@@ -23,6 +23,7 @@
 #include <otest2/caseordinaryptr.h>
 #include <otest2/command.h>
 #include <otest2/stateordinaryptr.h>
+#include <otest2/waitsource.h>
 
 namespace OTest2 {
 
@@ -35,6 +36,8 @@ class CmdRunState : public Command {
     StateOrdinaryPtr state;
     bool wait_before;
     int delay;
+    WaitSources wait_sources;
+    bool resume;
 
   public:
     /* -- avoid copying */
@@ -50,12 +53,19 @@ class CmdRunState : public Command {
      * @param state_ The state being run
      * @param wait_before_ If it's true the delay is applied.
      * @param delay_ Delay before run of the state in milliseconds.
+     * @param wait_sources_ Sources of events which finish the delay
+     *     prematurely
+     * @param resume_ The state has been suspended and it's resumed now.
+     *     The state is already entered, so the entrance is not reported
+     *     again.
      */
     explicit CmdRunState(
         CaseOrdinaryPtr parent_,
         StateOrdinaryPtr state_,
         bool wait_before_,
-        int delay_);
+        int delay_,
+        const WaitSources& wait_sources_,
+        bool resume_);
 
     /**
      * @brief Dtor
@@ -65,7 +75,8 @@ class CmdRunState : public Command {
     /* -- command interface */
     virtual bool shouldWait(
         const Context& context_,
-        int& delay_);
+        int& delay_,
+        WaitSources& wait_sources_);
     virtual void run(
         const Context& context_);
 };
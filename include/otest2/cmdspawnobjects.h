@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2_INCLUDE_OTEST2_CMDSPAWNOBJECTS_H_
+#define OTest2_INCLUDE_OTEST2_CMDSPAWNOBJECTS_H_
+
+#include <otest2/command.h>
+#include <otest2/objectptr.h>
+#include <otest2/scenarioiterptr.h>
+
+namespace OTest2 {
+
+/**
+ * @brief Spawn all testing objects of current level of the scenario
+ *
+ * This command is used instead of the CmdNextObject if the runner
+ * interleaves the testing objects. The objects are spawned by the scheduler
+ * of the context and the parent object waits until they finish.
+ */
+class CmdSpawnObjects : public Command {
+  private:
+    ScenarioIterPtr scenario_iter;
+    ObjectPtr parent;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param scenario_iter_ An iterator of current level of the scenario
+     * @param parent_ Parent object of the testing objects
+     */
+    explicit CmdSpawnObjects(
+        ScenarioIterPtr scenario_iter_,
+        ObjectPtr parent_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~CmdSpawnObjects();
+
+    /* -- avoid copying */
+    CmdSpawnObjects(
+        const CmdSpawnObjects&) = delete;
+    CmdSpawnObjects& operator = (
+        const CmdSpawnObjects&) = delete;
+
+    /* -- command interface */
+    virtual void run(
+        const Context& context_) override;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_CMDSPAWNOBJECTS_H_ */
@@ -24,6 +24,7 @@
 
 #include <otest2/caseordinaryptr.h>
 #include <otest2/command.h>
+#include <otest2/waitsource.h>
 
 namespace OTest2 {
 
@@ -32,6 +33,7 @@ class CmdState : public Command {
     CaseOrdinaryPtr testcase;
     std::string name;
     int delay;
+    WaitSources wait_sources;
 
   public:
     /* -- avoid copying */
@@ -46,11 +48,14 @@ class CmdState : public Command {
      * @param testcase_ State's parent
      * @param name_ Name of the state
      * @param delay_ Delay of the command in milliseconds
+     * @param wait_sources_ Sources of events which finish the delay
+     *     prematurely
      */
     explicit CmdState(
         CaseOrdinaryPtr testcase_,
         const std::string& name_,
-        int delay_);
+        int delay_,
+        const WaitSources& wait_sources_);
 
     /**
      * @brief Dtor
@@ -20,6 +20,8 @@
 #ifndef OTest2__INCLUDE_OTEST2_COMMAND_H_
 #define OTest2__INCLUDE_OTEST2_COMMAND_H_
 
+#include <otest2/waitsource.h>
+
 namespace OTest2 {
 
 class Context;
@@ -51,12 +53,16 @@ class Command {
      * @param[in] context_  the OTest2 context
      * @param[out] delay_ The waiting delay in milliseconds. It's valid only
      *     if the true value is returned.
+     * @param[out] wait_sources_ Sources of events which finish the waiting
+     *     before the delay elapses. It's valid only if the true value
+     *     is returned.
      * @return True forces the waiting.
      * @note The default behavior is not wait.
      */
     virtual bool shouldWait(
         const Context& context_,
-        int& delay_);
+        int& delay_,
+        WaitSources& wait_sources_);
 
     /**
      * @brief Run the command
@@ -27,6 +27,56 @@ namespace OTest2 {
  */
 constexpr long double DEFAULT_FLOAT_PRECISION(1.0e-12);
 
+/**
+ * @brief Maximal number of failed items reported by the near item-wise
+ *     assertions
+ */
+constexpr int DEFAULT_NEAR_OFFENDERS(10);
+
+/**
+ * @brief Default number of reported keys per a kind of difference
+ *     in the full map assertions
+ */
+constexpr int DEFAULT_MAP_REPORTED_KEYS(10);
+
+/**
+ * @brief Default relative slowdown tolerated by the performance regression
+ *     assertions
+ */
+constexpr double DEFAULT_PERF_THRESHOLD(0.1);
+
+/**
+ * @brief Tag of suites whose cases run in forked processes
+ */
+constexpr const char FORK_CASES_TAG[] = "otest2.fork";
+
+/**
+ * @brief Tag of testing objects whose repeated runs are independent
+ *     and they can run in parallel
+ */
+constexpr const char PARALLEL_RUNS_TAG[] = "otest2.parallel";
+
+/**
+ * @brief Minimal duration of the warm-up of a benchmark in milliseconds
+ */
+constexpr int BENCHMARK_WARM_UP_TIME(100);
+
+/**
+ * @brief Requested duration of one sample of a benchmark in milliseconds
+ */
+constexpr int BENCHMARK_SAMPLE_TIME(10);
+
+/**
+ * @brief Number of measured samples of a benchmark
+ */
+constexpr int BENCHMARK_SAMPLES(10);
+
+/**
+ * @brief Number of the most expensive test cases listed by the console
+ *     reporter in the verbose mode
+ */
+constexpr int EXPENSIVE_CASES_REPORTED(5);
+
 } /* -- namespace OTest2 */
 
 #endif /* -- OTest2_INCLUDE_OTEST2_CONST_H_ */
@@ -20,9 +20,13 @@
 #ifndef OTest2_INCLUDE_OTEST2_CONTAINERTRAIT_H_
 #define OTest2_INCLUDE_OTEST2_CONTAINERTRAIT_H_
 
+#include <cstddef>
+#include <iterator>
 #include <map>
+#include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <otest2/typetraits.h>
 
@@ -62,6 +66,90 @@ struct ListContainerTrait {
 
 namespace Private {
 
+template<typename Value_>
+struct IsCharType {
+    static constexpr bool value =
+        std::is_same<Value_, char>::value
+        || std::is_same<Value_, wchar_t>::value
+        || std::is_same<Value_, char16_t>::value
+        || std::is_same<Value_, char32_t>::value;
+};
+
+template<typename Iter_, typename Value_, bool char_>
+struct IsStringIterator {
+    static constexpr bool value = false;
+};
+
+template<typename Iter_, typename Value_>
+struct IsStringIterator<Iter_, Value_, true> {
+    static constexpr bool value =
+        std::is_same<Iter_, typename std::basic_string<Value_>::iterator>::value
+        || std::is_same<Iter_, typename std::basic_string<Value_>::const_iterator>::value;
+};
+
+template<typename Iter_, typename Value_, bool arithmetic_>
+struct IsContiguousStdIterator {
+    static constexpr bool value = false;
+};
+
+template<typename Iter_, typename Value_>
+struct IsContiguousStdIterator<Iter_, Value_, true> {
+    /* -- std::vector<bool> is not contiguous */
+    static constexpr bool value =
+        !std::is_same<Value_, bool>::value
+        && (std::is_same<Iter_, typename std::vector<Value_>::iterator>::value
+            || std::is_same<Iter_, typename std::vector<Value_>::const_iterator>::value
+            || IsStringIterator<Iter_, Value_, IsCharType<Value_>::value>::value);
+};
+
+} /* -- namespace Private */
+
+/**
+ * @brief A trait recognizing iterators of contiguous memory blocks
+ *
+ * The item-wise and lexicographical assertions use this trait to detect
+ * contiguous ranges of arithmetic values. Such ranges are compared by bulk
+ * kernels instead of the item by item iteration.
+ *
+ * The default implementation recognizes iterators of the std::vector and
+ * std::basic_string containers of arithmetic types. The specialization
+ * below handles raw pointers (and the std::array iterators which are raw
+ * pointers in the common STL implementations). One can write own
+ * specialization to plug own contiguous container in.
+ */
+template<typename Iter_>
+struct ContiguousIteratorTrait {
+    typedef typename std::iterator_traits<Iter_>::value_type ValueType;
+
+    /**
+     * @brief True if the iterator points into a contiguous memory block
+     */
+    static constexpr bool contiguous = Private::IsContiguousStdIterator<
+        Iter_, ValueType, std::is_arithmetic<ValueType>::value>::value;
+
+    /**
+     * @brief Get address of the item pointed by a dereferenceable iterator
+     */
+    static const ValueType* address(
+        Iter_ iter_) {
+      return &*iter_;
+    }
+};
+
+template<typename Type_>
+struct ContiguousIteratorTrait<Type_*> {
+    typedef typename std::remove_cv<Type_>::type ValueType;
+
+    static constexpr bool contiguous = !std::is_volatile<Type_>::value;
+
+    static const ValueType* address(
+        Type_* iter_) {
+      return iter_;
+    }
+};
+
+namespace Private {
+
 template<typename Type_>
 class HasContainerKeyComp {
   private:
@@ -106,6 +194,14 @@ struct MapTraitImplCommon {
       return cont_.end();
     }
 
+    /**
+     * @brief Get number of items in the container
+     */
+    static std::size_t size(
+        const Container_& cont_) {
+      return cont_.size();
+    }
+
     /**
      * @brief Get range of items with the same key
      */
@@ -122,6 +218,26 @@ struct MapTraitImpl;
 template<typename Container_>
 struct MapTraitImpl<Container_, true> : public MapTraitImplCommon<Container_>
 {
+    /**
+     * @brief The container is iterated in the order of its keys
+     */
+    static constexpr bool ordered = true;
+
+    /**
+     * @brief Type of the key comparator
+     */
+    typedef typename Container_::key_compare KeyCompare;
+
+    /**
+     * @brief Compare order of two keys
+     */
+    static bool keyLess(
+        const Container_& cont_,
+        typename TypeTrait<typename MapTraitImplCommon<Container_>::KeyType>::BestArg a_key_,
+        typename TypeTrait<typename MapTraitImplCommon<Container_>::KeyType>::BestArg b_key_) {
+      return cont_.key_comp()(a_key_, b_key_);
+    }
+
     /**
      * @brief Compare equality of two keys
      */
@@ -136,6 +252,11 @@ struct MapTraitImpl<Container_, true> : public MapTraitImplCommon<Container_>
 template<typename Container_>
 struct MapTraitImpl<Container_, false> : public MapTraitImplCommon<Container_>
 {
+    /**
+     * @brief The container doesn't keep any order of its keys
+     */
+    static constexpr bool ordered = false;
+
     /**
      * @brief Compare equality of two keys
      */
@@ -162,6 +283,14 @@ struct MapTraitImpl<Container_, false> : public MapTraitImplCommon<Container_>
  *     of iterators pointing a range of items mapped with the same key.
  *   * function keyEqual(container_, key1_, key2_): the function returns
  *     true if the keys equal.
+ *
+ * The full map assertions (testAssertMapFull) need some more:
+ *   * function size(container_): number of items in the container.
+ *   * constant ordered: true if the container is iterated in the order
+ *     of its keys.
+ *   * typedef KeyCompare and function keyLess(container_, key1_, key2_)
+ *     comparing order of two keys. They're required just for the ordered
+ *     containers.
  */
 template<typename Container_>
 struct MapContainerTrait :
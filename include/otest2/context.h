@@ -26,6 +26,7 @@ class CommandStack;
 class ExcCatcher;
 class ObjectPath;
 class Reporter;
+class Scheduler;
 class SemanticStack;
 class TestMarkFactory;
 class TestMarkStorage;
@@ -46,6 +47,7 @@ class Context {
     TestMarkFactory* const test_mark_factory;
     TestMarkStorage* const test_mark_storage;
     UserData* const user_data;
+    Scheduler* const scheduler;
 
     /* -- avoid copying */
     Context(
@@ -55,6 +57,9 @@ class Context {
 
     /**
      * @brief Ctor
+     *
+     * @param scheduler_ Scheduler of interleaved testing objects. It's null
+     *     if the runner doesn't interleave the objects.
      */
     explicit Context(
         CommandStack* command_stack_,
@@ -65,7 +70,8 @@ class Context {
         Reporter* reporter_,
         TestMarkFactory* test_mark_factory_,
         TestMarkStorage* test_mark_storage_,
-        UserData* user_data_);
+        UserData* user_data_,
+        Scheduler* scheduler_);
 
     /**
      * @brief Dtor
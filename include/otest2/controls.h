@@ -31,6 +31,8 @@
 
 #endif /* -- OTEST2_PARSER_ACTIVE */
 
+#include <otest2/waitsource.h>
+
 namespace OTest2 {
 
 namespace Controls {
@@ -50,6 +52,26 @@ void switchState(
     void (*state_)(Args_... args_),
     int delay_) TEST_CONTROLS_SWITCH_STATE();
 
+/**
+ * @brief Prepare next test state waiting for some events
+ *
+ * The next state is run as soon as any of the wait sources becomes ready
+ * or when the delay elapses.
+ *
+ * @param state_ The next state
+ * @param delay_ Maximal delay in milliseconds between end of the current
+ *     state and run of the next state.
+ * @param wait_source_ A wait source - a file descriptor
+ *     (::OTest2::WaitSource) or a wait event (::OTest2::WaitEvent)
+ * @param wait_sources_ Other wait sources
+ */
+template<typename... Args_, typename... Sources_>
+void switchState(
+    void (*state_)(Args_... args_),
+    int delay_,
+    const WaitSource& wait_source_,
+    const Sources_&... wait_sources_) TEST_CONTROLS_SWITCH_STATE();
+
 namespace Private {
 
 /**
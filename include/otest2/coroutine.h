@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OTest2_INCLUDE_OTEST2_COROUTINE_H_
+#define OTest2_INCLUDE_OTEST2_COROUTINE_H_
+
+/* -- The coroutine states require a C++20 compiler. The ordinary states
+ *    switched by the switchState() function work in any mode. */
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+
+#define OTEST2_COROUTINES 1
+
+#include <assert.h>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <type_traits>
+
+#include <otest2/coroutineframe.h>
+#include <otest2/stategenerated.h>
+#include <otest2/waitsource.h>
+
+namespace OTest2 {
+
+/**
+ * @brief Return type of coroutine test states
+ *
+ * A test state declared with this return type may suspend itself by
+ * the co_await operator applied on the awaitables returned by the sleep()
+ * and waitFor() functions. The runner resumes the coroutine frame directly
+ * when the delay elapses or an event comes. There is no state switch
+ * and no lookup of the state by its name.
+ *
+ * Example:
+ * @code
+ * OTest2::StateCoroutine firstState() TEST_STATE() {
+ *   co_await OTest2::sleep(100);
+ *   testAssert(server.isRunning());
+ *   co_await OTest2::waitFor(1000, response_event);
+ *   testAssert(response_event.isNotified());
+ * }
+ * @endcode
+ *
+ * The coroutine may still switch to another state by the switchState()
+ * function. The switch is executed after the coroutine finishes.
+ */
+class StateCoroutine {
+  public:
+    class promise_type;
+};
+
+namespace Private {
+
+class CoroutineFrameImpl : public CoroutineFrame {
+  private:
+    std::coroutine_handle<StateCoroutine::promise_type> handle;
+
+  public:
+    explicit CoroutineFrameImpl(
+        std::coroutine_handle<StateCoroutine::promise_type> handle_) :
+      handle(handle_) {
+
+    }
+
+    virtual ~CoroutineFrameImpl() {
+      handle.destroy();
+    }
+
+    virtual bool resumeFrame();
+};
+
+class CoroutineStart {
+  public:
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    void await_suspend(
+        std::coroutine_handle<StateCoroutine::promise_type> handle_);
+
+    void await_resume() const noexcept {
+
+    }
+};
+
+} /* -- namespace Private */
+
+class StateCoroutine::promise_type {
+  private:
+    StateGenerated* state;
+    std::exception_ptr exception;
+
+    friend class Private::CoroutineFrameImpl;
+
+  public:
+    /* -- The state functions are members of the generated state classes.
+     *    The first argument of the promise is the state object then. */
+    template<typename State_, typename... Args_>
+    explicit promise_type(
+        State_& state_,
+        Args_&&...) :
+      state(&state_),
+      exception() {
+      static_assert(
+          std::is_base_of<
+              StateGenerated,
+              typename std::remove_reference<State_>::type>::value,
+          "the coroutine must be a test state");
+    }
+
+    StateGenerated* getState() const noexcept {
+      return state;
+    }
+
+    StateCoroutine get_return_object() const noexcept {
+      return StateCoroutine();
+    }
+
+    Private::CoroutineStart initial_suspend() const noexcept {
+      return Private::CoroutineStart();
+    }
+
+    std::suspend_always final_suspend() const noexcept {
+      return std::suspend_always();
+    }
+
+    void return_void() const noexcept {
+
+    }
+
+    void unhandled_exception() noexcept {
+      exception = std::current_exception();
+    }
+};
+
+namespace Private {
+
+inline bool CoroutineFrameImpl::resumeFrame() {
+  handle.resume();
+  if(!handle.done())
+    return false;
+
+  if(handle.promise().exception)
+    std::rethrow_exception(handle.promise().exception);
+  return true;
+}
+
+inline void CoroutineStart::await_suspend(
+    std::coroutine_handle<StateCoroutine::promise_type> handle_) {
+  /* -- The state takes ownership of the frame and it resumes the frame
+   *    right after the state function returns. */
+  handle_.promise().getState()->attachCoroutine(
+      std::unique_ptr<CoroutineFrame>(new CoroutineFrameImpl(handle_)));
+}
+
+} /* -- namespace Private */
+
+/**
+ * @brief Awaitable suspending a coroutine test state
+ */
+class StateAwait {
+  private:
+    int delay;
+    WaitSources wait_sources;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param delay_ Delay in milliseconds
+     * @param wait_sources_ Sources of events which resume the state before
+     *     the delay elapses
+     */
+    explicit StateAwait(
+        int delay_,
+        const WaitSources& wait_sources_) :
+      delay(delay_),
+      wait_sources(wait_sources_) {
+      assert(delay >= 0);
+    }
+
+    bool await_ready() const noexcept {
+      return false;
+    }
+
+    void await_suspend(
+        std::coroutine_handle<StateCoroutine::promise_type> handle_) const {
+      StateGenerated* state_(handle_.promise().getState());
+      state_->suspendCoroutine(state_->otest2Context(), delay, wait_sources);
+    }
+
+    void await_resume() const noexcept {
+
+    }
+};
+
+/**
+ * @brief Suspend the coroutine test state for specified time
+ *
+ * @param delay_ Delay in milliseconds
+ */
+inline StateAwait sleep(
+    int delay_) {
+  return StateAwait(delay_, WaitSources());
+}
+
+/**
+ * @brief Suspend the coroutine test state until an event comes
+ *
+ * @param timeout_ Maximal time of waiting in milliseconds
+ * @param wait_sources_ Sources of the events. A WaitEvent object can be
+ *     passed too.
+ */
+inline StateAwait waitFor(
+    int timeout_,
+    const WaitSources& wait_sources_) {
+  return StateAwait(timeout_, wait_sources_);
+}
+
+/**
+ * @brief Suspend the coroutine test state until a wait event is notified
+ *
+ * @param timeout_ Maximal time of waiting in milliseconds
+ * @param event_ The wait event. The event object must live until
+ *     the coroutine is resumed.
+ */
+inline StateAwait waitFor(
+    int timeout_,
+    const WaitEvent& event_) {
+  return StateAwait(timeout_, WaitSources{WaitSource(event_)});
+}
+
+} /* -- namespace OTest2 */
+
+#endif /* -- __has_include(<coroutine>) */
+#endif /* -- __cpp_impl_coroutine */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_COROUTINE_H_ */
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OTest2_INCLUDE_OTEST2_COROUTINEFRAME_H_
+#define OTest2_INCLUDE_OTEST2_COROUTINEFRAME_H_
+
+namespace OTest2 {
+
+/**
+ * @brief Suspended frame of a test state coroutine
+ *
+ * The interface hides the coroutine handle from the library which is
+ * compiled in the C++14 mode. The implementation lives in the header
+ * coroutine.h and it's available only with C++20 compilers.
+ */
+class CoroutineFrame {
+  public:
+    /**
+     * @brief Ctor
+     */
+    CoroutineFrame();
+
+    /**
+     * @brief Dtor
+     *
+     * The dtor destroys the coroutine frame.
+     */
+    virtual ~CoroutineFrame();
+
+    /* -- avoid copying */
+    CoroutineFrame(
+        const CoroutineFrame&) = delete;
+    CoroutineFrame& operator = (
+        const CoroutineFrame&) = delete;
+
+    /**
+     * @brief Resume the coroutine
+     *
+     * The coroutine runs until the next suspension point or until it
+     * finishes. An exception escaped from the coroutine body is rethrown.
+     *
+     * @return True if the coroutine has finished
+     */
+    virtual bool resumeFrame() = 0;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_COROUTINEFRAME_H_ */
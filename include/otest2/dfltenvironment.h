@@ -85,6 +85,24 @@ class DfltEnvironment {
     void setExceptionCatcher(
         ExcCatcher* catcher_);
 
+    /**
+     * @brief Run the tests in the virtual time
+     *
+     * The delays of test states are skipped, the time seen by the tests
+     * is moved forward instead. The method must be called before
+     * the runner is created.
+     */
+    void enableVirtualTime();
+
+    /**
+     * @brief Interleave the suites and the cases
+     *
+     * The testing objects don't run one by one. When an object waits
+     * for a delay or for an event, other objects run. The method must
+     * be called before the runner is created.
+     */
+    void enableInterleaving();
+
     /**
      * @brief Access the container of user data
      */
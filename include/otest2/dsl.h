@@ -30,6 +30,7 @@
 #define OT2_SCENARIO()
 #define OT2_STATE()
 #define OT2_SIMPLE() void AnonymousState() OT2_SCENARIO()
+#define OT2_BENCHMARK()
 
 /* -- asserted try/catch block */
 #define testTry try
@@ -51,6 +52,7 @@
 #define OT2_SCENARIO() __attribute__((annotate("otest2::scenario")))
 #define OT2_STATE() __attribute__((annotate("otest2::state")))
 #define OT2_SIMPLE() void AnonymousState() OT2_SCENARIO()
+#define OT2_BENCHMARK() __attribute__((annotate("otest2::benchmark")))
 
 #define testTry try
 #define testCatch(exc_type_, name_) catch(typename ::OTest2::TypePack<exc_type_>::Type __attribute__((annotate("otest2::catch"))) name_ )
@@ -72,6 +74,7 @@
 #define TEST_SCENARIO(name_) void name_() OT2_SCENARIO()
 #define TEST_STATE(name_) void name_() OT2_STATE()
 #define TEST_SIMPLE() OT2_SIMPLE()
+#define TEST_BENCHMARK() void Benchmark() OT2_BENCHMARK()
 #define TEST_SECTION(name_) OT2_SECTION(name_)
 
 #endif /* -- OTest2__INCLUDE_OTEST2_DSL_H_ */
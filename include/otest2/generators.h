@@ -0,0 +1,603 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OTest2_INCLUDE_OTEST2_GENERATORS_H_
+#define OTest2_INCLUDE_OTEST2_GENERATORS_H_
+
+#include <assert.h>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace OTest2 {
+
+/*
+ * Generators produce the values of the streaming repeaters on demand.
+ * A generator is any class offering following interface:
+ *
+ *     typedef ... Value;
+ *     void reset();              -- move to the first value
+ *     bool isValid() const;      -- check whether there is a current value
+ *     Value getValue() const;    -- get the current value
+ *     void next();               -- move to the next value
+ *
+ * A generator must be reset before it's used. The construction of
+ * the generator is expected to be cheap. The work (if any) is done
+ * in the reset() method.
+ */
+
+/**
+ * @brief Generator of an arithmetic sequence [begin, end)
+ */
+template<typename Value_>
+class GeneratorRange {
+  public:
+    typedef Value_ Value;
+
+  private:
+    Value_ begin;
+    Value_ end;
+    Value_ step;
+    Value_ current;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param begin_ First value
+     * @param end_ The end value (not included)
+     * @param step_ Positive step between values
+     */
+    explicit GeneratorRange(
+        Value_ begin_,
+        Value_ end_,
+        Value_ step_) :
+      begin(begin_),
+      end(end_),
+      step(step_),
+      current(begin_) {
+      assert(step > Value_(0));
+    }
+
+    void reset() {
+      current = begin;
+    }
+
+    bool isValid() const {
+      return current < end;
+    }
+
+    Value getValue() const {
+      return current;
+    }
+
+    void next() {
+      /* -- avoid overflow at the end of the type's range */
+      if(end - current <= step)
+        current = end;
+      else
+        current += step;
+    }
+};
+
+/**
+ * @brief Generator iterating a range of iterators
+ *
+ * The iterated container must live while the generator is used.
+ */
+template<typename Iter_>
+class GeneratorIter {
+  public:
+    typedef typename std::iterator_traits<Iter_>::value_type Value;
+
+  private:
+    Iter_ begin;
+    Iter_ end;
+    Iter_ current;
+
+  public:
+    explicit GeneratorIter(
+        Iter_ begin_,
+        Iter_ end_) :
+      begin(begin_),
+      end(end_),
+      current(begin_) {
+
+    }
+
+    void reset() {
+      current = begin;
+    }
+
+    bool isValid() const {
+      return current != end;
+    }
+
+    Value getValue() const {
+      return *current;
+    }
+
+    void next() {
+      ++current;
+    }
+};
+
+/**
+ * @brief Generator asking a functor for values
+ *
+ * The functor gets an index of the value and it fills the value. It returns
+ * false if the index is behind the end of the sequence:
+ *
+ *     bool fce(int index_, Value_& value_);
+ */
+template<typename Value_, typename Fce_>
+class GeneratorFunction {
+  public:
+    typedef Value_ Value;
+
+  private:
+    Fce_ fce;
+    int index;
+    bool valid;
+    Value_ current;
+
+    void fetch() {
+      valid = fce(index, current);
+    }
+
+  public:
+    explicit GeneratorFunction(
+        Fce_ fce_) :
+      fce(std::move(fce_)),
+      index(0),
+      valid(false),
+      current() {
+
+    }
+
+    void reset() {
+      index = 0;
+      fetch();
+    }
+
+    bool isValid() const {
+      return valid;
+    }
+
+    Value getValue() const {
+      return current;
+    }
+
+    void next() {
+      ++index;
+      fetch();
+    }
+};
+
+namespace Private {
+
+template<typename Generators_, std::size_t... indexes_>
+void resetGenerators(
+    Generators_& generators_,
+    std::index_sequence<indexes_...>) {
+  using Expand = int[];
+  (void)Expand{0, (std::get<indexes_>(generators_).reset(), 0)...};
+}
+
+template<typename Generators_, std::size_t... indexes_>
+void nextGenerators(
+    Generators_& generators_,
+    std::index_sequence<indexes_...>) {
+  using Expand = int[];
+  (void)Expand{0, (std::get<indexes_>(generators_).next(), 0)...};
+}
+
+template<typename Generators_, std::size_t... indexes_>
+bool validGenerators(
+    const Generators_& generators_,
+    std::index_sequence<indexes_...>) {
+  bool valid_(true);
+  using Expand = int[];
+  (void)Expand{0, (valid_ = valid_ && std::get<indexes_>(generators_).isValid(), 0)...};
+  return valid_;
+}
+
+template<typename Value_, typename Generators_, std::size_t... indexes_>
+Value_ valueOfGenerators(
+    const Generators_& generators_,
+    std::index_sequence<indexes_...>) {
+  return Value_(std::get<indexes_>(generators_).getValue()...);
+}
+
+} /* -- namespace Private */
+
+/**
+ * @brief Cartesian product of generators
+ *
+ * The values are tuples. The last generator changes the fastest. Only
+ * the current values of the generators are kept, hence the memory doesn't
+ * depend on the size of the product.
+ */
+template<typename... Generators_>
+class GeneratorProduct {
+  public:
+    typedef std::tuple<typename Generators_::Value...> Value;
+
+  private:
+    typedef std::index_sequence_for<Generators_...> Indexes;
+    std::tuple<Generators_...> generators;
+    bool valid;
+
+    bool advance(
+        std::integral_constant<std::size_t, 0>) {
+      auto& generator_(std::get<0>(generators));
+      generator_.next();
+      return generator_.isValid();
+    }
+
+    template<std::size_t index_>
+    bool advance(
+        std::integral_constant<std::size_t, index_>) {
+      /* -- move the generator, if it overflows, reset it and move
+       *    the previous one */
+      auto& generator_(std::get<index_>(generators));
+      generator_.next();
+      if(generator_.isValid())
+        return true;
+      generator_.reset();
+      return advance(std::integral_constant<std::size_t, index_ - 1>());
+    }
+
+  public:
+    explicit GeneratorProduct(
+        Generators_... generators_) :
+      generators(std::move(generators_)...),
+      valid(false) {
+      static_assert(sizeof...(Generators_) > 0, "no generator");
+    }
+
+    void reset() {
+      Private::resetGenerators(generators, Indexes());
+      valid = Private::validGenerators(generators, Indexes());
+    }
+
+    bool isValid() const {
+      return valid;
+    }
+
+    Value getValue() const {
+      return Private::valueOfGenerators<Value>(generators, Indexes());
+    }
+
+    void next() {
+      valid = advance(
+          std::integral_constant<std::size_t, sizeof...(Generators_) - 1>());
+    }
+};
+
+/**
+ * @brief Parallel iteration of generators
+ *
+ * The values are tuples of current values of the generators. The sequence
+ * finishes with the shortest generator.
+ */
+template<typename... Generators_>
+class GeneratorZip {
+  public:
+    typedef std::tuple<typename Generators_::Value...> Value;
+
+  private:
+    typedef std::index_sequence_for<Generators_...> Indexes;
+    std::tuple<Generators_...> generators;
+
+  public:
+    explicit GeneratorZip(
+        Generators_... generators_) :
+      generators(std::move(generators_)...) {
+      static_assert(sizeof...(Generators_) > 0, "no generator");
+    }
+
+    void reset() {
+      Private::resetGenerators(generators, Indexes());
+    }
+
+    bool isValid() const {
+      return Private::validGenerators(generators, Indexes());
+    }
+
+    Value getValue() const {
+      return Private::valueOfGenerators<Value>(generators, Indexes());
+    }
+
+    void next() {
+      Private::nextGenerators(generators, Indexes());
+    }
+};
+
+/**
+ * @brief All-pairs combinations of generators
+ *
+ * The values are tuples. Each pair of values of any two generators
+ * appears at least once in the sequence. The sequence is generated
+ * greedily: each tuple starts with the first uncovered pair and the
+ * other values are chosen to cover the most of the uncovered pairs.
+ *
+ * The values of the generators are kept in the memory together with
+ * the coverage of the pairs. Hence, the memory depends on the sizes
+ * of the generators, not on the size of their product.
+ */
+template<typename... Generators_>
+class GeneratorPairwise {
+  public:
+    typedef std::tuple<typename Generators_::Value...> Value;
+
+  private:
+    typedef std::index_sequence_for<Generators_...> Indexes;
+    static constexpr std::size_t AXES = sizeof...(Generators_);
+
+    std::tuple<Generators_...> generators;
+    std::tuple<std::vector<typename Generators_::Value>...> values;
+    std::vector<std::size_t> sizes;
+    std::vector<std::vector<bool>> uncovered;
+    std::size_t uncovered_count;
+    std::vector<std::size_t> row;
+    bool valid;
+
+    template<std::size_t... indexes_>
+    void materialize(
+        std::index_sequence<indexes_...>) {
+      using Expand = int[];
+      (void)Expand{0, (materializeAxis<indexes_>(), 0)...};
+    }
+
+    template<std::size_t index_>
+    void materializeAxis() {
+      auto& generator_(std::get<index_>(generators));
+      auto& values_(std::get<index_>(values));
+      values_.clear();
+      for(generator_.reset(); generator_.isValid(); generator_.next())
+        values_.push_back(generator_.getValue());
+      sizes[index_] = values_.size();
+    }
+
+    template<std::size_t... indexes_>
+    Value makeValue(
+        std::index_sequence<indexes_...>) const {
+      return Value(std::get<indexes_>(values)[row[indexes_]]...);
+    }
+
+    std::vector<bool>& pairCoverage(
+        std::size_t first_,
+        std::size_t second_) {
+      return uncovered[first_ * AXES + second_];
+    }
+
+    bool isUncovered(
+        std::size_t axis1_,
+        std::size_t value1_,
+        std::size_t axis2_,
+        std::size_t value2_) {
+      if(axis1_ > axis2_) {
+        std::swap(axis1_, axis2_);
+        std::swap(value1_, value2_);
+      }
+      return pairCoverage(axis1_, axis2_)[value1_ * sizes[axis2_] + value2_];
+    }
+
+    void coverRow() {
+      for(std::size_t i_(0); i_ < AXES; ++i_) {
+        for(std::size_t j_(i_ + 1); j_ < AXES; ++j_) {
+          auto&& bit_(pairCoverage(i_, j_)[row[i_] * sizes[j_] + row[j_]]);
+          if(bit_) {
+            bit_ = false;
+            --uncovered_count;
+          }
+        }
+      }
+    }
+
+    void makeRow() {
+      /* -- find the first uncovered pair */
+      std::size_t axis1_(0);
+      std::size_t axis2_(0);
+      std::size_t value1_(0);
+      std::size_t value2_(0);
+      bool found_(false);
+      for(std::size_t i_(0); i_ < AXES && !found_; ++i_) {
+        for(std::size_t j_(i_ + 1); j_ < AXES && !found_; ++j_) {
+          const auto& coverage_(pairCoverage(i_, j_));
+          for(std::size_t k_(0); k_ < coverage_.size(); ++k_) {
+            if(coverage_[k_]) {
+              axis1_ = i_;
+              axis2_ = j_;
+              value1_ = k_ / sizes[j_];
+              value2_ = k_ % sizes[j_];
+              found_ = true;
+              break;
+            }
+          }
+        }
+      }
+      assert(found_);
+
+      /* -- fill the other axes greedily */
+      std::vector<bool> assigned_(AXES, false);
+      row[axis1_] = value1_;
+      row[axis2_] = value2_;
+      assigned_[axis1_] = true;
+      assigned_[axis2_] = true;
+      for(std::size_t axis_(0); axis_ < AXES; ++axis_) {
+        if(assigned_[axis_])
+          continue;
+        std::size_t best_value_(0);
+        int best_gain_(-1);
+        for(std::size_t value_(0); value_ < sizes[axis_]; ++value_) {
+          int gain_(0);
+          for(std::size_t other_(0); other_ < AXES; ++other_) {
+            if(assigned_[other_]
+                && isUncovered(other_, row[other_], axis_, value_))
+              ++gain_;
+          }
+          if(gain_ > best_gain_) {
+            best_gain_ = gain_;
+            best_value_ = value_;
+          }
+        }
+        row[axis_] = best_value_;
+        assigned_[axis_] = true;
+      }
+
+      coverRow();
+    }
+
+  public:
+    explicit GeneratorPairwise(
+        Generators_... generators_) :
+      generators(std::move(generators_)...),
+      values(),
+      sizes(),
+      uncovered(),
+      uncovered_count(0),
+      row(),
+      valid(false) {
+      static_assert(sizeof...(Generators_) > 0, "no generator");
+    }
+
+    void reset() {
+      sizes.assign(AXES, 0);
+      materialize(Indexes());
+      row.assign(AXES, 0);
+
+      valid = true;
+      for(std::size_t size_ : sizes)
+        valid = valid && size_ > 0;
+      if(!valid || AXES < 2)
+        return;
+
+      /* -- all pairs are uncovered at the beginning */
+      uncovered.assign(AXES * AXES, std::vector<bool>());
+      uncovered_count = 0;
+      for(std::size_t i_(0); i_ < AXES; ++i_) {
+        for(std::size_t j_(i_ + 1); j_ < AXES; ++j_) {
+          pairCoverage(i_, j_).assign(sizes[i_] * sizes[j_], true);
+          uncovered_count += sizes[i_] * sizes[j_];
+        }
+      }
+      makeRow();
+    }
+
+    bool isValid() const {
+      return valid;
+    }
+
+    Value getValue() const {
+      return makeValue(Indexes());
+    }
+
+    void next() {
+      if(AXES < 2) {
+        /* -- just one generator, there are no pairs */
+        ++row[0];
+        valid = row[0] < sizes[0];
+      }
+      else if(uncovered_count == 0)
+        valid = false;
+      else
+        makeRow();
+    }
+};
+
+/**
+ * @brief Create a generator of an arithmetic sequence [begin, end)
+ */
+template<typename Value_>
+GeneratorRange<Value_> range(
+    Value_ begin_,
+    Value_ end_,
+    Value_ step_ = Value_(1)) {
+  return GeneratorRange<Value_>(begin_, end_, step_);
+}
+
+/**
+ * @brief Create a generator iterating a range of iterators
+ */
+template<typename Iter_>
+GeneratorIter<Iter_> iterate(
+    Iter_ begin_,
+    Iter_ end_) {
+  return GeneratorIter<Iter_>(begin_, end_);
+}
+
+/**
+ * @brief Create a generator iterating a container
+ *
+ * The container must live while the generator is used.
+ */
+template<typename Container_>
+GeneratorIter<typename Container_::const_iterator> iterate(
+    const Container_& container_) {
+  return GeneratorIter<typename Container_::const_iterator>(
+      container_.begin(), container_.end());
+}
+
+/**
+ * @brief Create a generator asking a functor for values
+ */
+template<typename Value_, typename Fce_>
+GeneratorFunction<Value_, typename std::decay<Fce_>::type> generate(
+    Fce_&& fce_) {
+  return GeneratorFunction<Value_, typename std::decay<Fce_>::type>(
+      std::forward<Fce_>(fce_));
+}
+
+/**
+ * @brief Create cartesian product of generators
+ */
+template<typename... Generators_>
+GeneratorProduct<typename std::decay<Generators_>::type...> product(
+    Generators_&&... generators_) {
+  return GeneratorProduct<typename std::decay<Generators_>::type...>(
+      std::forward<Generators_>(generators_)...);
+}
+
+/**
+ * @brief Create parallel iteration of generators
+ */
+template<typename... Generators_>
+GeneratorZip<typename std::decay<Generators_>::type...> zip(
+    Generators_&&... generators_) {
+  return GeneratorZip<typename std::decay<Generators_>::type...>(
+      std::forward<Generators_>(generators_)...);
+}
+
+/**
+ * @brief Create all-pairs combinations of generators
+ */
+template<typename... Generators_>
+GeneratorPairwise<typename std::decay<Generators_>::type...> pairwise(
+    Generators_&&... generators_) {
+  return GeneratorPairwise<typename std::decay<Generators_>::type...>(
+      std::forward<Generators_>(generators_)...);
+}
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_GENERATORS_H_ */
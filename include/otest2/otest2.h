@@ -21,15 +21,19 @@
 #define OTest2__INCLUDE_OTEST2_OTEST2_H_
 
 #include <otest2/assertions.h>
+#include <otest2/assertionsalloc.h>
 #include <otest2/assertionsitemwise.h>
 #include <otest2/assertionslexi.h>
 #include <otest2/assertionsmap.h>
+#include <otest2/assertionsnear.h>
 #include <otest2/assertionstext.h>
 #include <otest2/comparisons.h>
 #include <otest2/comparisonslexi.h>
 #include <otest2/controls.h>
+#include <otest2/coroutine.h>
 #include <otest2/dsl.h>
 #include <otest2/glue.h>
 #include <otest2/regressions.h>
+#include <otest2/waitevent.h>
 
 #endif /* -- OTest2__INCLUDE_OTEST2_OTEST2_H_ */
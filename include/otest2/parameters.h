@@ -20,6 +20,7 @@
 #ifndef OTest2_INCLUDE_OTEST2_PARAMETERS_H_
 #define OTest2_INCLUDE_OTEST2_PARAMETERS_H_
 
+#include <functional>
 #include <string>
 
 namespace OTest2 {
@@ -33,17 +34,17 @@ class Parameters {
     Impl* pimpl;
 
   public:
-    /* -- avoid copying */
-    Parameters(
-        const Parameters&) = delete;
-    Parameters& operator = (
-        const Parameters&) = delete;
-
     /**
      * @brief Ctor - empty parameters
      */
     Parameters();
 
+    /**
+     * @brief Copy ctor
+     */
+    Parameters(
+        const Parameters& other_);
+
     /**
      * @brief Move ctor
      */
@@ -61,6 +62,12 @@ class Parameters {
     void swap(
         Parameters& other_) noexcept;
 
+    /**
+     * @brief Copy assignment
+     */
+    Parameters& operator = (
+        const Parameters& other_);
+
     /**
      * @brief Move assignment
      */
@@ -77,6 +84,15 @@ class Parameters {
         const std::string& name_,
         const std::string& value_);
 
+    /**
+     * @brief Visit all parameters
+     *
+     * @param visitor_ A functor invoked with the name and the value
+     *     of each parameter
+     */
+    void visitParameters(
+        std::function<void(const std::string&, const std::string&)> visitor_) const;
+
     /**
      * @brief Create one string mixed with a name of a testing object
      *
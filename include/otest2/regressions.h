@@ -20,10 +20,12 @@
 #ifndef OTest2__INCLUDE_OTEST2_REGRESSIONS_H_
 #define OTest2__INCLUDE_OTEST2_REGRESSIONS_H_
 
+#include <functional>
 #include <string>
 
 #include <otest2/assertcontext.h>
 #include <otest2/assertionannotation.h>
+#include <otest2/const.h>
 #include <otest2/testmarkptr.h>
 
 namespace OTest2 {
@@ -40,6 +42,10 @@ class RegressionAssertion : public AssertContext {
     bool storeObjectMark(
         const std::string& key_,
         TestMarkPtr test_mark_);
+    bool comparePerfMark(
+        const std::string& key_,
+        TestMarkPtr test_mark_,
+        double threshold_);
 
   public:
     /* -- avoid copying */
@@ -63,6 +69,15 @@ class RegressionAssertion : public AssertContext {
     bool testRegressionW(
         const std::string& key_,
         const Object_& object_);
+
+    /* -- performance regressions */
+    bool testPerfRegression(
+        const std::string& key_,
+        const std::function<void()>& fce_,
+        double threshold_ = DEFAULT_PERF_THRESHOLD);
+    bool testPerfRegressionW(
+        const std::string& key_,
+        const std::function<void()>& fce_);
 };
 
 namespace Assertions {
@@ -113,6 +128,40 @@ bool testRegressionW(
     const std::string& key_,
     const Object_& object_)TEST_ASSERTION_MARK_TMPL("::OTest2::RegressionAssertion", "testRegressionW< $1 >");
 
+/**
+ * @brief Compare performance of a code block with the stored baseline
+ *
+ * The function @a fce_ is measured as a benchmark (warm-up, calibration
+ * and several timed samples). The median time of one invocation,
+ * the median absolute deviation and the number of samples are compared
+ * with the timing test mark stored with the key @a key_. The assertion
+ * fails if the current median is slower than the stored one by more
+ * than the relative @a threshold_ and the difference is significant
+ * with respect to the measured noise. Being faster never fails.
+ *
+ * @param key_ key of the regression test mark
+ * @param fce_ the measured code
+ * @param threshold_ tolerated relative slowdown (0.1 means 10 %)
+ * @return True if the assertion passes
+ */
+bool testPerfRegression(
+    const std::string& key_,
+    const std::function<void()>& fce_,
+    double threshold_ = DEFAULT_PERF_THRESHOLD) TEST_ASSERTION_MARK(::OTest2::RegressionAssertion, testPerfRegression);
+
+/**
+ * @brief Measure a code block and store the timing as the baseline
+ *
+ * This method stores the mark into the storage. The assertion always fails.
+ *
+ * @param key_ key of the regression test mark
+ * @param fce_ the measured code
+ * @return False
+ */
+bool testPerfRegressionW(
+    const std::string& key_,
+    const std::function<void()>& fce_) TEST_ASSERTION_MARK(::OTest2::RegressionAssertion, testPerfRegressionW);
+
 } /* -- namespace Assertions */
 
 } /* -- namespace OTest2 */
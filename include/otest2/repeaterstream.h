@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OTest2_INCLUDE_OTEST2_REPEATERSTREAM_H_
+#define OTest2_INCLUDE_OTEST2_REPEATERSTREAM_H_
+
+#include <memory>
+#include <otest2/repeater.h>
+#include <type_traits>
+#include <utility>
+
+namespace OTest2 {
+
+namespace Private {
+
+/**
+ * @brief Type erased generator of the streaming repeater
+ */
+template<typename Value_>
+class StreamGenerator {
+  public:
+    virtual ~StreamGenerator() = default;
+
+    virtual void reset() = 0;
+    virtual bool isValid() const = 0;
+    virtual Value_ getValue() const = 0;
+    virtual void next() = 0;
+};
+
+template<typename Value_, typename Generator_>
+class StreamGeneratorImpl : public StreamGenerator<Value_> {
+  private:
+    Generator_ generator;
+
+  public:
+    explicit StreamGeneratorImpl(
+        Generator_&& generator_) :
+      generator(std::move(generator_)) {
+
+    }
+
+    virtual void reset() override {
+      generator.reset();
+    }
+
+    virtual bool isValid() const override {
+      return generator.isValid();
+    }
+
+    virtual Value_ getValue() const override {
+      return generator.getValue();
+    }
+
+    virtual void next() override {
+      generator.next();
+    }
+};
+
+} /* -- namespace Private */
+
+/**
+ * @brief Repeater of values produced lazily by a generator
+ *
+ * This repeater repeats the testing object once for each value produced
+ * by a generator (see generators.h). Contrary to the RepeaterValue the values
+ * are not stored in a list, they are produced one by one as the testing
+ * object is repeated.
+ */
+template<typename Value_>
+class RepeaterStream : public Repeater {
+  private:
+    std::unique_ptr<Private::StreamGenerator<Value_>> generator;
+    Value_ value;
+    int index;
+
+  public:
+    /* -- avoid copying */
+    RepeaterStream(
+        const RepeaterStream&) = delete;
+    RepeaterStream& operator = (
+        const RepeaterStream&) = delete;
+
+    /**
+     * @brief Ctor - just for the sake of the preprocessor, it's not
+     *     implemented
+     */
+    template<typename Generator_>
+    explicit RepeaterStream(
+        Generator_&& generator_);
+
+    /**
+     * @brief Ctor
+     *
+     * @param generator_ The generator. The generator must produce
+     *     at least one value.
+     */
+    explicit RepeaterStream(
+        std::unique_ptr<Private::StreamGenerator<Value_>>&& generator_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~RepeaterStream();
+
+    /**
+     * @brief Get current value
+     */
+    Value_ getValue() const;
+
+    /**
+     * @brief Get current value index
+     */
+    int getIndex() const;
+
+    /* -- repeater interface */
+    virtual bool hasNextRun(
+        const Context& context_) const noexcept;
+
+    /**
+     * @brief Factory function of particular runs
+     *
+     * The generator is used just in the first run. It's ignored
+     * in the following runs.
+     *
+     * @param context_ The OTest2 context
+     * @param current_ Current repeater instance
+     * @param generator_ The generator of values
+     * @return New instance of the repeater
+     */
+    template<typename Generator_>
+    static std::shared_ptr<RepeaterStream> createNext(
+        const Context& context_,
+        std::shared_ptr<RepeaterStream>& current_,
+        Generator_&& generator_) {
+      typedef typename std::decay<Generator_>::type Generator;
+      if(current_ == nullptr) {
+        /* -- first run */
+        Generator copy_(std::forward<Generator_>(generator_));
+        return std::make_shared<RepeaterStream>(
+            std::unique_ptr<Private::StreamGenerator<Value_>>(
+                new Private::StreamGeneratorImpl<Value_, Generator>(
+                    std::move(copy_))));
+      }
+      else
+        return createNext(context_, current_);
+    }
+
+    /**
+     * @brief Factory function of following runs
+     */
+    static std::shared_ptr<RepeaterStream> createNext(
+        const Context& context_,
+        std::shared_ptr<RepeaterStream>& current_);
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_REPEATERSTREAM_H_ */
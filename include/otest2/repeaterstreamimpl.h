@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef OTest2_INCLUDE_OTEST2_REPEATERSTREAMIMPL_H_
+#define OTest2_INCLUDE_OTEST2_REPEATERSTREAMIMPL_H_
+
+#include <assert.h>
+#include <otest2/generators.h>
+#include <otest2/repeaterstream.h>
+#include <utility>
+
+namespace OTest2 {
+
+template<typename Value_>
+RepeaterStream<Value_>::RepeaterStream(
+    std::unique_ptr<Private::StreamGenerator<Value_>>&& generator_) :
+  generator(std::move(generator_)),
+  value(),
+  index(0) {
+  /* -- The generator is always one value ahead. Hence, the repeater
+   *    knows whether there is a next run. */
+  generator->reset();
+  assert(generator->isValid());
+  value = generator->getValue();
+  generator->next();
+}
+
+template<typename Value_>
+RepeaterStream<Value_>::~RepeaterStream() {
+
+}
+
+template<typename Value_>
+Value_ RepeaterStream<Value_>::getValue() const {
+  return value;
+}
+
+template<typename Value_>
+int RepeaterStream<Value_>::getIndex() const {
+  return index;
+}
+
+template<typename Value_>
+bool RepeaterStream<Value_>::hasNextRun(
+    const Context& context_) const noexcept {
+  return generator->isValid();
+}
+
+template<typename Value_>
+std::shared_ptr<RepeaterStream<Value_>> RepeaterStream<Value_>::createNext(
+    const Context& context_,
+    std::shared_ptr<RepeaterStream<Value_>>& current_) {
+  /* -- following runs */
+  assert(current_ != nullptr && current_->generator->isValid());
+  ++current_->index;
+  current_->value = current_->generator->getValue();
+  current_->generator->next();
+  return current_;
+}
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_REPEATERSTREAMIMPL_H_ */
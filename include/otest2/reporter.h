@@ -21,12 +21,15 @@
 #define OTest2__INCLUDE_OTEST2_REPORTER_H_
 
 #include <otest2/assertbufferptr.h>
+#include <otest2/timesource.h>
 #include <string>
 
 namespace OTest2 {
 
+struct BenchmarkResult;
 class Context;
 class Parameters;
+struct ResourceUsage;
 
 /**
  * @brief Generic test reporter
@@ -139,6 +142,53 @@ class Reporter {
     virtual AssertBufferPtr enterError(
         const Context& context_) = 0;
 
+    /**
+     * @brief Report result of a benchmark
+     *
+     * The benchmark is reported inside its test state. The default
+     * implementation ignores the benchmark.
+     *
+     * @param context_ the OTest2 context
+     * @param result_ Statistics of the benchmark
+     */
+    virtual void reportBenchmark(
+        const Context& context_,
+        const BenchmarkResult& result_);
+
+    /**
+     * @brief Report resources consumed by a testing object
+     *
+     * The usage is reported just before the object is left (before
+     * leaveTest(), leaveSuite() or leaveCase()). The values are differences
+     * of the counters at the start and at the end of the object.
+     * The default implementation ignores the usage.
+     *
+     * @param context_ the OTest2 context
+     * @param usage_ The consumed resources
+     */
+    virtual void reportResourceUsage(
+        const Context& context_,
+        const ResourceUsage& usage_);
+
+    /**
+     * @brief Report run of a start-up or a tear-down function
+     *
+     * The run is reported after the function finishes. The current time
+     * of the context is the end of the run. The default implementation
+     * ignores the run.
+     *
+     * @param context_ the OTest2 context
+     * @param start_up_ True for a start-up function, false for a tear-down
+     *     function
+     * @param index_ Zero based index of the function in the testing object
+     * @param begin_ Time when the function has been started
+     */
+    virtual void reportFixture(
+        const Context& context_,
+        bool start_up_,
+        int index_,
+        TimeSource::time_point begin_);
+
     /**
      * @brief Leave a state
      *
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__INCLUDE_OTEST2_REPORTERBUFFER_H_
+#define OTest2__INCLUDE_OTEST2_REPORTERBUFFER_H_
+
+#include <otest2/reporter.h>
+
+namespace OTest2 {
+
+/**
+ * @brief A reporter recording the reported events
+ *
+ * The reporter keeps the events (including the texts of the assertions)
+ * in the memory. The events are replayed into another reporter later.
+ * Each event remembers the time and the object path of its origin. They're
+ * restored in the context of the replayed event, so the target reporter
+ * sees the same durations and paths as if the events were reported
+ * directly.
+ *
+ * The buffer is used by the interleaving runner to keep the report of one
+ * testing object coherent while other objects are running.
+ */
+class ReporterBuffer : public Reporter {
+  private:
+    struct Impl;
+    Impl* pimpl;
+
+  public:
+    /**
+     * @brief Ctor
+     */
+    ReporterBuffer();
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~ReporterBuffer();
+
+    /* -- avoid copying */
+    ReporterBuffer(
+        const ReporterBuffer&) = delete;
+    ReporterBuffer& operator = (
+        const ReporterBuffer&) = delete;
+
+    /**
+     * @brief Replay the recorded events and forget them
+     *
+     * @param target_ The target reporter
+     * @param context_ The OTest2 context used as a base of contexts
+     *     of the replayed events
+     */
+    void replay(
+        Reporter& target_,
+        const Context& context_);
+
+    /* -- reporter interface */
+    virtual void enterTest(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_) override;
+    virtual void enterSuite(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_) override;
+    virtual void enterCase(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_) override;
+    virtual void enterState(
+        const Context& context_,
+        const std::string& name_) override;
+    virtual AssertBufferPtr enterAssert(
+        const Context& context_,
+        bool condition_,
+        const std::string& file_,
+        int lineno_) override;
+    virtual AssertBufferPtr enterError(
+        const Context& context_) override;
+    virtual void reportBenchmark(
+        const Context& context_,
+        const BenchmarkResult& result_) override;
+    virtual void reportResourceUsage(
+        const Context& context_,
+        const ResourceUsage& usage_) override;
+    virtual void reportFixture(
+        const Context& context_,
+        bool start_up_,
+        int index_,
+        TimeSource::time_point begin_) override;
+    virtual void leaveState(
+        const Context& context_,
+        const std::string& name_,
+        bool result_) override;
+    virtual void leaveCase(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_,
+        bool result_) override;
+    virtual void leaveSuite(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_,
+        bool result_) override;
+    virtual void leaveTest(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_,
+        bool result_) override;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__INCLUDE_OTEST2_REPORTERBUFFER_H_ */
@@ -48,7 +48,8 @@ class ReporterConsole : public Reporter {
      *
      * @param out_ An output stream. The ownership is not taken.
      * @param verbose_ If it's true all assertions are printed. If it's false
-     *     just the failed assertions are printed out.
+     *     just the failed assertions are printed out. The verbose mode
+     *     also prints the most expensive test cases.
      * @param hide_location_ If the flag is true, the assertion locations
      *     are hidden (replaced by '...').
      */
@@ -85,6 +86,12 @@ class ReporterConsole : public Reporter {
         int lineno_) override;
     virtual AssertBufferPtr enterError(
         const Context& context_) override;
+    virtual void reportBenchmark(
+        const Context& context_,
+        const BenchmarkResult& result_) override;
+    virtual void reportResourceUsage(
+        const Context& context_,
+        const ResourceUsage& usage_) override;
     virtual void leaveState(
         const Context& context_,
         const std::string& name_,
@@ -41,10 +41,14 @@ class ReporterJUnit : public Reporter {
      * @param file_ filename of the generated XML report
      * @param hide_location_ If it's true the location information (file
      *     and line number is omitted in the generated XML file.
+     * @param report_resources_ If it's true the resources consumed by the test
+     *     cases and the suites are stored as properties. The values are not
+     *     reproducible, so they are omitted by default.
      */
     explicit ReporterJUnit(
         const std::string& file_,
-        bool hide_location_);
+        bool hide_location_,
+        bool report_resources_ = false);
 
     /**
      * @brief Dtor
@@ -80,6 +84,12 @@ class ReporterJUnit : public Reporter {
         int lineno_) override;
     virtual AssertBufferPtr enterError(
         const Context& context_) override;
+    virtual void reportBenchmark(
+        const Context& context_,
+        const BenchmarkResult& result_) override;
+    virtual void reportResourceUsage(
+        const Context& context_,
+        const ResourceUsage& usage_) override;
     virtual void leaveState(
         const Context& context_,
         const std::string& name_,
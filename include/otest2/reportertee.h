@@ -81,6 +81,17 @@ class ReporterTee : public Reporter {
         int lineno_) override;
     virtual AssertBufferPtr enterError(
         const Context& context_) override;
+    virtual void reportBenchmark(
+        const Context& context_,
+        const BenchmarkResult& result_) override;
+    virtual void reportResourceUsage(
+        const Context& context_,
+        const ResourceUsage& usage_) override;
+    virtual void reportFixture(
+        const Context& context_,
+        bool start_up_,
+        int index_,
+        TimeSource::time_point begin_) override;
     virtual void leaveState(
         const Context& context_,
         const std::string& name_,
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__INCLUDE_OTEST2_REPORTERTRACE_H_
+#define OTest2__INCLUDE_OTEST2_REPORTERTRACE_H_
+
+#include <string>
+
+#include <otest2/reporter.h>
+
+namespace OTest2 {
+
+/**
+ * @brief A reporter writing a timeline of the test
+ *
+ * The timeline is written in the Chrome trace-event JSON format. It can be
+ * loaded into chrome://tracing or into the Perfetto UI. The test, the suites,
+ * the cases and the states are reported as nested spans, the start-up
+ * and tear-down functions as complete events and the failed assertions,
+ * the errors and the benchmarks as instant events.
+ *
+ * The events are streamed into the file as they come. Objects running
+ * simultaneously (interleaved or forked parallel runs) are placed
+ * at separate worker threads of the timeline.
+ */
+class ReporterTrace : public Reporter {
+  private:
+    struct Impl;
+    Impl* pimpl;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param file_ filename of the generated trace
+     * @param hide_location_ If it's true the location information (file
+     *     and line number) of failed assertions is omitted in the trace.
+     * @param report_resources_ If it's true the resources consumed by the test
+     *     cases and the suites are stored as arguments of their end events.
+     *     The values are not reproducible, so they are omitted by default.
+     */
+    explicit ReporterTrace(
+        const std::string& file_,
+        bool hide_location_,
+        bool report_resources_ = false);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~ReporterTrace();
+
+    /* -- avoid copying */
+    ReporterTrace(
+        const ReporterTrace&) = delete;
+    ReporterTrace& operator = (
+        const ReporterTrace&) = delete;
+
+    /* -- reporter interface */
+    virtual void enterTest(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_) override;
+    virtual void enterSuite(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_) override;
+    virtual void enterCase(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_) override;
+    virtual void enterState(
+        const Context& context_,
+        const std::string& name_) override;
+    virtual AssertBufferPtr enterAssert(
+        const Context& context_,
+        bool condition_,
+        const std::string& file_,
+        int lineno_) override;
+    virtual AssertBufferPtr enterError(
+        const Context& context_) override;
+    virtual void reportBenchmark(
+        const Context& context_,
+        const BenchmarkResult& result_) override;
+    virtual void reportResourceUsage(
+        const Context& context_,
+        const ResourceUsage& usage_) override;
+    virtual void reportFixture(
+        const Context& context_,
+        bool start_up_,
+        int index_,
+        TimeSource::time_point begin_) override;
+    virtual void leaveState(
+        const Context& context_,
+        const std::string& name_,
+        bool result_) override;
+    virtual void leaveCase(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_,
+        bool result_) override;
+    virtual void leaveSuite(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_,
+        bool result_) override;
+    virtual void leaveTest(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_,
+        bool result_) override;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__INCLUDE_OTEST2_REPORTERTRACE_H_ */
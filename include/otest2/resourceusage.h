@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2_INCLUDE_OTEST2_RESOURCEUSAGE_H_
+#define OTest2_INCLUDE_OTEST2_RESOURCEUSAGE_H_
+
+#include <cstdint>
+
+namespace OTest2 {
+
+/**
+ * @brief Resources consumed by a testing object
+ *
+ * The structure keeps either absolute counters of the process (see sample())
+ * or a difference of two samples. The CPU time is taken from the clock
+ * of the running thread, the other values are taken from getrusage().
+ * The heap allocations of the running thread are counted just if
+ * the instrumentation library is linked (see AllocationTracker).
+ */
+struct ResourceUsage {
+    std::int64_t cpu_time;              /**< CPU time of the thread in microseconds */
+    std::int64_t user_time;             /**< user CPU time of the process in microseconds */
+    std::int64_t system_time;           /**< system CPU time of the process in microseconds */
+    std::int64_t max_rss;               /**< maximal resident set size in kilobytes */
+    std::int64_t minor_faults;          /**< page faults served without I/O */
+    std::int64_t major_faults;          /**< page faults requiring I/O */
+    std::int64_t voluntary_switches;    /**< context switches while waiting (I/O, locks) */
+    std::int64_t involuntary_switches;  /**< context switches by the scheduler */
+    std::int64_t allocations;           /**< heap allocations of the thread */
+    std::int64_t deallocations;         /**< heap deallocations of the thread */
+    std::int64_t allocated_bytes;       /**< bytes allocated by the thread */
+
+    /**
+     * @brief Get current counters of the process and the thread
+     */
+    static ResourceUsage sample() noexcept;
+
+    /**
+     * @brief Compute difference of two samples
+     *
+     * The maximal resident set size is a high-water mark. Its difference
+     * is the growth of the mark. It's never negative - the mark of a forked
+     * child starts at the size of the child which may be lower than
+     * the mark of the parent.
+     */
+    ResourceUsage operator - (
+        const ResourceUsage& other_) const noexcept;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_RESOURCEUSAGE_H_ */
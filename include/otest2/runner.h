@@ -20,6 +20,8 @@
 #ifndef OTest2__INCLUDE_OTEST2_RUNNER_H_
 #define OTest2__INCLUDE_OTEST2_RUNNER_H_
 
+#include <otest2/waitsource.h>
+
 namespace OTest2 {
 
 /**
@@ -36,12 +38,18 @@ namespace OTest2 {
  * he can get the test result by calling the getResult() method. If the test
  * isn't finished, he must get the delay value getDelayMS(), wait for
  * specified time (it can be zero!) and run the test runner again.
+ *
+ * The test may also ask for waking up by some events - the wait sources
+ * returned by the getWaitSources() method. If the list is not empty, the
+ * runner should be run again as soon as any of the sources becomes ready.
+ * The delay is used as a timeout then.
  */
 class RunnerResult {
   private:
     bool running;
     bool result;
     int delay_ms;
+    WaitSources wait_sources;
 
   public:
     /**
@@ -63,6 +71,16 @@ class RunnerResult {
         bool result_,
         int delay_ms_);
 
+    /**
+     * @brief Ctor - waiting for events
+     *
+     * @param delay_ms_ Maximal waiting time in milliseconds
+     * @param wait_sources_ Sources of events which wake up the test
+     */
+    RunnerResult(
+        int delay_ms_,
+        const WaitSources& wait_sources_);
+
     /**
      * @brief Copy ctor
      */
@@ -98,6 +116,14 @@ class RunnerResult {
      */
     int getDelayMS() const;
 
+    /**
+     * @brief Get sources of events which wake up the test before
+     *     the delay elapses
+     *
+     * @note This value is valid only if isFinished() is false!
+     */
+    const WaitSources& getWaitSources() const;
+
     /**
      * @brief Get result of the test - true if the test has passed
      *
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__INCLUDE_OTEST2_RUNNERINTERLEAVED_H_
+#define OTest2__INCLUDE_OTEST2_RUNNERINTERLEAVED_H_
+
+#include <otest2/runner.h>
+#include <otest2/scenarioiterptr.h>
+
+namespace OTest2 {
+
+class ExcCatcher;
+class Reporter;
+class TestMarkFactory;
+class TestMarkStorage;
+class TimeSource;
+class UserData;
+
+/**
+ * @brief A runner interleaving the testing objects on one thread
+ *
+ * The runner works as well as the RunnerOrdinary does, but the suites
+ * and the cases don't run one by one. Each of them gets its own command
+ * stack, semantic stack and object path (a lane). When a lane waits
+ * for a delay or for an event, other ready lanes run. The waiting lanes
+ * are ordered by their wake-up times. The runner returns into the main
+ * loop only if all lanes wait.
+ *
+ * A parent object (the test or a suite) waits until all its children
+ * finish. Then its tear-down functions are invoked. Reports of a lane
+ * are kept in a ReporterBuffer and they're passed to the parent lane
+ * as one block when the lane finishes. Hence, the report stays
+ * coherent although the objects run concurrently.
+ *
+ * The lanes run on one thread, the fixtures don't need to be thread-safe.
+ * However, the objects must be independent: they can't rely on the order
+ * of the run.
+ */
+class RunnerInterleaved : public Runner {
+  private:
+    struct Impl;
+    Impl* pimpl;
+
+  public:
+    /* -- avoid copying */
+    RunnerInterleaved(
+        const RunnerInterleaved&) = delete;
+    RunnerInterleaved& operator =(
+        const RunnerInterleaved&) = delete;
+
+    /**
+     * @brief Ctor
+     *
+     * @param time_source_ A source of current time. The ownership is not taken.
+     * @param exc_catcher_ An exception catcher. The ownership is not taken.
+     * @param reporter_ A reporter object. The ownership is not taken.
+     * @param test_mark_factory_ A factory of test mark nodes. The ownership
+     *     is not taken.
+     * @param test_mark_storage_ Storage of test marks. The ownership is not
+     *     taken.
+     * @param user_data_ A container keeping user's data passed into the test.
+     *     The ownership is not taken.
+     * @param test_registry_ An iterator of the root scenario object
+     */
+    explicit RunnerInterleaved(
+        TimeSource* time_source_,
+        ExcCatcher* exc_catcher_,
+        Reporter* reporter_,
+        TestMarkFactory* test_mark_factory_,
+        TestMarkStorage* test_mark_storage_,
+        UserData* user_data_,
+        ScenarioIterPtr test_scenario_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~RunnerInterleaved();
+
+    /* -- runner interface */
+    virtual RunnerResult runNext() override;
+};
+
+} /* namespace OTest2 */
+
+#endif /* OTest2__INCLUDE_OTEST2_RUNNERINTERLEAVED_H_ */
@@ -118,6 +118,20 @@ class Scenario {
      * @brief Get iterator of children object
      */
     virtual ScenarioIterPtr getChildren() const = 0;
+
+    /**
+     * @brief Check whether the children objects run in forked processes
+     *
+     * The children run in the main process by default.
+     */
+    virtual bool forkChildren() const noexcept;
+
+    /**
+     * @brief Check whether the repeated runs of the object run in parallel
+     *
+     * The runs are executed one by one by default.
+     */
+    virtual bool parallelRuns() const noexcept;
 };
 
 } /* -- namespace OTest2 */
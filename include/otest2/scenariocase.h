@@ -96,6 +96,7 @@ class ScenarioCase : public Scenario {
     virtual void leaveObject(
         const Context& context_) const noexcept override;
     virtual ScenarioIterPtr getChildren() const override;
+    virtual bool parallelRuns() const noexcept override;
 };
 
 /**
@@ -75,6 +75,8 @@ class ScenarioSuite : public ScenarioContainer {
     virtual void leaveObject(
         const Context& context_) const noexcept override;
     virtual ScenarioIterPtr getChildren() const override;
+    virtual bool forkChildren() const noexcept override;
+    virtual bool parallelRuns() const noexcept override;
 
     /* -- scenario container */
     virtual void appendScenario(
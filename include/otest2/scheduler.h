@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2_INCLUDE_OTEST2_SCHEDULER_H_
+#define OTest2_INCLUDE_OTEST2_SCHEDULER_H_
+
+namespace OTest2 {
+
+class Context;
+
+/**
+ * @brief Scheduler of interleaved testing objects
+ *
+ * The interface is offered by runners which multiplex several testing
+ * objects on one thread. Each spawned object gets its own OTest2 context
+ * (its own command stack, semantic stack and object path) and it runs
+ * while the other objects wait for their delays or events.
+ *
+ * If the runner doesn't interleave the objects, the scheduler in the context
+ * is null.
+ */
+class Scheduler {
+  public:
+    /**
+     * @brief Ctor
+     */
+    Scheduler();
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~Scheduler();
+
+    /* -- avoid copying */
+    Scheduler(
+        const Scheduler&) = delete;
+    Scheduler& operator = (
+        const Scheduler&) = delete;
+
+    /**
+     * @brief Spawn a new testing object
+     *
+     * @param context_ Context of the spawning (parent) object
+     * @return Context of the new object. The caller is expected to push
+     *     the commands of the object into its command stack. The object
+     *     starts to run after the parent object is joined.
+     */
+    virtual const Context& spawnObject(
+        const Context& context_) = 0;
+
+    /**
+     * @brief Wait until all objects spawned by the parent finish
+     *
+     * Results of the spawned objects are joined into the top of the parent's
+     * semantic stack.
+     *
+     * @param context_ Context of the parent object
+     */
+    virtual void joinObjects(
+        const Context& context_) = 0;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2_INCLUDE_OTEST2_SCHEDULER_H_ */
@@ -23,6 +23,7 @@
 #include <otest2/caseordinaryptr.h>
 #include <otest2/object.h>
 #include <otest2/stateptr.h>
+#include <otest2/waitsource.h>
 
 namespace OTest2 {
 
@@ -58,13 +59,16 @@ class State : public Object {
      * @param delay_cmd_ If it's true, the run of the command is delayed
      * @param delay_ Delay of the command in milliseconds. The value is meant
      *     only if the @a wait_ is true.
+     * @param wait_sources_ Sources of events which finish the delay
+     *     prematurely. The value is meant only if the @a wait_ is true.
      */
     virtual void scheduleRun(
         const Context& context_,
         CaseOrdinaryPtr parent_,
         StatePtr this_ptr_,
         bool delay_cmd_,
-        int delay_) = 0;
+        int delay_,
+        const WaitSources& wait_sources_) = 0;
 };
 
 } /* -- namespace OTest2 */
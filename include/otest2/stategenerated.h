@@ -20,14 +20,17 @@
 #ifndef OTest2INCLUDE_STATEGENERATED_H_
 #define OTest2INCLUDE_STATEGENERATED_H_
 
+#include <memory>
 #include <string>
 
 #include <otest2/contextobject.h>
 #include <otest2/stateordinary.h>
+#include <otest2/waitsource.h>
 
 namespace OTest2 {
 
 class Context;
+class CoroutineFrame;
 
 /**
  * @brief Common implementation of generated states
@@ -69,10 +72,39 @@ class StateGenerated : public StateOrdinary, public ContextObject {
     virtual void executeState(
         const Context& context_,
         CaseOrdinaryPtr parent_);
+    virtual bool isSuspended() const;
 
     /* -- context object */
     virtual const Context& otest2Context() const;
 
+    /**
+     * @brief Attach a coroutine frame of the state function
+     *
+     * The method is invoked by a coroutine state function when it starts.
+     * The frame is owned by the state and it's resumed instead of running
+     * the state function again until the coroutine finishes.
+     *
+     * @param frame_ The coroutine frame
+     */
+    void attachCoroutine(
+        std::unique_ptr<CoroutineFrame> frame_);
+
+    /**
+     * @brief Suspend the attached coroutine
+     *
+     * The method schedules resumption of the coroutine. The delay and
+     * the wait sources work the same way as in the switchState() method.
+     *
+     * @param context_ The OTest2 context
+     * @param delay_ Delay of resumption of the coroutine in milliseconds
+     * @param wait_sources_ Sources of events which resume the coroutine
+     *     before the delay elapses.
+     */
+    void suspendCoroutine(
+        const Context& context_,
+        int delay_,
+        const WaitSources& wait_sources_);
+
   private:
     /**
      * @brief Run the state code
@@ -92,11 +124,14 @@ class StateGenerated : public StateOrdinary, public ContextObject {
      * @param context_ The OTest2 context
      * @param name_ Name of the next state
      * @param delay_ Delay of running of the next state in milliseconds
+     * @param wait_sources_ Sources of events which run the next state
+     *     before the delay elapses. The delay works as a timeout then.
      */
     void switchState(
         const Context& context_,
         const std::string& name_,
-        int delay_);
+        int delay_,
+        const WaitSources& wait_sources_ = WaitSources());
 
     /**
      * @brief Check whether a test section is active
@@ -61,13 +61,24 @@ class StateOrdinary : public State {
         const Context& context_,
         CaseOrdinaryPtr parent_) = 0;
 
+    /**
+     * @brief Check whether the state is suspended
+     *
+     * A suspended state has been left in the middle of its run and it's
+     * going to be resumed (see the coroutine states).
+     *
+     * @return True if the state is suspended
+     */
+    virtual bool isSuspended() const;
+
     /* -- state interface */
     virtual void scheduleRun(
         const Context& context_,
         CaseOrdinaryPtr parent_,
         StatePtr this_ptr_,
         bool wait_,
-        int delay_);
+        int delay_,
+        const WaitSources& wait_sources_);
 };
 
 } /* namespace OTest2 */
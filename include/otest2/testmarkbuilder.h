@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <otest2/testmarkhashcode.h>
 #include <otest2/testmarkptr.h>
@@ -191,6 +192,58 @@ class TestMarkBuilder {
     void appendString(
         const std::string& value_);
 
+    /**
+     * @brief Append a packed array of integers
+     *
+     * @param values_ The integer values
+     */
+    void appendIntArray(
+        std::vector<std::int64_t> values_);
+
+    /**
+     * @brief Append a packed array of integers
+     *
+     * @param begin_ Beginning of a range of integer values
+     * @param end_ End of the range
+     */
+    template<typename Iter_>
+    void appendIntArray(
+        Iter_ begin_,
+        Iter_ end_) {
+      appendIntArray(std::vector<std::int64_t>(begin_, end_));
+    }
+
+    /**
+     * @brief Append a packed array of floats
+     *
+     * @param values_ The float values
+     */
+    void appendFloatArray(
+        std::vector<long double> values_);
+
+    /**
+     * @brief Append a packed array of floats
+     *
+     * @param begin_ Beginning of a range of float values
+     * @param end_ End of the range
+     */
+    template<typename Iter_>
+    void appendFloatArray(
+        Iter_ begin_,
+        Iter_ end_) {
+      appendFloatArray(std::vector<long double>(begin_, end_));
+    }
+
+    /**
+     * @brief Append a block of raw bytes
+     *
+     * @param data_ The data
+     * @param size_ Size of the data in bytes
+     */
+    void appendBytes(
+        const void* data_,
+        std::size_t size_);
+
     /**
      * @brief Open a new nested level of test mark container
      *
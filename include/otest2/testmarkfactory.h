@@ -80,6 +80,19 @@ class TestMarkFactory {
     TestMarkPtr createMark(
         const std::string& typemark_);
 
+    /**
+     * @brief Get constructor of a testmark type
+     *
+     * The deserializers use the method to resolve the type mark just once.
+     *
+     * @param typemark_ Type identifier of the testmark
+     * @return The constructor. The pointer is valid as long as the factory
+     *     exists.
+     * @exception ExcTestMarkIn
+     */
+    const std::function<TestMarkPtr()>* getConstructor(
+        const std::string& typemark_) const;
+
     /**
      * @brief Register a testmark type
      *
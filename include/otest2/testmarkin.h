@@ -22,6 +22,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include <otest2/testmarkptr.h>
 
@@ -58,6 +59,20 @@ class TestMarkIn {
      */
     virtual std::string readTypeMark() = 0;
 
+    /**
+     * @brief Parse type mark following in the stream and create new empty
+     *     testmark of the type
+     *
+     * The default implementation reads the type mark and passes it
+     * to the factory.
+     *
+     * @param factory_ The testmark factory
+     * @return The testmark
+     * @exception ExcTestMarkIn
+     */
+    virtual TestMarkPtr createMark(
+        TestMarkFactory& factory_);
+
     /**
      * @brief Parse integer following in the stream
      *
@@ -83,6 +98,30 @@ class TestMarkIn {
      */
     virtual std::string readString() = 0;
 
+    /**
+     * @brief Parse an array of integers following in the stream
+     *
+     * The default implementation reads the size of the array followed by
+     * the items.
+     *
+     * @param[out] values_ The integers. The values are appended.
+     * @exception ExcTestMarkIn
+     */
+    virtual void readIntArray(
+        std::vector<std::int64_t>& values_);
+
+    /**
+     * @brief Parse an array of floats following in the stream
+     *
+     * The default implementation reads the size of the array followed by
+     * the items.
+     *
+     * @param[out] values_ The values. The values are appended.
+     * @exception ExcTestMarkIn
+     */
+    virtual void readFloatArray(
+        std::vector<long double>& values_);
+
     /**
      * @brief Deserialize a testmark
      *
@@ -21,7 +21,10 @@
 #define OTest2__INCLUDE_OTEST2_TESTMARKINBIN_H_
 
 #include <cstdint>
+#include <functional>
 #include <initializer_list>
+#include <string>
+#include <vector>
 
 #include <otest2/testmarkin.h>
 
@@ -31,21 +34,64 @@ enum class TestMarkOutBinTag : std::uint8_t;
 
 /**
  * @brief Testmark deserializer based on a binary stream
+ *
+ * The deserializer parses the data from a buffer window. The window is
+ * filled by the subclass when the deserializer exhausts it. Hence,
+ * the values are parsed without any virtual call as long as the data
+ * are in the window.
  */
 class TestMarkInBin : public TestMarkIn {
   private:
+    const std::uint8_t* current;
+    const std::uint8_t* end;
+
+    /* -- table of the type marks (indexed by their IDs) */
+    struct TypeMarkRecord {
+        std::string typemark;
+        const std::function<TestMarkPtr()>* ctor;
+    };
+    std::vector<TypeMarkRecord> typemarks;
+    const TestMarkFactory* typemarks_factory;
+
     /**
-     * @brief Read binary data from the stream
+     * @brief Fill the buffer window
      *
-     * @param[in] size_ Size of the buffer
-     * @param[out] buffer_ an output buffer at least of the size @a size_
+     * The method is invoked when the current window is exhausted. The method
+     * is expected to set new window by the setBuffer() method.
+     *
+     * @return False if there are no more data
+     * @exception ExcTestMarkIn An input error
      */
-    virtual void readBinaryData(
-        std::uint64_t size_,
-        std::uint8_t* buffer_) = 0;
+    virtual bool fillBuffer() = 0;
 
+    void readBinaryData(
+        std::uint64_t size_,
+        std::uint8_t* buffer_);
+    std::uint8_t readByte();
     TestMarkOutBinTag readTag(
         std::initializer_list<TestMarkOutBinTag> tags_);
+    std::uint16_t readUInt16();
+    std::uint64_t readUInt64();
+    void readRawString(
+        std::uint64_t length_,
+        std::string& string_);
+    TypeMarkRecord& readTypeMarkRecord();
+    std::int64_t readIntValue(
+        TestMarkOutBinTag tag_);
+    long double readFloatValue(
+        TestMarkOutBinTag tag_);
+
+  protected:
+    /**
+     * @brief Set new buffer window
+     *
+     * @param begin_ Beginning of the window. The ownership is not taken.
+     *     The data must be valid until the window is exhausted.
+     * @param size_ Size of the window
+     */
+    void setBuffer(
+        const std::uint8_t* begin_,
+        std::uint64_t size_);
 
   public:
     /**
@@ -60,9 +106,15 @@ class TestMarkInBin : public TestMarkIn {
 
     /* -- testmarkin */
     virtual std::string readTypeMark() override;
+    virtual TestMarkPtr createMark(
+        TestMarkFactory& factory_) override;
     virtual std::int64_t readInt() override;
     virtual long double readFloat() override;
     virtual std::string readString() override;
+    virtual void readIntArray(
+        std::vector<std::int64_t>& values_) override;
+    virtual void readFloatArray(
+        std::vector<long double>& values_) override;
 };
 
 } /* -- namespace OTest2 */
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__INCLUDE_OTEST2_TESTMARKINBINBUFFER_H_
+#define OTest2__INCLUDE_OTEST2_TESTMARKINBINBUFFER_H_
+
+#include <cstdint>
+#include <string>
+
+#include <otest2/testmarkinbin.h>
+
+namespace OTest2 {
+
+/**
+ * @brief Binary testmark deserializer reading a contiguous memory buffer
+ *
+ * The whole serialized testmark is expected in the buffer. The data
+ * are parsed directly from the buffer without any copying.
+ */
+class TestMarkInBinBuffer : public TestMarkInBin {
+  private:
+    /* -- binary deserializer */
+    virtual bool fillBuffer() override;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param data_ The buffer. The ownership is not taken.
+     * @param size_ Size of the buffer
+     */
+    explicit TestMarkInBinBuffer(
+        const std::uint8_t* data_,
+        std::uint64_t size_);
+
+    /**
+     * @brief Ctor
+     *
+     * @param data_ The buffer. The ownership is not taken, the string must
+     *     not be changed while the deserializer exists.
+     */
+    explicit TestMarkInBinBuffer(
+        const std::string& data_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~TestMarkInBinBuffer();
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__INCLUDE_OTEST2_TESTMARKINBINBUFFER_H_ */
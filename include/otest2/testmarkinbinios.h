@@ -20,7 +20,9 @@
 #ifndef OTest2__INCLUDE_OTEST2_TESTMARKINBINIOS_H_
 #define OTest2__INCLUDE_OTEST2_TESTMARKINBINIOS_H_
 
+#include <cstdint>
 #include <iosfwd>
+#include <vector>
 
 #include <otest2/testmarkinbin.h>
 
@@ -28,15 +30,17 @@ namespace OTest2 {
 
 /**
  * @brief Binary testmark deserializer based on a C++ input stream
+ *
+ * The stream is read in blocks. Hence, the deserializer can read more data
+ * than the testmark consists of.
  */
 class TestMarkInBinIOS : public TestMarkInBin {
   private:
     std::istream* is;
+    std::vector<std::uint8_t> block;
 
     /* -- binary deserializer */
-    virtual void readBinaryData(
-        std::uint64_t size_,
-        std::uint8_t* buffer_) override;
+    virtual bool fillBuffer() override;
 
   public:
     /**
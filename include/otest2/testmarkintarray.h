@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__INCLUDE_OTEST2_TESTMARKINTARRAY_H_
+#define OTest2__INCLUDE_OTEST2_TESTMARKINTARRAY_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <otest2/testmarkprefix.h>
+#include <otest2/testmarkptr.h>
+
+namespace OTest2 {
+
+struct CtorMark;
+
+/**
+ * @brief Packed array of integers
+ *
+ * The array keeps the values in one contiguous block. The values are
+ * hashed, compared and serialized in bulk. The nested test marks of
+ * the items are created only if the array is printed or diffed.
+ */
+class TestMarkIntArray : public TestMarkPrefix {
+  private:
+    std::vector<std::int64_t> values;
+    mutable std::vector<TestMarkPtr> items;
+
+    void hashValues();
+    const std::vector<TestMarkPtr>& getItems() const;
+
+    /* -- prefixed test mark interface */
+    virtual bool doIsEqualPrefixed(
+        const TestMark& other_,
+        long double precision_) const;
+    virtual void doDiffArray(
+        int level_,
+        std::vector<LinearizedRecord>& array_) const;
+    virtual void doLinearizedMark(
+        int level_,
+        const std::string& label_,
+        std::vector<LinearizedRecord>& array_) const;
+    virtual const char* getParenthesis() const;
+    virtual void serializeItems(
+        TestMarkOut& serializer_) const;
+    virtual void deserializeItems(
+        TestMarkFactory& factory_,
+        TestMarkIn& deserializer_);
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param values_ The values
+     */
+    explicit TestMarkIntArray(
+        std::vector<std::int64_t> values_);
+
+    /**
+     * @brief Ctor
+     *
+     * @param prefix_ Test mark prefix
+     * @param values_ The values
+     */
+    explicit TestMarkIntArray(
+        const std::string& prefix_,
+        std::vector<std::int64_t> values_);
+
+    /**
+     * @brief Deserialization ctor
+     */
+    explicit TestMarkIntArray(
+        const CtorMark*);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~TestMarkIntArray();
+
+    /* -- avoid copying */
+    TestMarkIntArray(
+        const TestMarkIntArray&) = delete;
+    TestMarkIntArray& operator =(
+        const TestMarkIntArray&) = delete;
+
+    /**
+     * @brief Get serialization typemark
+     */
+    static const char* typeMark();
+};
+
+} /* namespace OTest2 */
+
+#endif /* OTest2__INCLUDE_OTEST2_TESTMARKINTARRAY_H_ */
@@ -22,6 +22,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace OTest2 {
 
@@ -78,6 +79,28 @@ class TestMarkOut {
      */
     virtual void writeString(
         const std::string& string_) = 0;
+
+    /**
+     * @brief Write an array of integers
+     *
+     * The default implementation writes the size of the array followed by
+     * the items.
+     *
+     * @param values_ The integers
+     */
+    virtual void writeIntArray(
+        const std::vector<std::int64_t>& values_);
+
+    /**
+     * @brief Write an array of floats
+     *
+     * The default implementation writes the size of the array followed by
+     * the items.
+     *
+     * @param values_ The values
+     */
+    virtual void writeFloatArray(
+        const std::vector<long double>& values_);
 };
 
 } /* -- namespace OTest2 */
@@ -21,6 +21,8 @@
 #define OTest2__INCLUDE_OTEST2_TESTMARKOUTBIN_H_
 
 #include <cstdint>
+#include <string>
+#include <unordered_map>
 
 #include <otest2/testmarkout.h>
 
@@ -34,6 +36,10 @@ enum class TestMarkOutBinTag : std::uint8_t;
  */
 class TestMarkOutBin : public TestMarkOut {
   private:
+    /* -- IDs of already written type marks */
+    std::unordered_map<std::string, std::uint64_t> typemarks;
+    std::uint64_t typemarks_count;
+
     /**
      * @brief Write a block of binary data
      *
@@ -46,6 +52,8 @@ class TestMarkOutBin : public TestMarkOut {
 
     void writeTag(
         TestMarkOutBinTag tag_);
+    void writeUInt64(
+        std::uint64_t value_);
 
   public:
     /**
@@ -73,6 +81,10 @@ class TestMarkOutBin : public TestMarkOut {
         long double value_) override;
     virtual void writeString(
         const std::string& string_) override;
+    virtual void writeIntArray(
+        const std::vector<std::int64_t>& values_) override;
+    virtual void writeFloatArray(
+        const std::vector<long double>& values_) override;
 };
 
 } /* -- namespace OTest2 */
@@ -49,6 +49,9 @@ class TestMarkStorage {
 
     /**
      * @brief Dtor
+     *
+     * The dtor saves the changed test marks if they haven't been saved
+     * yet. A failure is reported on the standard error output.
      */
     virtual ~TestMarkStorage();
 
@@ -58,9 +61,24 @@ class TestMarkStorage {
     TestMarkStorage& operator = (
         const TestMarkStorage&) = delete;
 
+    /**
+     * @brief Forbid changes of the storage
+     *
+     * The storage of a forked process is just a copy of the storage
+     * of the main process. Changes of the copy would be lost.
+     */
+    void setReadOnly();
+
+    /**
+     * @brief Check whether the storage may be changed
+     */
+    bool isReadOnly() const;
+
     /**
      * @brief Set new or reset old test mark
      *
+     * The storage must not be read-only.
+     *
      * @param key_ Key of the test mark
      * @param test_mark_ The test mark
      */
@@ -68,6 +86,16 @@ class TestMarkStorage {
         const std::string& key_,
         TestMarkPtr test_mark_);
 
+    /**
+     * @brief Store the test marks into the storage file
+     *
+     * The file is written only if a test mark has been changed since
+     * the last save.
+     *
+     * @exception std::exception if the marks cannot be encoded or written
+     */
+    void save();
+
     /**
      * @brief Get test mark
      *
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__INCLUDE_OTEST2_TESTMARKTIMING_H_
+#define OTest2__INCLUDE_OTEST2_TESTMARKTIMING_H_
+
+#include <cstdint>
+
+#include <otest2/testmark.h>
+
+namespace OTest2 {
+
+struct CtorMark;
+
+/**
+ * @brief Test mark of a timing distribution
+ *
+ * The mark keeps the median time of one operation, the median absolute
+ * deviation of the measured samples and the number of the samples. It's
+ * used as the baseline of the performance regression assertions.
+ * The times are in nanoseconds.
+ */
+class TestMarkTiming : public TestMark {
+  private:
+    long double median;
+    long double mad;
+    std::int64_t samples;
+
+    /* -- testmark interface */
+    virtual TestMarkHashCode doGetHashCode() const noexcept;
+    virtual bool doIsEqual(
+        const TestMark& other_,
+        long double precision_) const;
+    virtual bool doIsEqualValue(
+        const TestMark& other_,
+        long double precision_) const;
+    virtual void doDiffArray(
+        int level_,
+        std::vector<LinearizedRecord>& array_) const;
+    virtual void doLinearizedMark(
+        int level_,
+        const std::string& label_,
+        std::vector<LinearizedRecord>& array_) const;
+    virtual void doPrintOpen(
+        std::ostream& os_,
+        const std::string& prefix_) const;
+    virtual void doPrintClose(
+        std::ostream& os_,
+        const std::string& prefix_) const;
+    virtual void doSerializeMark(
+        TestMarkOut& serializer_) const;
+    virtual void doDeserializeMark(
+        TestMarkFactory& factory_,
+        TestMarkIn& deserializer_);
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param median_ Median time of one operation
+     * @param mad_ Median absolute deviation of the samples
+     * @param samples_ Number of the samples
+     */
+    explicit TestMarkTiming(
+        long double median_,
+        long double mad_,
+        std::int64_t samples_);
+
+    /**
+     * @brief Deserialization ctor
+     */
+    explicit TestMarkTiming(
+        const CtorMark*);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~TestMarkTiming();
+
+    /* -- avoid copying */
+    TestMarkTiming(
+        const TestMarkTiming&) = delete;
+    TestMarkTiming& operator = (
+        const TestMarkTiming&) = delete;
+
+    /**
+     * @brief Get serialization typemark
+     */
+    static const char* typeMark();
+
+    /**
+     * @brief Get the median time of one operation
+     */
+    long double getMedian() const noexcept;
+
+    /**
+     * @brief Get the median absolute deviation of the samples
+     */
+    long double getMad() const noexcept;
+
+    /**
+     * @brief Get number of the samples
+     */
+    std::int64_t getSamples() const noexcept;
+};
+
+} /* namespace OTest2 */
+
+#endif /* OTest2__INCLUDE_OTEST2_TESTMARKTIMING_H_ */
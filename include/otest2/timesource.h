@@ -52,6 +52,20 @@ class TimeSource {
      * @brief Get current time
      */
     virtual time_point now() = 0;
+
+    /**
+     * @brief Let the time pass without waiting
+     *
+     * The runner calls this method when all the work waits for
+     * the @a delay_ and there is no other event to wait for.
+     *
+     * @param delay_ The delay
+     * @return True if the time source has moved its time by the delay.
+     *     False if the caller must really wait. The default implementation
+     *     returns false.
+     */
+    virtual bool fastForward(
+        duration delay_);
 };
 
 } /* -- namespace OTest2 */
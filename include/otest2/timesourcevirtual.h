@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__INCLUDE_OTEST2_TIMESOURCEVIRTUAL_H_
+#define OTest2__INCLUDE_OTEST2_TIMESOURCEVIRTUAL_H_
+
+#include <chrono>
+
+#include <otest2/timesource.h>
+
+namespace OTest2 {
+
+/**
+ * @brief Virtual time
+ *
+ * The time flows with the real time but the delays of the test states
+ * are skipped: the runner fast-forwards the time instead of sleeping.
+ * Hence, the test code sees the time consistent with the requested
+ * delays while the test doesn't idle. The real time still flows while
+ * the runner waits for a wait source (a real peer may be involved).
+ */
+class TimeSourceVirtual : public TimeSource {
+  private:
+    time_point start;
+    std::chrono::steady_clock::time_point real_start;
+    duration skipped;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * The virtual time starts at current system time.
+     */
+    TimeSourceVirtual();
+
+    /**
+     * @brief Ctor
+     *
+     * @param start_ Initial value of the virtual time
+     */
+    explicit TimeSourceVirtual(
+        time_point start_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~TimeSourceVirtual();
+
+    /* -- avoid copying */
+    TimeSourceVirtual(
+        const TimeSourceVirtual&) = delete;
+    TimeSourceVirtual& operator = (
+        const TimeSourceVirtual&) = delete;
+
+    /* -- time source interface */
+    virtual time_point now() override;
+    virtual bool fastForward(
+        duration delay_) override;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__INCLUDE_OTEST2_TIMESOURCEVIRTUAL_H_ */
@@ -84,6 +84,19 @@ struct AssertionParameter {
             typename std::remove_reference<Type_>::type>::type>::Type Type;
 };
 
+/**
+ * @brief A helper trait - check whether two values of a type are equal if
+ *     and only if their memory representation is equal
+ *
+ * The trait is used by the bulk comparison of contiguous containers.
+ * The floating point types are excluded intentionally: the NaN values don't
+ * equal each other and the positive and negative zeros are equal.
+ */
+template<typename Type_>
+struct IsBitwiseComparable {
+    static constexpr bool value = std::is_integral<Type_>::value;
+};
+
 }  /* -- namespace OTest2 */
 
 #endif /* OTest2__INCLUDE_OTEST2_TYPETRAITS_H_ */
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__INCLUDE_OTEST2_WAITEVENT_H_
+#define OTest2__INCLUDE_OTEST2_WAITEVENT_H_
+
+namespace OTest2 {
+
+/**
+ * @brief A wake-up event of a waiting test
+ *
+ * The object bridges futures, condition variables and other
+ * synchronization primitives with the main loop. The test passes the event
+ * as a wait source into the state switch. Any thread finishing the awaited
+ * work invokes the notify() method which resumes the test immediately.
+ *
+ * The event stays signaled until it's reset. Hence, the test should call
+ * the reset() method before it waits for the event again.
+ */
+class WaitEvent {
+  private:
+    int fd;
+    int write_fd;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @exception std::system_error if the event cannot be created
+     */
+    WaitEvent();
+
+    /**
+     * @brief Dtor
+     */
+    ~WaitEvent();
+
+    /* -- avoid copying */
+    WaitEvent(
+        const WaitEvent&) = delete;
+    WaitEvent& operator = (
+        const WaitEvent&) = delete;
+
+    /**
+     * @brief Signal the event
+     *
+     * @note The method is thread-safe and async-signal-safe.
+     */
+    void notify() const;
+
+    /**
+     * @brief Reset the signaled event
+     */
+    void reset() const;
+
+    /**
+     * @brief Check whether the event is signaled
+     */
+    bool isNotified() const;
+
+    /**
+     * @brief Get the file descriptor which becomes readable when the event
+     *     is signaled
+     */
+    int getFD() const;
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__INCLUDE_OTEST2_WAITEVENT_H_ */
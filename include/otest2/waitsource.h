@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__INCLUDE_OTEST2_WAITSOURCE_H_
+#define OTest2__INCLUDE_OTEST2_WAITSOURCE_H_
+
+#include <vector>
+
+namespace OTest2 {
+
+class WaitEvent;
+
+/**
+ * @brief A source of an event waking up a waiting test
+ *
+ * The wait source describes a file descriptor and a set of events which
+ * the test waits for between two test states. The main loop is expected
+ * to resume the test as soon as any of the events happens or the delay
+ * of the state switch elapses.
+ */
+class WaitSource {
+  public:
+    enum Events : int {
+      READ = 0x01,          /**< the descriptor is readable */
+      WRITE = 0x02,         /**< the descriptor is writable */
+    };
+
+  private:
+    int fd;
+    int events;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param fd_ The file descriptor
+     * @param events_ A bit combination of the Events flags
+     */
+    WaitSource(
+        int fd_,
+        int events_ = READ);
+
+    /**
+     * @brief Ctor - wait for a notification of a wait event
+     *
+     * @param event_ The wait event. The event object must live until
+     *     the test is resumed.
+     */
+    WaitSource(
+        const WaitEvent& event_);
+
+    /**
+     * @brief Copy ctor
+     */
+    WaitSource(
+        const WaitSource& src_);
+
+    /**
+     * @brief Dtor
+     */
+    ~WaitSource();
+
+    /**
+     * @brief Copy operator
+     */
+    WaitSource& operator = (
+        const WaitSource& src_);
+
+    /**
+     * @brief Get the file descriptor
+     */
+    int getFD() const;
+
+    /**
+     * @brief Get the bit combination of awaited events
+     */
+    int getEvents() const;
+};
+
+typedef std::vector<WaitSource> WaitSources;
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__INCLUDE_OTEST2_WAITSOURCE_H_ */
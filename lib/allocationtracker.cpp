@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <allocationtracker.h>
+
+#include <atomic>
+
+namespace OTest2 {
+
+namespace {
+
+/* -- The counters are plain data, so they are initialized statically.
+ *    They may be used by allocations made before the dynamic
+ *    initialization. */
+std::atomic<bool> installed(false);
+thread_local AllocationStats counters{0, 0, 0};
+
+} /* -- namespace */
+
+bool AllocationTracker::isInstalled() noexcept {
+  return installed.load(std::memory_order_relaxed);
+}
+
+AllocationStats AllocationTracker::sample() noexcept {
+  return counters;
+}
+
+void AllocationTracker::install() noexcept {
+  installed.store(true, std::memory_order_relaxed);
+}
+
+void AllocationTracker::recordAllocation(
+    std::size_t size_) noexcept {
+  ++counters.allocations;
+  counters.bytes += static_cast<std::int64_t>(size_);
+}
+
+void AllocationTracker::recordDeallocation() noexcept {
+  ++counters.deallocations;
+}
+
+} /* -- namespace OTest2 */
@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The instrumentation library replacing the global operators new and delete.
+ * The operators allocate the memory by malloc() and record the calls
+ * into the allocation tracker. Link the library into the test binary
+ * to enable counting of the allocations.
+ */
+
+#include <cstdlib>
+#include <new>
+#include <stdlib.h>
+
+#include <allocationtracker.h>
+
+namespace OTest2 {
+
+namespace {
+
+class Installer {
+  public:
+    Installer() {
+      AllocationTracker::install();
+    }
+} installer;
+
+void* allocateBlock(
+    std::size_t size_) {
+  if(size_ == 0)
+    size_ = 1;
+
+  /* -- the standard behavior: invoke the new handler until it gives up */
+  void* ptr_;
+  while((ptr_ = std::malloc(size_)) == nullptr) {
+    std::new_handler handler_(std::get_new_handler());
+    if(handler_ == nullptr)
+      return nullptr;
+    handler_();
+  }
+
+  AllocationTracker::recordAllocation(size_);
+  return ptr_;
+}
+
+void* allocateBlockNoThrow(
+    std::size_t size_) noexcept {
+  try {
+    return allocateBlock(size_);
+  }
+  catch(...) {
+    return nullptr;
+  }
+}
+
+void releaseBlock(
+    void* ptr_) noexcept {
+  if(ptr_ != nullptr) {
+    AllocationTracker::recordDeallocation();
+    std::free(ptr_);
+  }
+}
+
+#if defined(__cpp_aligned_new)
+void* allocateAlignedBlock(
+    std::size_t size_,
+    std::align_val_t alignment_) {
+  if(size_ == 0)
+    size_ = 1;
+  std::size_t align_(static_cast<std::size_t>(alignment_));
+  if(align_ < sizeof(void*))
+    align_ = sizeof(void*);
+
+  void* ptr_;
+  while(::posix_memalign(&ptr_, align_, size_) != 0) {
+    std::new_handler handler_(std::get_new_handler());
+    if(handler_ == nullptr)
+      return nullptr;
+    handler_();
+  }
+
+  AllocationTracker::recordAllocation(size_);
+  return ptr_;
+}
+#endif
+
+} /* -- namespace */
+
+} /* -- namespace OTest2 */
+
+void* operator new(
+    std::size_t size_) {
+  void* ptr_(::OTest2::allocateBlock(size_));
+  if(ptr_ == nullptr)
+    throw std::bad_alloc();
+  return ptr_;
+}
+
+void* operator new[](
+    std::size_t size_) {
+  void* ptr_(::OTest2::allocateBlock(size_));
+  if(ptr_ == nullptr)
+    throw std::bad_alloc();
+  return ptr_;
+}
+
+void* operator new(
+    std::size_t size_,
+    const std::nothrow_t&) noexcept {
+  return ::OTest2::allocateBlockNoThrow(size_);
+}
+
+void* operator new[](
+    std::size_t size_,
+    const std::nothrow_t&) noexcept {
+  return ::OTest2::allocateBlockNoThrow(size_);
+}
+
+void operator delete(
+    void* ptr_) noexcept {
+  ::OTest2::releaseBlock(ptr_);
+}
+
+void operator delete[](
+    void* ptr_) noexcept {
+  ::OTest2::releaseBlock(ptr_);
+}
+
+void operator delete(
+    void* ptr_,
+    const std::nothrow_t&) noexcept {
+  ::OTest2::releaseBlock(ptr_);
+}
+
+void operator delete[](
+    void* ptr_,
+    const std::nothrow_t&) noexcept {
+  ::OTest2::releaseBlock(ptr_);
+}
+
+#if defined(__cpp_sized_deallocation)
+void operator delete(
+    void* ptr_,
+    std::size_t) noexcept {
+  ::OTest2::releaseBlock(ptr_);
+}
+
+void operator delete[](
+    void* ptr_,
+    std::size_t) noexcept {
+  ::OTest2::releaseBlock(ptr_);
+}
+#endif
+
+#if defined(__cpp_aligned_new)
+void* operator new(
+    std::size_t size_,
+    std::align_val_t alignment_) {
+  void* ptr_(::OTest2::allocateAlignedBlock(size_, alignment_));
+  if(ptr_ == nullptr)
+    throw std::bad_alloc();
+  return ptr_;
+}
+
+void* operator new[](
+    std::size_t size_,
+    std::align_val_t alignment_) {
+  void* ptr_(::OTest2::allocateAlignedBlock(size_, alignment_));
+  if(ptr_ == nullptr)
+    throw std::bad_alloc();
+  return ptr_;
+}
+
+void operator delete(
+    void* ptr_,
+    std::align_val_t) noexcept {
+  ::OTest2::releaseBlock(ptr_);
+}
+
+void operator delete[](
+    void* ptr_,
+    std::align_val_t) noexcept {
+  ::OTest2::releaseBlock(ptr_);
+}
+
+void operator delete(
+    void* ptr_,
+    std::size_t,
+    std::align_val_t) noexcept {
+  ::OTest2::releaseBlock(ptr_);
+}
+
+void operator delete[](
+    void* ptr_,
+    std::size_t,
+    std::align_val_t) noexcept {
+  ::OTest2::releaseBlock(ptr_);
+}
+#endif
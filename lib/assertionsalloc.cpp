@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <assertionsalloc.h>
+
+#include <allocationtracker.h>
+#include <assertstream.h>
+
+namespace OTest2 {
+
+bool AllocationAssertion::testAssertMaxAllocations(
+    std::int64_t limit_,
+    const std::function<void()>& fce_) {
+  if(!AllocationTracker::isInstalled()) {
+    AssertStream report_(enterAssertion(false));
+    report_ << "allocation tracking is not installed (link the otest2alloc library)"
+        << commitMsg();
+    return report_.getResult();
+  }
+
+  /* -- count the allocations of the code block */
+  const AllocationStats start_(AllocationTracker::sample());
+  fce_();
+  const AllocationStats end_(AllocationTracker::sample());
+  const std::int64_t allocations_(end_.allocations - start_.allocations);
+  const std::int64_t bytes_(end_.bytes - start_.bytes);
+
+  AssertStream report_(enterAssertion(allocations_ <= limit_));
+  report_ << "allocations: " << allocations_ << " (limit: " << limit_
+      << "), allocated bytes: " << bytes_ << commitMsg();
+  return report_.getResult();
+}
+
+} /* -- namespace OTest2 */
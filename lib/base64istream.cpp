@@ -18,8 +18,9 @@
  */
 #include <base64istream.h>
 
+#include <algorithm>
 #include <assert.h>
-#include <cctype>
+#include <cstddef>
 #include <cstdint>
 #include <streambuf>
 
@@ -27,14 +28,32 @@
 
 namespace OTest2 {
 
+/**
+ * @brief Base64 input stream buffer
+ *
+ * The buffer reads the decorated stream in large blocks and decodes them
+ * by a table-driven kernel. Complete quaternions without whitespaces are
+ * decoded directly, the slow path handles just whitespaces, padding and
+ * quaternions split between two blocks.
+ */
 class Base64IStream::Buffer : public std::streambuf {
   private:
     std::istream* decorated;
 
-    static const int base64_index[256];
-
-    enum { BUFFER_SIZE = 3 * 26 };
-    char buffer[BUFFER_SIZE];
+    enum : std::uint8_t {
+      WS = 0x40,  /**< a whitespace */
+      PD = 0x41,  /**< the padding character */
+      XX = 0xff,  /**< an invalid character */
+    };
+    static const std::uint8_t base64_index[256];
+
+    enum { INPUT_SIZE = 4 * 16384 };
+    char input[INPUT_SIZE];
+    const std::uint8_t* input_current;
+    const std::uint8_t* input_end;
+    char output[INPUT_SIZE / 4 * 3];
+    std::uint8_t quaternion[4];
+    int quaternion_length;
     bool eof;
 
   public:
@@ -51,24 +70,39 @@ class Base64IStream::Buffer : public std::streambuf {
   private:
     virtual int underflow() override;
 
-    bool readQuaternion(
-        std::uint8_t quaternion_[]);
+    bool fillInput();
+    char* decodeBlock(
+        char* out_,
+        char* const out_end_);
+    char* decodeQuaternion(
+        char* out_);
 };
 
-const int Base64IStream::Buffer::base64_index[256] = {
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
-    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
-    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
-    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
-    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
-    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+const std::uint8_t Base64IStream::Buffer::base64_index[256] = {
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, WS, WS, WS, WS, WS, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    WS, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, 62, XX, XX, XX, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, XX, XX, XX, PD, XX, XX,
+    XX,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, XX, XX, XX, XX, XX,
+    XX, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+    XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
 };
 
 Base64IStream::Buffer::Buffer(
     std::istream* decorated_) :
   decorated(decorated_),
+  input_current(nullptr),
+  input_end(nullptr),
+  quaternion_length(0),
   eof(false) {
   assert(decorated != nullptr);
 
@@ -78,84 +112,114 @@ Base64IStream::Buffer::~Buffer() {
 
 }
 
-bool Base64IStream::Buffer::readQuaternion(
-    std::uint8_t quaternion_[]) {
-  int i_(0);
-  while(i_ < 4) {
-    int ci_(decorated->get());
-
-    /* -- end of file -> no input data or missing padding */
-    if(ci_ == traits_type::eof())
-      break;
-
-    /* -- skip whitespaces */
-    std::uint8_t c_(static_cast<std::uint8_t>(traits_type::to_char_type(ci_)));
-    if(std::isspace(c_))
-      continue;
+bool Base64IStream::Buffer::fillInput() {
+  decorated->read(input, INPUT_SIZE);
+  const std::streamsize read_bytes_(decorated->gcount());
+  input_current = reinterpret_cast<const std::uint8_t*>(input);
+  input_end = input_current + (read_bytes_ > 0 ? read_bytes_ : 0);
+  return input_current != input_end;
+}
 
-    /* -- invalid character */
-    if(c_ != '=' && base64_index[c_] == -1)
-      break;
+char* Base64IStream::Buffer::decodeQuaternion(
+    char* out_) {
+  quaternion_length = 0;
 
-    /* -- store the character */
-    quaternion_[i_++] = c_;
+  /* -- full quaternion */
+  if(quaternion[3] != PD) {
+    if(quaternion[2] == PD) {
+      /* -- a padding character inside of the quaternion */
+      eof = true;
+      return out_;
+    }
+    const std::uint32_t decoded_(
+        quaternion[0] << 18
+        | quaternion[1] << 12
+        | quaternion[2] << 6
+        | quaternion[3]);
+    *out_++ = decoded_ >> 16 & 0xff;
+    *out_++ = decoded_ >> 8 & 0xff;
+    *out_++ = decoded_ & 0xff;
+    return out_;
   }
 
-  return i_ == 4;
+  /* -- padding, the end of the sequence */
+  eof = true;
+  if(quaternion[0] == PD || quaternion[1] == PD)
+    return out_;
+  std::uint32_t decoded_(quaternion[0] << 18 | quaternion[1] << 12);
+  *out_++ = decoded_ >> 16 & 0xff;
+  if(quaternion[2] != PD) {
+    decoded_ |= quaternion[2] << 6;
+    *out_++ = decoded_ >> 8 & 0xff;
+  }
+  return out_;
 }
 
-int Base64IStream::Buffer::underflow() {
-
-  /* -- we have already reached the end of the sequence */
-  if(eof) {
-    setg(nullptr, nullptr, nullptr);
-    return traits_type::eof();
-  }
+char* Base64IStream::Buffer::decodeBlock(
+    char* out_,
+    char* const out_end_) {
+  while(!eof && out_end_ - out_ >= 3 && input_current != input_end) {
+    /* -- fast path: complete quaternions without any special character */
+    if(quaternion_length == 0) {
+      const std::uint8_t* in_(input_current);
+      const std::uint8_t* const in_end_(
+          in_ + std::min<std::ptrdiff_t>(
+              (input_end - in_) / 4, (out_end_ - out_) / 3) * 4);
+      while(in_ < in_end_) {
+        const std::uint32_t d0_(base64_index[in_[0]]);
+        const std::uint32_t d1_(base64_index[in_[1]]);
+        const std::uint32_t d2_(base64_index[in_[2]]);
+        const std::uint32_t d3_(base64_index[in_[3]]);
+        if((d0_ | d1_ | d2_ | d3_) & 0xc0)
+          break;
+        const std::uint32_t decoded_(d0_ << 18 | d1_ << 12 | d2_ << 6 | d3_);
+        *out_++ = decoded_ >> 16 & 0xff;
+        *out_++ = decoded_ >> 8 & 0xff;
+        *out_++ = decoded_ & 0xff;
+        in_ += 4;
+      }
+      input_current = in_;
+      if(input_current == input_end || out_end_ - out_ < 3)
+        break;
+    }
 
-  char* out_(buffer);
-  char const* const end_(buffer + BUFFER_SIZE);
-  while(out_ < end_) {
-    /* -- read data from the decorated buffer */
-    std::uint8_t quaternion_[4];
-    if(!readQuaternion(quaternion_)) {
-      /* -- There are no other data or the stream is not correctly padded. */
+    /* -- slow path: one character */
+    const std::uint8_t code_(base64_index[*input_current++]);
+    if(code_ == WS)
+      continue;
+    if(code_ == XX) {
+      /* -- an invalid character, the end of the sequence */
       eof = true;
       break;
     }
+    quaternion[quaternion_length++] = code_;
+    if(quaternion_length == 4)
+      out_ = decodeQuaternion(out_);
+  }
 
-    if(quaternion_[3] != '=') {
-      /* -- full quaternion */
-      std::uint32_t decoded_(
-          base64_index[quaternion_[0]] << 18
-          | base64_index[quaternion_[1]] << 12
-          | base64_index[quaternion_[2]] << 6
-          | base64_index[quaternion_[3]]);
-      *out_++ = decoded_ >> 16 & 0xff;
-      *out_++ = decoded_ >> 8 & 0xff;
-      *out_++ = decoded_ & 0xff;
-    }
-    else {
-      /* -- padding */
-      std::uint32_t decoded_(
-          base64_index[quaternion_[0]] << 18
-          | base64_index[quaternion_[1]] << 12);
-      *out_++ = decoded_ >> 16 & 0xff;
-      if(quaternion_[2] != '=') {
-        decoded_ |= base64_index[quaternion_[2]] << 6;
-        *out_++ = decoded_ >> 8 & 0xff;
-      }
+  return out_;
+}
+
+int Base64IStream::Buffer::underflow() {
+  char* out_(output);
+  char* const out_end_(output + sizeof(output));
+  while(!eof && out_ == output) {
+    /* -- read next block of the encoded data. If there are no other data
+     *    the stream is finished (an unfinished quaternion is ignored). */
+    if(input_current == input_end && !fillInput()) {
       eof = true;
       break;
     }
+    out_ = decodeBlock(out_, out_end_);
   }
 
   /* -- Reset the stream buffer pointers. Even if we reached the end of
    *    the sequence, there still can be rest of data. */
-  setg(buffer, buffer, out_);
+  setg(output, output, out_);
 
   /* -- return next sequence character */
-  if(buffer != out_)
-    return traits_type::to_int_type(*buffer);
+  if(output != out_)
+    return traits_type::to_int_type(*output);
   else
     return traits_type::eof();
 }
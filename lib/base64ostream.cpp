@@ -19,25 +19,62 @@
 
 #include <base64ostream.h>
 
+#include <algorithm>
 #include <assert.h>
 #include <cstdint>
+#include <cstring>
 #include <streambuf>
+#include <vector>
 
 #include <utils.h>
 
 namespace OTest2 {
 
+namespace {
+
+const char base64_table[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/**
+ * @brief Table of all pairs of base64 characters
+ *
+ * The table is indexed by 12 bits of input data. Hence, a triplet of
+ * input bytes is encoded by two lookups.
+ */
+struct PairTable {
+    char pairs[4096][2];
+
+    PairTable() {
+      for(int i_(0); i_ < 4096; ++i_) {
+        pairs[i_][0] = base64_table[i_ >> 6];
+        pairs[i_][1] = base64_table[i_ & 0x3f];
+      }
+    }
+};
+
+const PairTable& getPairTable() {
+  static const PairTable table_;
+  return table_;
+}
+
+} /* -- namespace */
+
 /**
  * @brief Base64 output stream buffer
+ *
+ * The buffer collects large blocks of raw data and encodes them
+ * at once by a table-driven kernel.
  */
 class Base64OStream::Buffer : public std::streambuf {
   private:
     std::ostream* decorated;
 
-    int output_raw_width;
-    int output_base64_width;
-    bool output_newline;
-    char* output_buffer;
+    int line_length;
+    int column;
+
+    enum { RAW_SIZE = 3 * 16384 };
+    char raw_buffer[RAW_SIZE];
+    std::vector<char> output_buffer;
 
   public:
     /**
@@ -79,92 +116,134 @@ class Base64OStream::Buffer : public std::streambuf {
     virtual int overflow(
         int c) override;
 
-    void finishData();
+    char* startLine(
+        char* out_);
+    char* encodeTriplets(
+        const std::uint8_t* in_,
+        std::size_t count_,
+        char* out_);
+    void finishData(
+        bool padding_);
 };
 
 
 Base64OStream::Buffer::Buffer(
     std::ostream* decorated_,
     int width_) :
-  decorated(decorated_) {
+  decorated(decorated_),
+  line_length(0),
+  column(0),
+  output_buffer() {
   assert(decorated != nullptr);
 
   /* -- Create output buffer with size according to requested line width. */
+  std::size_t output_size_(RAW_SIZE / 3 * 4 + 4);
   if(width_ > 0) {
     assert(width_ % 4 == 0);
-    output_base64_width = width_;
-    output_newline = true;
-  }
-  else {
-    output_base64_width = 80;
-    output_newline = false;
+    line_length = width_;
+    output_size_ += output_size_ / line_length + 1;
   }
-  output_raw_width = output_base64_width / 4 * 3;
-  output_buffer = new char[output_raw_width];
+  output_buffer.resize(output_size_);
 
   /* -- set the streambuf pointers */
-  setp(output_buffer, output_buffer + output_raw_width);
+  setp(raw_buffer, raw_buffer + RAW_SIZE);
 }
 
 Base64OStream::Buffer::~Buffer() {
-  finishData();
-  delete[] output_buffer;
+  finishData(true);
 }
 
-void Base64OStream::Buffer::finishData() {
-  /* -- compute length of data */
-  auto length_(pptr() - output_buffer);
-  assert(length_ >= 0 && length_ <= output_raw_width);
-
-  /* -- encode the output buffer */
-  static const unsigned char base64_table[] =
-      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-  char buffer_[output_base64_width];
-  const std::uint8_t* in_(reinterpret_cast<std::uint8_t*>(output_buffer));
-  char* out_(buffer_);
-  while(length_ >= 3) {
-    *out_++ = base64_table[in_[0] >> 2];
-    *out_++ = base64_table[((in_[0] & 0x03) << 4) | (in_[1] >> 4)];
-    *out_++ = base64_table[((in_[1] & 0x0f) << 2) | (in_[2] >> 6)];
-    *out_++ = base64_table[in_[2] & 0x3f];
-    length_ -= 3;
-    in_ += 3;
+char* Base64OStream::Buffer::startLine(
+    char* out_) {
+  /* -- The new line is started just before next data. Hence, there is
+   *    no trailing newline at the end of the sequence. */
+  if(line_length > 0 && column == line_length) {
+    *out_++ = '\n';
+    column = 0;
+  }
+  return out_;
+}
+
+char* Base64OStream::Buffer::encodeTriplets(
+    const std::uint8_t* in_,
+    std::size_t count_,
+    char* out_) {
+  const auto& pairs_(getPairTable().pairs);
+  while(count_ > 0) {
+    /* -- encode the rest of current line */
+    out_ = startLine(out_);
+    std::size_t chunk_(count_);
+    if(line_length > 0) {
+      chunk_ = std::min<std::size_t>(chunk_, (line_length - column) / 4);
+      column += static_cast<int>(chunk_ * 4);
+    }
+    count_ -= chunk_;
+
+    for(; chunk_ > 0; --chunk_) {
+      const std::uint32_t triplet_(in_[0] << 16 | in_[1] << 8 | in_[2]);
+      std::memcpy(out_, pairs_[triplet_ >> 12], 2);
+      std::memcpy(out_ + 2, pairs_[triplet_ & 0xfff], 2);
+      out_ += 4;
+      in_ += 3;
+    }
   }
-  if(length_ > 0) {
-    /* -- Padding should happen only if the sequence is closed. Otherwise,
-     *    the data length is divisible by 3. */
+  return out_;
+}
+
+void Base64OStream::Buffer::finishData(
+    bool padding_) {
+  /* -- compute length of data */
+  const std::size_t length_(pptr() - raw_buffer);
+  assert(length_ <= RAW_SIZE);
+
+  /* -- encode complete triplets */
+  const std::uint8_t* in_(reinterpret_cast<const std::uint8_t*>(raw_buffer));
+  char* out_(encodeTriplets(in_, length_ / 3, output_buffer.data()));
+
+  /* -- pad the rest of the sequence */
+  const std::size_t rest_(length_ % 3);
+  in_ += length_ - rest_;
+  if(rest_ > 0 && padding_) {
+    out_ = startLine(out_);
     *out_++ = base64_table[in_[0] >> 2];
-    if(length_ == 1) {
-        *out_++ = base64_table[(in_[0] & 0x03) << 4];
-        *out_++ = '=';
+    if(rest_ == 1) {
+      *out_++ = base64_table[(in_[0] & 0x03) << 4];
+      *out_++ = '=';
     }
     else {
-        *out_++ = base64_table[((in_[0] & 0x03) << 4) | (in_[1] >> 4)];
-        *out_++ = base64_table[(in_[1] & 0x0f) << 2];
+      *out_++ = base64_table[((in_[0] & 0x03) << 4) | (in_[1] >> 4)];
+      *out_++ = base64_table[(in_[1] & 0x0f) << 2];
     }
     *out_++ = '=';
   }
 
-  /* -- reset the buffer pointers */
-  setp(output_buffer, output_buffer + output_raw_width);
+  /* -- reset the buffer pointers. The incomplete triplet is kept
+   *    if the sequence is not finished. */
+  if(padding_) {
+    column = 0;   /* -- next sequence starts its own line */
+    setp(raw_buffer, raw_buffer + RAW_SIZE);
+  }
+  else {
+    std::memmove(raw_buffer, in_, rest_);
+    setp(raw_buffer, raw_buffer + RAW_SIZE);
+    pbump(static_cast<int>(rest_));
+  }
 
   /* -- push the encoded data into the decorated stream buffer */
-  auto coded_length_(out_ - buffer_);
-  decorated->write(buffer_, static_cast<std::streamsize>(coded_length_));
+  const auto coded_length_(out_ - output_buffer.data());
+  if(coded_length_ > 0)
+    decorated->write(
+        output_buffer.data(), static_cast<std::streamsize>(coded_length_));
 }
 
 int Base64OStream::Buffer::overflow(
     int c) {
   /* -- flush current data */
-  finishData();
-
-  /* -- start new line if it's requested */
-  if(output_newline)
-    decorated->put('\n');
+  finishData(false);
 
   /* -- write the character */
   if(c != traits_type::eof()) {
-    *output_buffer = traits_type::to_char_type(c);
+    *pptr() = traits_type::to_char_type(c);
     pbump(1);
   }
 
@@ -172,7 +251,7 @@ int Base64OStream::Buffer::overflow(
 }
 
 bool Base64OStream::Buffer::finish() noexcept {
-  finishData();
+  finishData(true);
   return true;
 }
 
@@ -0,0 +1,199 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark.h>
+
+#include <algorithm>
+#include <assert.h>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include <benchmarkresult.h>
+#include <const.h>
+#include <context.h>
+#include <reporter.h>
+#include <utils.h>
+
+namespace OTest2 {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/* -- limits of the scaling of the iterations in one step */
+constexpr double MAX_SCALE(100.0);
+constexpr double SCALE_RESERVE(1.2);
+
+double computeMedian(
+    const std::vector<double>& sorted_) {
+  const std::size_t middle_(sorted_.size() / 2);
+  if(sorted_.size() % 2 == 0)
+    return (sorted_[middle_ - 1] + sorted_[middle_]) / 2.0;
+  else
+    return sorted_[middle_];
+}
+
+} /* -- namespace */
+
+struct Benchmark::Impl {
+    const Context* context;
+    bool warming;
+    std::uint64_t iterations;
+    Clock::time_point start;
+    Clock::duration warm_up;
+    std::vector<double> samples;
+
+    /* -- avoid copying */
+    Impl(
+        const Impl&) = delete;
+    Impl& operator = (
+        const Impl&) = delete;
+
+    explicit Impl(
+        const Context& context_);
+    ~Impl() = default;
+
+    void calibrate(
+        Clock::duration elapsed_);
+};
+
+Benchmark::Impl::Impl(
+    const Context& context_) :
+  context(&context_),
+  warming(true),
+  iterations(0),
+  start(),
+  warm_up(Clock::duration::zero()),
+  samples() {
+
+}
+
+void Benchmark::Impl::calibrate(
+    Clock::duration elapsed_) {
+  const Clock::duration sample_time_ =
+      std::chrono::milliseconds(BENCHMARK_SAMPLE_TIME);
+  const Clock::duration warm_up_time_ =
+      std::chrono::milliseconds(BENCHMARK_WARM_UP_TIME);
+
+  /* -- Scale the iterations to fill the sample time. The scale is
+   *    limited as a too short sample is not reliable. */
+  double scale_(MAX_SCALE);
+  if(elapsed_ > Clock::duration::zero()) {
+    scale_ = static_cast<double>(sample_time_.count())
+        / static_cast<double>(elapsed_.count());
+    if(elapsed_ < sample_time_)
+      scale_ = std::min(scale_ * SCALE_RESERVE, MAX_SCALE);
+  }
+  const double scaled_(std::ceil(iterations * scale_));
+  if(elapsed_ < sample_time_)
+    iterations = std::max(iterations + 1, static_cast<std::uint64_t>(scaled_));
+
+  /* -- start the measurement when the body is warm and the sample
+   *    is long enough */
+  if(warm_up >= warm_up_time_ && elapsed_ >= sample_time_) {
+    iterations = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(scaled_));
+    warming = false;
+  }
+}
+
+Benchmark::Benchmark(
+    const Context& context_) :
+  pimpl(new Impl(context_)) {
+
+}
+
+Benchmark::~Benchmark() {
+  odelete(pimpl);
+}
+
+bool Benchmark::nextSample() {
+  const Clock::time_point now_(Clock::now());
+
+  if(pimpl->iterations == 0) {
+    /* -- the first sample */
+    pimpl->iterations = 1;
+  }
+  else {
+    const Clock::duration elapsed_(now_ - pimpl->start);
+    if(pimpl->warming) {
+      pimpl->warm_up += elapsed_;
+      pimpl->calibrate(elapsed_);
+    }
+    else {
+      pimpl->samples.push_back(
+          std::chrono::duration<double, std::nano>(elapsed_).count()
+          / pimpl->iterations);
+      if(pimpl->samples.size() >= static_cast<std::size_t>(BENCHMARK_SAMPLES))
+        return false;
+    }
+  }
+
+  /* -- start the next sample as late as possible */
+  pimpl->start = Clock::now();
+  return true;
+}
+
+std::uint64_t Benchmark::getIterations() const noexcept {
+  return pimpl->iterations;
+}
+
+BenchmarkResult Benchmark::getResult() const {
+  std::vector<double> samples_(pimpl->samples);
+  assert(!samples_.empty());
+  std::sort(samples_.begin(), samples_.end());
+
+  BenchmarkResult result_;
+  result_.iterations = pimpl->iterations;
+  result_.samples = static_cast<int>(samples_.size());
+  result_.median = computeMedian(samples_);
+
+  double sum_(0.0);
+  for(double sample_ : samples_)
+    sum_ += sample_;
+  result_.mean = sum_ / samples_.size();
+
+  double squares_(0.0);
+  for(double sample_ : samples_)
+    squares_ += (sample_ - result_.mean) * (sample_ - result_.mean);
+  if(samples_.size() > 1)
+    result_.stddev = std::sqrt(squares_ / (samples_.size() - 1));
+  else
+    result_.stddev = 0.0;
+
+  result_.min = samples_.front();
+  result_.max = samples_.back();
+
+  std::vector<double> deviations_;
+  deviations_.reserve(samples_.size());
+  for(double sample_ : samples_)
+    deviations_.push_back(std::abs(sample_ - result_.median));
+  std::sort(deviations_.begin(), deviations_.end());
+  result_.mad = computeMedian(deviations_);
+
+  return result_;
+}
+
+void Benchmark::report() {
+  if(pimpl->samples.empty())
+    return;
+  pimpl->context->reporter->reportBenchmark(*pimpl->context, getResult());
+}
+
+} /* -- namespace OTest2 */
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <benchmarkresult.h>
+
+namespace OTest2 {
+
+double BenchmarkResult::getThroughput() const noexcept {
+  if(median > 0.0)
+    return 1.0e9 / median;
+  else
+    return 0.0;
+}
+
+double BenchmarkResult::getVariation() const noexcept {
+  if(mean > 0.0)
+    return stddev / mean;
+  else
+    return 0.0;
+}
+
+} /* -- namespace OTest2 */
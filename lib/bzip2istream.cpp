@@ -86,7 +86,8 @@ int Bzip2IStream::Buffer::underflow() {
     std::memmove(ibuffer, bzip_stream.next_in, bzip_stream.avail_in);
 
     /* -- read next data from the decorated stream */
-    decorated->read(ibuffer, BUFFER_SIZE - bzip_stream.avail_in);
+    decorated->read(
+        ibuffer + bzip_stream.avail_in, BUFFER_SIZE - bzip_stream.avail_in);
     auto read_bytes_(decorated->gcount());
     if(read_bytes_ <= 0 && bzip_stream.avail_in == 0) {
       eof = true;
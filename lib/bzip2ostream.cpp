@@ -78,7 +78,9 @@ void Bzip2OStream::Buffer::finish(
   /* -- get size of already written data */
   unsigned int data_size_(static_cast<unsigned int>(pptr() - buffer));
   assert(data_size_ <= BUFFER_SIZE);
-  if(data_size_ == 0) /* -- nothing to do */
+  if(data_size_ == 0
+      && bzip_stream.total_in_lo32 == 0
+      && bzip_stream.total_in_hi32 == 0) /* -- nothing to do */
     return;
 
   /* -- prepare input buffer */
@@ -116,25 +118,25 @@ int Bzip2OStream::Buffer::overflow(
     int c_) {
   assert(pptr() - buffer == BUFFER_SIZE);
 
-  /* -- compress data */
+  /* -- Compress data. The compressor may produce more output than
+   *    the output buffer can keep (when a bzip block is finished), so
+   *    the compression is repeated until all the input is consumed. */
   char obuffer_[BUFFER_SIZE];
   bzip_stream.next_in = buffer;
   bzip_stream.avail_in = BUFFER_SIZE;
-  bzip_stream.next_out = obuffer_;
-  bzip_stream.avail_out = BUFFER_SIZE;
-  auto info_(BZ2_bzCompress(&bzip_stream, BZ_RUN));
-  assert(info_ == BZ_RUN_OK);
-  assert(bzip_stream.avail_in < BUFFER_SIZE); /* -- at least 1 B in the buffer */
-
-  /* -- push compressed data into the decorated stream */
-  decorated->write(obuffer_, BUFFER_SIZE - bzip_stream.avail_out);
+  do {
+    bzip_stream.next_out = obuffer_;
+    bzip_stream.avail_out = BUFFER_SIZE;
+    auto info_(BZ2_bzCompress(&bzip_stream, BZ_RUN));
+    assert(info_ == BZ_RUN_OK);
 
-  /* -- move remaining input data at the beginning of the buffer */
-  std::memmove(buffer, bzip_stream.next_in, bzip_stream.avail_in);
+    /* -- push compressed data into the decorated stream */
+    decorated->write(obuffer_, BUFFER_SIZE - bzip_stream.avail_out);
+  }
+  while(bzip_stream.avail_in > 0);
 
   /* -- reset the stream buffer pointers */
   setp(buffer, buffer + BUFFER_SIZE);
-  pbump(bzip_stream.avail_in);
 
   /* -- write next character */
   if(c_ != traits_type::eof()) {
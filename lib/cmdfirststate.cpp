@@ -45,7 +45,8 @@ void CmdFirstState::run(
     const Context& context_) {
   StatePtr state_(testcase->getFirstState());
   if(state_ != nullptr) {
-    state_->scheduleRun(context_, testcase, state_, false, -1);
+    state_->scheduleRun(
+        context_, testcase, state_, false, -1, WaitSources());
   }
   else {
     internalError(context_, "there is not set any entering state");
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmdforkobject.h>
+
+#include <assert.h>
+#include <memory>
+#include <utility>
+
+#include <cmdjoinobject.h>
+#include <cmdrepeatobject.h>
+#include <commandstack.h>
+#include <context.h>
+#include "forkedchild.h"
+#include <objectrepeater.h>
+#include <scenario.h>
+#include <scenarioiter.h>
+
+namespace OTest2 {
+
+CmdForkObject::CmdForkObject(
+    ScenarioIterPtr scenario_iter_,
+    ObjectPtr parent_) :
+  scenario_iter(scenario_iter_),
+  parent(parent_) {
+  assert(scenario_iter != nullptr);
+
+}
+
+CmdForkObject::~CmdForkObject() {
+
+}
+
+void CmdForkObject::run(
+    const Context& context_) {
+  if(!scenario_iter->isValid())
+    return;
+
+  /* -- get the pointed scenario object and schedule the next one */
+  ScenarioPtr object_scenario_(scenario_iter->getScenario());
+  scenario_iter->next();
+  context_.command_stack->pushCommand(
+      std::make_shared<CmdForkObject>(scenario_iter, parent));
+
+  /* -- run the object in the child process */
+  std::unique_ptr<ForkedChild> child_(ForkedChild::forkChild(
+      context_,
+      [this, object_scenario_](const Context& forked_context_) {
+        auto repeater_(object_scenario_->createRepeater(forked_context_));
+        forked_context_.command_stack->pushCommand(
+            std::make_shared<CmdRepeatObject>(
+                object_scenario_, repeater_.second, repeater_.first, parent));
+      }));
+  if(child_ == nullptr)
+    return;
+
+  /* -- wait for the report of the child */
+  context_.command_stack->pushCommand(
+      std::make_shared<CmdJoinObject>(std::move(child_)));
+}
+
+} /* -- namespace OTest2 */
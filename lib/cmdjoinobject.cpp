@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmdjoinobject.h>
+
+#include <assert.h>
+#include <utility>
+
+#include <commandstack.h>
+#include <context.h>
+#include "forkedchild.h"
+#include <waitsource.h>
+
+namespace OTest2 {
+
+namespace {
+
+/* -- The timeout is just a safety net, the pipe is closed when
+ *    the child finishes. */
+constexpr int JOIN_TIMEOUT(1000);
+
+} /* -- namespace */
+
+CmdJoinObject::CmdJoinObject(
+    std::unique_ptr<ForkedChild>&& child_) :
+  child(std::move(child_)) {
+  assert(child != nullptr);
+
+}
+
+CmdJoinObject::~CmdJoinObject() {
+
+}
+
+bool CmdJoinObject::shouldWait(
+    const Context& context_,
+    int& delay_,
+    WaitSources& wait_sources_) {
+  delay_ = JOIN_TIMEOUT;
+  child->appendWaitSource(wait_sources_);
+  return true;
+}
+
+void CmdJoinObject::run(
+    const Context& context_) {
+  child->readReport();
+  if(!child->isFinished()) {
+    /* -- wait for next data */
+    context_.command_stack->pushCommand(
+        std::make_shared<CmdJoinObject>(std::move(child)));
+    return;
+  }
+
+  /* -- the child has finished */
+  child->joinChild(context_);
+}
+
+} /* -- namespace OTest2 */
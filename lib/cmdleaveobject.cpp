@@ -20,9 +20,11 @@
 #include <cmdleaveobject.h>
 
 #include <assert.h>
+#include <unistd.h>
 
 #include <context.h>
 #include <objectpath.h>
+#include <reporter.h>
 #include <scenario.h>
 #include <semanticstack.h>
 
@@ -30,7 +32,9 @@ namespace OTest2 {
 
 CmdLeaveObject::CmdLeaveObject(
     ScenarioPtr scenario_) :
-  scenario(scenario_) {
+  scenario(scenario_),
+  start_pid(::getpid()),
+  start_usage(ResourceUsage::sample()) {
   assert(scenario != nullptr);
 
 }
@@ -41,6 +45,27 @@ CmdLeaveObject::~CmdLeaveObject() {
 
 void CmdLeaveObject::run(
     const Context& context_) {
+  /* -- Report consumed resources. The interleaved objects (there is
+   *    a scheduler) share the thread, so their counters would include
+   *    the other objects running meanwhile. Their usage is not reported. */
+  if(context_.scheduler == nullptr) {
+    /* -- If the object has run in a forked process, the counters of
+     *    the child have started at zero. Just the memory high-water mark
+     *    and the allocation counters are inherited from the parent. */
+    ResourceUsage start_(start_usage);
+    if(::getpid() != start_pid) {
+      start_.cpu_time = 0;
+      start_.user_time = 0;
+      start_.system_time = 0;
+      start_.minor_faults = 0;
+      start_.major_faults = 0;
+      start_.voluntary_switches = 0;
+      start_.involuntary_switches = 0;
+    }
+    context_.reporter->reportResourceUsage(
+        context_, ResourceUsage::sample() - start_);
+  }
+
   /* -- report finishing of the object */
   scenario->leaveObject(context_);
 
@@ -19,11 +19,16 @@
 #include <cmdrepeatobject.h>
 
 #include <assert.h>
+#include <memory>
+#include <utility>
 
+#include <cmdjoinobject.h>
 #include <cmdleaveobject.h>
+#include <cmdrepeatparallel.h>
 #include <cmdstartupobject.h>
 #include <commandstack.h>
 #include <context.h>
+#include "forkedchild.h"
 #include <objectscenario.h>
 #include <objectpath.h>
 #include <objectrepeater.h>
@@ -52,6 +57,25 @@ CmdRepeatObject::~CmdRepeatObject() {
 
 void CmdRepeatObject::run(
     const Context& context_) {
+  if(scenario->parallelRuns()) {
+    /* -- The runs are independent, run them at once. A run is created
+     *    by the constructor of the object which moves the repeater too.
+     *    Hence, the runs are created in a forked spawning process and
+     *    no user code of the runs is executed in this process. */
+    std::unique_ptr<ForkedChild> spawner_(ForkedChild::forkChild(
+        context_,
+        [this](const Context& forked_context_) {
+          forked_context_.command_stack->pushCommand(
+              std::make_shared<CmdRepeatParallel>(
+                  scenario, repeater, name, parent));
+        }));
+    if(spawner_ != nullptr) {
+      context_.command_stack->pushCommand(
+          std::make_shared<CmdJoinObject>(std::move(spawner_)));
+    }
+    return;
+  }
+
   if(repeater->hasNextRun(context_)) {
     /* -- schedule myself for next run */
     context_.command_stack->pushCommand(
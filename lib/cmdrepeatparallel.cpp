@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cmdrepeatparallel.h>
+
+#include <assert.h>
+#include <unistd.h>
+#include <utility>
+
+#include <cmdleaveobject.h>
+#include <cmdstartupobject.h>
+#include <commandstack.h>
+#include <context.h>
+#include "forkedchild.h"
+#include <objectpath.h>
+#include <objectrepeater.h>
+#include <objectscenario.h>
+#include "runcode.h"
+#include <scenario.h>
+#include <semanticstack.h>
+#include <waitsource.h>
+
+namespace OTest2 {
+
+namespace {
+
+/* -- The timeout is just a safety net, the pipes are closed when
+ *    the children finish. */
+constexpr int JOIN_TIMEOUT(1000);
+
+std::size_t parallelWorkers() {
+  const long cpus_(::sysconf(_SC_NPROCESSORS_ONLN));
+  return cpus_ > 0 ? static_cast<std::size_t>(cpus_) : 1;
+}
+
+} /* -- namespace */
+
+CmdRepeatParallel::CmdRepeatParallel(
+    ScenarioPtr scenario_,
+    ObjectRepeaterPtr repeater_,
+    const std::string& name_,
+    ObjectPtr parent_) :
+  CmdRepeatParallel(scenario_, repeater_, name_, parent_, Children(), true) {
+
+}
+
+CmdRepeatParallel::CmdRepeatParallel(
+    ScenarioPtr scenario_,
+    ObjectRepeaterPtr repeater_,
+    const std::string& name_,
+    ObjectPtr parent_,
+    Children&& children_,
+    bool spawning_) :
+  scenario(scenario_),
+  repeater(repeater_),
+  name(name_),
+  parent(parent_),
+  children(std::move(children_)),
+  spawning(spawning_) {
+  assert(scenario != nullptr && repeater != nullptr && !name.empty());
+
+}
+
+CmdRepeatParallel::~CmdRepeatParallel() {
+
+}
+
+void CmdRepeatParallel::spawnRun(
+    const Context& context_) {
+  /* -- The run is created in this (spawning) process as the repeater must
+   *    move to the next run. The forked process just executes it. */
+  std::unique_ptr<ForkedChild> child_(ForkedChild::forkChild(
+      context_,
+      [this](const Context& run_context_) {
+        /* -- prepare stack-frame of the object - object's result and path. */
+        run_context_.object_path->pushName(name);
+        run_context_.semantic_stack->push(true);
+
+        /* -- let the repeater to distinguish the run */
+        repeater->modifyObjectPath(run_context_, *run_context_.object_path);
+
+        /* -- report the object and schedule its finishing */
+        scenario->enterObject(run_context_);
+        run_context_.command_stack->pushCommand(
+            std::make_shared<CmdLeaveObject>(scenario));
+
+        runUserCode(run_context_, [this](const Context& run_context_) {
+          ObjectScenarioPtr object_(
+              repeater->createObject(run_context_, name, parent));
+          run_context_.command_stack->pushCommand(
+              std::make_shared<CmdStartUpObject>(object_, scenario, parent, 0));
+        });
+      },
+      true));
+
+  if(child_ != nullptr)
+    children.push_back(std::move(child_));
+  else
+    spawning = false;  /* -- the failure has been already reported */
+}
+
+bool CmdRepeatParallel::shouldWait(
+    const Context& context_,
+    int& delay_,
+    WaitSources& wait_sources_) {
+  if(children.empty())
+    return false;
+
+  delay_ = JOIN_TIMEOUT;
+  for(const auto& child_ : children)
+    child_->appendWaitSource(wait_sources_);
+  return true;
+}
+
+void CmdRepeatParallel::run(
+    const Context& context_) {
+  /* -- Read data of all running children, so they are not blocked
+   *    by full pipes. Any finished child is reaped at once to free its
+   *    worker. Its report is kept until the previous runs are passed as
+   *    the reports are passed in the order of the runs. */
+  std::size_t running_(0);
+  for(auto& child_ : children) {
+    child_->readReport();
+    if(child_->isFinished())
+      child_->reapChild();
+    else
+      ++running_;
+  }
+  while(!children.empty() && children.front()->isReaped()) {
+    children.front()->joinChild(context_);
+    children.pop_front();
+  }
+
+  /* -- start next runs */
+  const std::size_t workers_(parallelWorkers());
+  while(spawning
+      && running_ < workers_
+      && repeater->hasNextRun(context_)) {
+    spawnRun(context_);
+    ++running_;
+  }
+
+  /* -- wait for the running children */
+  if(!children.empty()) {
+    context_.command_stack->pushCommand(
+        std::make_shared<CmdRepeatParallel>(
+            scenario,
+            repeater,
+            name,
+            parent,
+            std::move(children),
+            spawning));
+  }
+}
+
+} /* -- namespace OTest2 */
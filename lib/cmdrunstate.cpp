@@ -35,11 +35,15 @@ CmdRunState::CmdRunState(
     CaseOrdinaryPtr parent_,
     StateOrdinaryPtr state_,
     bool wait_before_,
-    int delay_) :
+    int delay_,
+    const WaitSources& wait_sources_,
+    bool resume_) :
   parent(parent_),
   state(state_),
   wait_before(wait_before_),
-  delay(delay_) {
+  delay(delay_),
+  wait_sources(wait_sources_),
+  resume(resume_) {
   assert(parent != nullptr && state != nullptr && (!wait_before || delay >= 0));
 
 }
@@ -50,9 +54,11 @@ CmdRunState::~CmdRunState() {
 
 bool CmdRunState::shouldWait(
     const Context& context_,
-    int& delay_) {
+    int& delay_,
+    WaitSources& wait_sources_) {
   if(wait_before) {
     delay_ = delay;
+    wait_sources_ = wait_sources;
     return true;
   }
   else
@@ -61,17 +67,24 @@ bool CmdRunState::shouldWait(
 
 void CmdRunState::run(
     const Context& context_) {
-  /* -- report the state entrance */
-  context_.reporter->enterState(context_, state->getName());
+  /* -- Report the state entrance and prepare the return value of the state.
+   *    A resumed state has already done it - its return value is kept
+   *    on the semantic stack while the state is suspended. */
+  if(!resume) {
+    context_.reporter->enterState(context_, state->getName());
+    context_.semantic_stack->push(true);
+  }
 
   /* -- Prepare a dummy command. The test state can replace it by
    *    a command switching another state. */
   context_.command_stack->pushCommand(std::make_shared<CmdDummy>());
-  /* -- prepare the return value of the state */
-  context_.semantic_stack->push(true);
   /* -- execute the state */
   state->executeState(context_, parent);
 
+  /* -- the suspended state is left when it finishes */
+  if(state->isSuspended())
+    return;
+
   /* -- report end of the state */
   context_.reporter->leaveState(
       context_, state->getName(), context_.semantic_stack->top());
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <cmdspawnobjects.h>
+
+#include <assert.h>
+#include <memory>
+
+#include <cmdrepeatobject.h>
+#include <commandstack.h>
+#include <context.h>
+#include <objectrepeater.h>
+#include <scenario.h>
+#include <scenarioiter.h>
+#include <scheduler.h>
+
+namespace OTest2 {
+
+CmdSpawnObjects::CmdSpawnObjects(
+    ScenarioIterPtr scenario_iter_,
+    ObjectPtr parent_) :
+  scenario_iter(scenario_iter_),
+  parent(parent_) {
+  assert(scenario_iter != nullptr);
+
+}
+
+CmdSpawnObjects::~CmdSpawnObjects() {
+
+}
+
+void CmdSpawnObjects::run(
+    const Context& context_) {
+  assert(context_.scheduler != nullptr);
+
+  for(; scenario_iter->isValid(); scenario_iter->next()) {
+    ScenarioPtr object_scenario_(scenario_iter->getScenario());
+
+    /* -- The object runs in its own context. The repeater is created
+     *    there as the repeated runs belong to the object. */
+    const Context& object_context_(context_.scheduler->spawnObject(context_));
+    auto repeater_(object_scenario_->createRepeater(object_context_));
+    object_context_.command_stack->pushCommand(
+        std::make_shared<CmdRepeatObject>(
+            object_scenario_, repeater_.second, repeater_.first, parent));
+  }
+
+  /* -- wait for the spawned objects */
+  context_.scheduler->joinObjects(context_);
+}
+
+} /* -- namespace OTest2 */
@@ -27,7 +27,9 @@
 #include <commandstack.h>
 #include <context.h>
 #include <objectscenario.h>
+#include <reporter.h>
 #include <semanticstack.h>
+#include <timesource.h>
 
 namespace OTest2 {
 
@@ -49,7 +51,10 @@ CmdStartUpObject::~CmdStartUpObject() {
 
 void CmdStartUpObject::run(
     const Context& context_) {
+  const TimeSource::time_point begin_(context_.time_source->now());
   if(object->startUpObject(context_, index)) {
+    context_.reporter->reportFixture(context_, true, index, begin_);
+
     /* -- check result of the start-up function */
     if(context_.semantic_stack->top()) {
       /* -- the start-up function passed -> schedule next start-up function */
@@ -33,10 +33,12 @@ namespace OTest2 {
 CmdState::CmdState(
     CaseOrdinaryPtr testcase_,
     const std::string& name_,
-    int delay_) :
+    int delay_,
+    const WaitSources& wait_sources_) :
   testcase(testcase_),
   name(name_),
-  delay(delay_) {
+  delay(delay_),
+  wait_sources(wait_sources_) {
   assert(testcase != nullptr && !name_.empty() && delay_ >= 0);
 
 }
@@ -49,7 +51,8 @@ void CmdState::run(
     const Context& context_) {
   StatePtr state_(testcase->getState(name));
   if(state_ != nullptr) {
-    state_->scheduleRun(context_, testcase, state_, true, delay);
+    state_->scheduleRun(
+        context_, testcase, state_, true, delay, wait_sources);
   }
   else {
     std::ostringstream os_;
@@ -25,6 +25,8 @@
 #include <commandstack.h>
 #include <context.h>
 #include <objectscenario.h>
+#include <reporter.h>
+#include <timesource.h>
 
 namespace OTest2 {
 
@@ -46,7 +48,9 @@ CmdTearDownObject::~CmdTearDownObject() {
 void CmdTearDownObject::run(
     const Context& context_) {
   /* -- run the tear-down function */
+  const TimeSource::time_point begin_(context_.time_source->now());
   object->tearDownObject(context_, index);
+  context_.reporter->reportFixture(context_, false, index, begin_);
 
   /* -- schedule next tear-down function or finish the suite */
   if(index > 0)
@@ -31,7 +31,8 @@ Command::~Command() {
 
 bool Command::shouldWait(
     const Context& context_,
-    int& delay_) {
+    int& delay_,
+    WaitSources& wait_sources_) {
   return false;
 }
 
@@ -30,7 +30,8 @@ Context::Context(
     Reporter* reporter_,
     TestMarkFactory* test_mark_factory_,
     TestMarkStorage* test_mark_storage_,
-    UserData* user_data_) :
+    UserData* user_data_,
+    Scheduler* scheduler_) :
   command_stack(command_stack_),
   semantic_stack(semantic_stack_),
   object_path(object_path_),
@@ -39,7 +40,8 @@ Context::Context(
   reporter(reporter_),
   test_mark_factory(test_mark_factory_),
   test_mark_storage(test_mark_storage_),
-  user_data(user_data_) {
+  user_data(user_data_),
+  scheduler(scheduler_) {
 
 }
 
@@ -31,13 +31,16 @@
 #include <reporterconsole.h>
 #include <reporterjunit.h>
 #include <reportertee.h>
+#include <reportertrace.h>
 #include <runnerfilteruntagged.h>
 #include <runnerfiltertags.h>
+#include <runnerinterleaved.h>
 #include <runnerordinary.h>
 #include <scenarioiterptr.h>
 #include <testmarkfactory.h>
 #include <testmarkstorage.h>
 #include <timesourcesys.h>
+#include <timesourcevirtual.h>
 #include <userdata.h>
 #include <utils.h>
 
@@ -56,9 +59,14 @@ void printHelpMessage(
   std::cout << "           --disable-console  Disable reporting into the console." << std::endl;
   std::cout << "  -v       --verbose          Make the console reporter verbose. This option" << std::endl;
   std::cout << "                              turns on printing of results of passed tests." << std::endl;
+  std::cout << "                              The most expensive test cases are listed" << std::endl;
+  std::cout << "                              at the end." << std::endl;
   std::cout << "  -j file  --junit=file       Print report into a file in the JUnit XML format." << std::endl;
   std::cout << "                              This option may be used several times. Several" << std::endl;
   std::cout << "                              files will then be written." << std::endl;
+  std::cout << "           --trace=file       Write a timeline of the test into a file in the" << std::endl;
+  std::cout << "                              Chrome trace-event format. The file can be loaded" << std::endl;
+  std::cout << "                              into chrome://tracing or into the Perfetto UI." << std::endl;
   std::cout << "  -r glob  --restrictive=glob Run just test object which match the tag glob." << std::endl;
   std::cout << "                              The default value runs all untagged objects." << std::endl;
   std::cout << "  -m file  --regression=file  Path of the regression file. The default value" << std::endl;
@@ -66,6 +74,10 @@ void printHelpMessage(
   std::cout << "                              directory)." << std::endl;
   std::cout << "  -t name  --test=name        Name of the test how it's reported. The default" << std::endl;
   std::cout << "                              value is the name of the test's binary." << std::endl;
+  std::cout << "           --virtual-time     Skip delays of the test states. The time seen" << std::endl;
+  std::cout << "                              by the tests is moved forward instead of waiting." << std::endl;
+  std::cout << "           --interleave       Interleave the suites and the cases. When a test" << std::endl;
+  std::cout << "                              case waits, other cases run meanwhile." << std::endl;
   std::cout << std::endl;
 }
 
@@ -85,6 +97,7 @@ std::string createDefaultTestName(
 struct DfltEnvironment::Impl {
     /* -- the environment */
     TimeSourceSys time_source;
+    TimeSourceVirtual virtual_time;
     ExcCatcherOrdinary exc_catcher_ordinary;
     ExcCatcher* exc_catcher;
     std::vector<std::unique_ptr<Reporter>> reporters;
@@ -98,6 +111,8 @@ struct DfltEnvironment::Impl {
     /* -- builder state */
     bool console_reporter;
     bool console_verbose;
+    bool use_virtual_time;
+    bool interleave;
     std::string regression_file;
     std::string test_name;
 
@@ -108,6 +123,7 @@ struct DfltEnvironment::Impl {
 DfltEnvironment::Impl::Impl(
     const std::string& test_name_) :
   time_source(),
+  virtual_time(),
   exc_catcher_ordinary(),
   exc_catcher(nullptr),
   reporters(),
@@ -119,6 +135,8 @@ DfltEnvironment::Impl::Impl(
   runner(),
   console_reporter(true),
   console_verbose(false),
+  use_virtual_time(false),
+  interleave(false),
   regression_file("regression.ot2tm"),
   test_name(test_name_) {
 
@@ -139,18 +157,24 @@ DfltEnvironment::DfltEnvironment(
     DISABLE_CONSOLE_REPORTER = 1000,
     VERBOSE_CONSOLE,
     JUNIT_REPORTER,
+    TRACE_REPORTER,
     RESTRICTIVE_RUN,
     REGRESSION_FILE,
     TEST_NAME,
+    VIRTUAL_TIME,
+    INTERLEAVE,
     HELP,
   };
   struct option long_options_[] = {
       {"disable-console", 0, nullptr, DISABLE_CONSOLE_REPORTER},
       {"verbose", 0, nullptr, VERBOSE_CONSOLE},
       {"junit", 1, nullptr, JUNIT_REPORTER},
+      {"trace", 1, nullptr, TRACE_REPORTER},
       {"restrictive", 1, nullptr, RESTRICTIVE_RUN},
       {"regression", 1, nullptr, REGRESSION_FILE},
       {"test", 1, nullptr, TEST_NAME},
+      {"virtual-time", 0, nullptr, VIRTUAL_TIME},
+      {"interleave", 0, nullptr, INTERLEAVE},
       {"help", 0, nullptr, HELP},
       {nullptr, 0, nullptr, 0},
   };
@@ -166,7 +190,11 @@ DfltEnvironment::DfltEnvironment(
         break;
       case 'j':
       case JUNIT_REPORTER:
-        pimpl->reporters.emplace_back(new ReporterJUnit(optarg, false));
+        pimpl->reporters.emplace_back(new ReporterJUnit(optarg, false, true));
+        pimpl->reporter_root.appendReporter(pimpl->reporters.back().get());
+        break;
+      case TRACE_REPORTER:
+        pimpl->reporters.emplace_back(new ReporterTrace(optarg, false, true));
         pimpl->reporter_root.appendReporter(pimpl->reporters.back().get());
         break;
       case 'r':
@@ -187,6 +215,12 @@ DfltEnvironment::DfltEnvironment(
       case TEST_NAME:
         pimpl->test_name = optarg;
         break;
+      case VIRTUAL_TIME:
+        pimpl->use_virtual_time = true;
+        break;
+      case INTERLEAVE:
+        pimpl->interleave = true;
+        break;
       case 'h':
       case HELP:
         printHelpMessage(argv_[0]);
@@ -220,6 +254,18 @@ void DfltEnvironment::setExceptionCatcher(
   pimpl->exc_catcher = catcher_;
 }
 
+void DfltEnvironment::enableVirtualTime() {
+  assert(pimpl->runner == nullptr);
+
+  pimpl->use_virtual_time = true;
+}
+
+void DfltEnvironment::enableInterleaving() {
+  assert(pimpl->runner == nullptr);
+
+  pimpl->interleave = true;
+}
+
 UserData& DfltEnvironment::getUserData() noexcept {
   return pimpl->user_data;
 }
@@ -249,15 +295,30 @@ Runner& DfltEnvironment::getRunner() {
     const Registry& registry_(Registry::instance("default"));
     ScenarioIterPtr scenario_(registry_.getTests(*pimpl->filter));
 
+    /* -- choose the source of time */
+    TimeSource* time_source_(&pimpl->time_source);
+    if(pimpl->use_virtual_time)
+      time_source_ = &pimpl->virtual_time;
+
     /* -- finally, create the test runner */
-    pimpl->runner.reset(new RunnerOrdinary(
-        &pimpl->time_source,
-        pimpl->exc_catcher,
-        &pimpl->reporter_root,
-        &pimpl->test_mark_factory,
-        pimpl->test_mark_storage.get(),
-        &pimpl->user_data,
-        scenario_));
+    if(pimpl->interleave)
+      pimpl->runner.reset(new RunnerInterleaved(
+          time_source_,
+          pimpl->exc_catcher,
+          &pimpl->reporter_root,
+          &pimpl->test_mark_factory,
+          pimpl->test_mark_storage.get(),
+          &pimpl->user_data,
+          scenario_));
+    else
+      pimpl->runner.reset(new RunnerOrdinary(
+          time_source_,
+          pimpl->exc_catcher,
+          &pimpl->reporter_root,
+          &pimpl->test_mark_factory,
+          pimpl->test_mark_storage.get(),
+          &pimpl->user_data,
+          scenario_));
   }
   return *pimpl->runner;
 }
@@ -18,15 +18,150 @@
  */
 #include <dfltloop.h>
 
+#include <cerrno>
 #include <chrono>
+#include <cstdint>
+#include <map>
+#include <poll.h>
 #include <thread>
+#include <unistd.h>
+#include <vector>
+#if defined(__linux__)
+#include <sys/epoll.h>
+#endif
 
 #include <runner.h>
+#include <waitsource.h>
 
 namespace OTest2 {
 
+namespace {
+
+#if defined(__linux__)
+
+/**
+ * @brief Waiting for the wait sources by the epoll interface
+ */
+class EventWaiter {
+  private:
+    int epoll_fd;
+
+  public:
+    /* -- avoid copying */
+    EventWaiter(
+        const EventWaiter&) = delete;
+    EventWaiter& operator =(
+        const EventWaiter&) = delete;
+
+    EventWaiter() :
+      epoll_fd(::epoll_create1(EPOLL_CLOEXEC)) {
+
+    }
+
+    ~EventWaiter() {
+      if(epoll_fd >= 0)
+        ::close(epoll_fd);
+    }
+
+    void wait(
+        const std::map<int, int>& sources_,
+        int delay_ms_) {
+      if(epoll_fd < 0) {
+        waitPoll(sources_, delay_ms_);
+        return;
+      }
+
+      /* -- register the descriptors. A descriptor which cannot be polled
+       *    (e.g. a regular file) is always ready. */
+      bool ready_(false);
+      for(const auto& source_ : sources_) {
+        struct epoll_event ev_ = {};
+        ev_.events = toEpoll(source_.second);
+        ev_.data.fd = source_.first;
+        if(::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, source_.first, &ev_) < 0)
+          ready_ = true;
+      }
+
+      /* -- wait for the first event or the timeout */
+      if(!ready_) {
+        const auto deadline_(
+            std::chrono::steady_clock::now()
+            + std::chrono::milliseconds(delay_ms_));
+        int timeout_(delay_ms_);
+        struct epoll_event events_[1];
+        while(::epoll_wait(epoll_fd, events_, 1, timeout_) < 0
+            && errno == EINTR) {
+          const auto rest_(std::chrono::duration_cast<std::chrono::milliseconds>(
+              deadline_ - std::chrono::steady_clock::now()).count());
+          timeout_ = rest_ > 0 ? static_cast<int>(rest_) : 0;
+        }
+      }
+
+      /* -- unregister the descriptors */
+      for(const auto& source_ : sources_)
+        ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, source_.first, nullptr);
+    }
+
+  private:
+    static std::uint32_t toEpoll(
+        int events_) {
+      std::uint32_t mask_(0);
+      if(events_ & WaitSource::READ)
+        mask_ |= EPOLLIN | EPOLLRDHUP;
+      if(events_ & WaitSource::WRITE)
+        mask_ |= EPOLLOUT;
+      return mask_;
+    }
+
+    static void waitPoll(
+        const std::map<int, int>& sources_,
+        int delay_ms_);
+};
+
+#else
+
+/**
+ * @brief Waiting for the wait sources by the poll function
+ */
+class EventWaiter {
+  public:
+    void wait(
+        const std::map<int, int>& sources_,
+        int delay_ms_) {
+      waitPoll(sources_, delay_ms_);
+    }
+
+  private:
+    static void waitPoll(
+        const std::map<int, int>& sources_,
+        int delay_ms_);
+};
+
+#endif
+
+void EventWaiter::waitPoll(
+    const std::map<int, int>& sources_,
+    int delay_ms_) {
+  std::vector<struct pollfd> fds_;
+  fds_.reserve(sources_.size());
+  for(const auto& source_ : sources_) {
+    short events_(0);
+    if(source_.second & WaitSource::READ)
+      events_ |= POLLIN;
+    if(source_.second & WaitSource::WRITE)
+      events_ |= POLLOUT;
+    fds_.push_back({source_.first, events_, 0});
+  }
+  while(::poll(fds_.data(), fds_.size(), delay_ms_) < 0 && errno == EINTR);
+}
+
+} /* -- namespace */
+
 int defaultMainLoop(
     Runner& runner_) {
+  EventWaiter waiter_;
+  std::map<int, int> sources_;
+
   ::OTest2::RunnerResult result_;
   while(true) {
     /* -- do the test step */
@@ -35,9 +170,20 @@ int defaultMainLoop(
       break;
 
     /* -- wait for next step */
-    const std::chrono::milliseconds delay_(result_.getDelayMS());
-    if(delay_ > std::chrono::milliseconds(0))
-      std::this_thread::sleep_for(delay_);
+    const WaitSources& wait_sources_(result_.getWaitSources());
+    if(wait_sources_.empty()) {
+      const std::chrono::milliseconds delay_(result_.getDelayMS());
+      if(delay_ > std::chrono::milliseconds(0))
+        std::this_thread::sleep_for(delay_);
+    }
+    else {
+      /* -- merge events of the same descriptors and wait for the first
+       *    of them. The delay is the timeout. */
+      sources_.clear();
+      for(const auto& source_ : wait_sources_)
+        sources_[source_.getFD()] |= source_.getEvents();
+      waiter_.wait(sources_, result_.getDelayMS());
+    }
   }
 
   if(result_.getResult())
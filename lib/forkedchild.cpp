@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "forkedchild.h"
+
+#include <assert.h>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fcntl.h>
+#include <iostream>
+#include <signal.h>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <utility>
+
+#include <command.h>
+#include <commandstack.h>
+#include <context.h>
+#include <dfltloop.h>
+#include <internalerror.h>
+#include <objectpath.h>
+#include "reporterserial.h"
+#include <runner.h>
+#include <semanticstack.h>
+#include <testmarkstorage.h>
+#include <timesource.h>
+
+namespace OTest2 {
+
+namespace {
+
+/**
+ * @brief Runner of the forked testing object in the child process
+ */
+class ForkedRunner : public Runner {
+  private:
+    const Context* context;
+
+  public:
+    /* -- avoid copying */
+    ForkedRunner(
+        const ForkedRunner&) = delete;
+    ForkedRunner& operator = (
+        const ForkedRunner&) = delete;
+
+    explicit ForkedRunner(
+        const Context& context_) :
+      context(&context_) {
+
+    }
+
+    virtual ~ForkedRunner() = default;
+
+    virtual RunnerResult runNext() override {
+      CommandStack& command_stack_(*context->command_stack);
+      bool first_command_(true);
+      while(!command_stack_.empty()) {
+        CommandPtr cmd_(command_stack_.topCommand());
+
+        /* -- the same waiting as in the ordinary runner */
+        int delay_(0);
+        WaitSources wait_sources_;
+        if(!first_command_
+            && cmd_->shouldWait(*context, delay_, wait_sources_)) {
+          if(!wait_sources_.empty())
+            return RunnerResult(delay_, wait_sources_);
+          if(!context->time_source->fastForward(
+              std::chrono::milliseconds(delay_)))
+            return RunnerResult(true, false, delay_);
+        }
+
+        first_command_ = false;
+        command_stack_.popCommand();
+        cmd_->run(*context);
+      }
+      return RunnerResult(false, context->semantic_stack->top(), -1);
+    }
+};
+
+/**
+ * @brief Context of the testing object running in the child process
+ *
+ * The object gets its own stacks and it reports into the pipe. Other parts
+ * of the context are inherited from the parent.
+ */
+struct ForkedFrame {
+    CommandStack command_stack;
+    SemanticStack semantic_stack;
+    ObjectPath object_path;
+    ReporterSerial reporter;
+    Context context;
+
+    /* -- avoid copying */
+    ForkedFrame(
+        const ForkedFrame&) = delete;
+    ForkedFrame& operator = (
+        const ForkedFrame&) = delete;
+
+    explicit ForkedFrame(
+        const Context& context_,
+        int fd_) :
+      command_stack(),
+      semantic_stack(),
+      object_path(context_.object_path->getCurrentPath()),
+      reporter(fd_),
+      context(
+          &command_stack,
+          &semantic_stack,
+          &object_path,
+          context_.time_source,
+          context_.exception_catcher,
+          &reporter,
+          context_.test_mark_factory,
+          context_.test_mark_storage,
+          context_.user_data,
+          nullptr) {
+      semantic_stack.push(true);
+    }
+};
+
+void flushStreams() {
+  std::cout.flush();
+  std::cerr.flush();
+  std::fflush(nullptr);
+}
+
+int waitForChild(
+    int pid_) {
+  int status_(0);
+  while(::waitpid(pid_, &status_, 0) < 0 && errno == EINTR);
+  return status_;
+}
+
+std::string describeCrash(
+    int status_) {
+  std::ostringstream oss_;
+  oss_ << "the forked testing object has ";
+  if(WIFSIGNALED(status_))
+    oss_ << "been killed by the signal " << WTERMSIG(status_);
+  else if(WIFEXITED(status_))
+    oss_ << "exited with the status " << WEXITSTATUS(status_);
+  else
+    oss_ << "crashed";
+  oss_ << " before it finished";
+  return oss_.str();
+}
+
+} /* -- namespace */
+
+ForkedChild::ForkedChild(
+    int pid_,
+    int fd_) :
+  pid(pid_),
+  fd(fd_),
+  report(),
+  status(0),
+  reaped(false),
+  joined(false) {
+  assert(pid > 0 && fd >= 0);
+
+}
+
+ForkedChild::~ForkedChild() {
+  if(fd >= 0)
+    ::close(fd);
+
+  /* -- the test has been abandoned, don't leave the child running */
+  if(!reaped) {
+    ::kill(pid, SIGKILL);
+    waitForChild(pid);
+  }
+}
+
+std::unique_ptr<ForkedChild> ForkedChild::forkChild(
+    const Context& context_,
+    std::function<void(const Context&)> prepare_,
+    bool prepare_before_fork_) {
+  int fds_[2];
+  if(::pipe(fds_) < 0) {
+    internalError(context_, "cannot create a pipe of a forked testing object");
+    return nullptr;
+  }
+
+  std::unique_ptr<ForkedFrame> frame_(new ForkedFrame(context_, fds_[1]));
+  const Context& forked_context_(frame_->context);
+  if(prepare_before_fork_)
+    prepare_(forked_context_);
+
+  /* -- The buffered output would be printed by both processes */
+  flushStreams();
+  const pid_t pid_(::fork());
+  if(pid_ < 0) {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+    internalError(context_, "cannot fork a testing object");
+    return nullptr;
+  }
+
+  if(pid_ == 0) {
+    /* -- the child process */
+    ::close(fds_[0]);
+    if(forked_context_.test_mark_storage != nullptr)
+      forked_context_.test_mark_storage->setReadOnly();
+    try {
+      if(!prepare_before_fork_)
+        prepare_(forked_context_);
+      ForkedRunner runner_(forked_context_);
+      defaultMainLoop(runner_);
+    }
+    catch(const std::exception& exc_) {
+      /* -- The report stays truncated. The parent finishes it. */
+      internalError(
+          forked_context_,
+          std::string("the forked testing object has failed: ") + exc_.what());
+      flushStreams();
+      ::_exit(1);
+    }
+    catch(...) {
+      internalError(
+          forked_context_, "the forked testing object has failed");
+      flushStreams();
+      ::_exit(1);
+    }
+
+    /* -- Pass the result and leave without destruction of the inherited
+     *    objects. They still belong to the parent process. */
+    frame_->reporter.writeResult(frame_->semantic_stack.top());
+    flushStreams();
+    ::_exit(0);
+  }
+
+  /* -- The prepared objects belong to the child now. The copy of this
+   *    process is destroyed here, otherwise every fork would keep its
+   *    objects (and their descriptors) alive until this process exits.
+   *    No command of the frame has run in this process, so neither
+   *    the start-up nor the tear-down functions are invoked - just
+   *    the destructors of the private copies. The streams have been
+   *    flushed before the fork, so nothing is printed twice. */
+  frame_.reset();
+
+  ::close(fds_[1]);
+  ::fcntl(fds_[0], F_SETFL, ::fcntl(fds_[0], F_GETFL) | O_NONBLOCK);
+  return std::unique_ptr<ForkedChild>(new ForkedChild(pid_, fds_[0]));
+}
+
+bool ForkedChild::isFinished() const noexcept {
+  return fd < 0;
+}
+
+void ForkedChild::appendWaitSource(
+    WaitSources& wait_sources_) const {
+  if(fd >= 0)
+    wait_sources_.push_back(WaitSource(fd, WaitSource::READ));
+}
+
+void ForkedChild::readReport() {
+  if(fd < 0)
+    return;
+
+  bool finished_(false);
+  char buffer_[4096];
+  while(true) {
+    const ssize_t read_(::read(fd, buffer_, sizeof(buffer_)));
+    if(read_ > 0)
+      report.append(buffer_, read_);
+    else if(read_ == 0) {
+      finished_ = true;
+      break;
+    }
+    else if(errno != EINTR) {
+      /* -- a broken pipe finishes the child too */
+      finished_ = errno != EAGAIN && errno != EWOULDBLOCK;
+      break;
+    }
+  }
+
+  if(finished_) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+void ForkedChild::reapChild() {
+  assert(isFinished());
+
+  if(!reaped) {
+    status = waitForChild(pid);
+    reaped = true;
+  }
+}
+
+bool ForkedChild::isReaped() const noexcept {
+  return reaped;
+}
+
+void ForkedChild::joinChild(
+    const Context& context_) {
+  assert(isFinished() && !joined);
+
+  reapChild();
+  joined = true;
+
+  /* -- pass the report and join the result */
+  bool result_(false);
+  replaySerialReport(
+      report, *context_.reporter, context_, describeCrash(status), result_);
+  if(!result_)
+    context_.semantic_stack->setTop(false);
+}
+
+} /* -- namespace OTest2 */
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__LIB_FORKEDCHILD_H_
+#define OTest2__LIB_FORKEDCHILD_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <waitsource.h>
+
+namespace OTest2 {
+
+class Context;
+
+/**
+ * @brief A testing object running in a forked process
+ *
+ * The child process runs commands in its own command stack and main loop.
+ * Its reports are passed back into the parent process through a pipe.
+ * The parent reads the data continuously and it replays them when
+ * the child is joined.
+ */
+class ForkedChild {
+  private:
+    int pid;
+    int fd;
+    std::string report;
+    int status;
+    bool reaped;
+    bool joined;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param pid_ Process ID of the child process
+     * @param fd_ Reading end of the pipe of the child. The object takes
+     *     the ownership.
+     */
+    explicit ForkedChild(
+        int pid_,
+        int fd_);
+
+    /**
+     * @brief Dtor
+     *
+     * A child which hasn't been joined is killed.
+     */
+    ~ForkedChild();
+
+    /* -- avoid copying */
+    ForkedChild(
+        const ForkedChild&) = delete;
+    ForkedChild& operator = (
+        const ForkedChild&) = delete;
+
+    /**
+     * @brief Fork a child process
+     *
+     * The prepare function gets a context of the child with an empty command
+     * stack and a reporter writing into the pipe. The function is expected
+     * to push commands which are run then in the child process.
+     *
+     * By default, the prepare function is invoked in the child process.
+     * If it's invoked before the fork, its side effects stay visible
+     * in the current process. The prepared objects are inherited by
+     * the child. The copy of the current process is destroyed right after
+     * the fork without running any of the prepared commands. Such a process
+     * should be a disposable one. Note that the reports made by the function
+     * are written into the pipe before the parent starts to read it. Hence,
+     * there should be just few of them.
+     *
+     * @param context_ The OTest2 context
+     * @param prepare_ The prepare function
+     * @param prepare_before_fork_ Invoke the prepare function in the current
+     *     process before the fork
+     * @return The child or nullptr if the fork fails. The failure is
+     *     reported into the context.
+     */
+    static std::unique_ptr<ForkedChild> forkChild(
+        const Context& context_,
+        std::function<void(const Context&)> prepare_,
+        bool prepare_before_fork_ = false);
+
+    /**
+     * @brief Check whether the child has passed all its data
+     */
+    bool isFinished() const noexcept;
+
+    /**
+     * @brief Append the pipe of the child into a list of wait sources
+     *
+     * Nothing is appended if the child is already finished.
+     */
+    void appendWaitSource(
+        WaitSources& wait_sources_) const;
+
+    /**
+     * @brief Read available data of the child
+     */
+    void readReport();
+
+    /**
+     * @brief Wait for the finished child process
+     *
+     * The process is reaped but its report is kept until the child
+     * is joined. The method may be invoked repeatedly.
+     */
+    void reapChild();
+
+    /**
+     * @brief Check whether the child process has been reaped
+     */
+    bool isReaped() const noexcept;
+
+    /**
+     * @brief Wait for the finished child and pass its report
+     *
+     * The report is passed into the reporter of the context and the result
+     * of the child is joined into the top of the semantic stack.
+     *
+     * @param context_ The OTest2 context
+     */
+    void joinChild(
+        const Context& context_);
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__LIB_FORKEDCHILD_H_ */
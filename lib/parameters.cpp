@@ -31,13 +31,11 @@ struct Parameters::Impl {
     typedef std::multimap<std::string, std::string> Params;
     Params params;
 
-    /* -- avoid copying */
+    Impl() = default;
     Impl(
-        const Impl&) = delete;
+        const Impl&) = default;
     Impl& operator = (
         const Impl&) = delete;
-
-    Impl() = default;
     ~Impl() = default;
 };
 
@@ -46,6 +44,12 @@ Parameters::Parameters() :
 
 }
 
+Parameters::Parameters(
+    const Parameters& other_) :
+  pimpl(new Impl(*other_.pimpl)) {
+
+}
+
 Parameters::Parameters(
     Parameters&& other_) noexcept :
   pimpl(other_.pimpl) {
@@ -61,6 +65,13 @@ void Parameters::swap(
   std::swap(pimpl, other_.pimpl);
 }
 
+Parameters& Parameters::operator = (
+    const Parameters& other_) {
+  Parameters tmp_(other_);
+  swap(tmp_);
+  return *this;
+}
+
 Parameters& Parameters::operator = (
     Parameters&& other_) noexcept {
   if(this != &other_) {
@@ -77,6 +88,12 @@ void Parameters::appendParameter(
   pimpl->params.insert(Impl::Params::value_type(name_, value_));
 }
 
+void Parameters::visitParameters(
+    std::function<void(const std::string&, const std::string&)> visitor_) const {
+  for(const auto& param_ : pimpl->params)
+    visitor_(param_.first, param_.second);
+}
+
 std::string Parameters::mixWithName(
     const std::string& name_) const {
   std::ostringstream oss_;
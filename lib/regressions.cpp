@@ -20,10 +20,15 @@
 #include <regressions.h>
 
 #include <assert.h>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <memory>
 #include <string>
 
 #include <assertstream.h>
+#include <benchmark.h>
+#include <benchmarkresult.h>
 #include <context.h>
 #include <difflogblock.h>
 #include <objectpath.h>
@@ -32,9 +37,44 @@
 #include <testmarkformatterassert.h>
 #include <testmarkptr.h>
 #include <testmarkstorage.h>
+#include <testmarktiming.h>
 
 namespace OTest2 {
 
+namespace {
+
+/* -- A slowdown is significant if it's bigger than this multiple of
+ *    the standard error of the difference of the medians. */
+constexpr long double SIGNIFICANCE_SIGMAS(3.0L);
+
+/* -- Estimation of the standard deviation from the MAD (normal
+ *    distribution) and of the standard error of the median. */
+constexpr long double MAD_TO_SIGMA(1.4826L);
+constexpr long double MEDIAN_ERROR(1.2533L);
+
+TestMarkPtr measureTiming(
+    const Context& context_,
+    const std::function<void()>& fce_) {
+  Benchmark benchmark_(context_);
+  while(benchmark_.nextSample()) {
+    for(std::uint64_t i_(benchmark_.getIterations()); i_ > 0; --i_)
+      fce_();
+  }
+  const BenchmarkResult result_(benchmark_.getResult());
+  return std::make_shared<TestMarkTiming>(
+      result_.median, result_.mad, result_.samples);
+}
+
+long double medianError(
+    const TestMarkTiming& mark_) {
+  if(mark_.getSamples() <= 0)
+    return 0.0L;
+  return MEDIAN_ERROR * MAD_TO_SIGMA * mark_.getMad()
+      / std::sqrt(static_cast<long double>(mark_.getSamples()));
+}
+
+} /* -- namespace */
+
 bool RegressionAssertion::compareObjectMark(
     const std::string& key_,
     TestMarkPtr test_mark_,
@@ -104,15 +144,90 @@ bool RegressionAssertion::compareObjectMark(
   return report_.getResult();
 }
 
+bool RegressionAssertion::comparePerfMark(
+    const std::string& key_,
+    TestMarkPtr test_mark_,
+    double threshold_) {
+  assert(test_mark_ != nullptr);
+
+  const Context& context_(otest2Context());
+
+  /* -- get the baseline from the storage */
+  const std::string full_key_(context_.object_path->getRegressionKey(key_));
+  TestMarkPtr stored_(context_.test_mark_storage->getTestMark(full_key_));
+  const TestMarkTiming* current_(
+      static_cast<const TestMarkTiming*>(test_mark_.get()));
+  const TestMarkTiming* baseline_(
+      dynamic_cast<const TestMarkTiming*>(stored_.get()));
+
+  /* -- The check fails if the current median is slower by more than
+   *    the threshold and the slowdown is not covered by the noise
+   *    of both measurements. */
+  bool passed_(false);
+  long double slowdown_(0.0L);
+  long double noise_(0.0L);
+  if(baseline_ != nullptr && baseline_->getMedian() > 0.0L) {
+    const long double error_(std::sqrt(
+        medianError(*current_) * medianError(*current_)
+        + medianError(*baseline_) * medianError(*baseline_)));
+    slowdown_ = (current_->getMedian() - baseline_->getMedian())
+        / baseline_->getMedian();
+    noise_ = SIGNIFICANCE_SIGMAS * error_ / baseline_->getMedian();
+    passed_ = slowdown_ <= threshold_ || slowdown_ <= noise_;
+  }
+
+  /* -- report the assertion */
+  AssertStream report_(enterAssertion(passed_));
+  if(passed_)
+    report_ << "performance regression check '" << full_key_ << "' has passed" << commitMsg();
+  else
+    report_ << "performance regression check '" << full_key_ << "' has failed" << commitMsg();
+
+  /* -- report both timings if the check fails */
+  if(!passed_) {
+    TestMarkFormatterAssert formatter_(&report_, "");
+
+    report_ << "---------  Current   ---------" << commitMsg();
+    test_mark_->printMark(formatter_);
+    report_ << commitMsg();
+
+    report_ << "---------  Original  ---------" << commitMsg();
+    if(stored_ != nullptr) {
+      stored_->printMark(formatter_);
+      report_ << commitMsg();
+    }
+
+    report_ << "--------- Difference ---------" << commitMsg();
+    if(baseline_ != nullptr) {
+      report_ << std::fixed << std::setprecision(1)
+          << "slower by " << slowdown_ * 100.0L << " % (threshold: "
+          << threshold_ * 100.0 << " %, noise: " << noise_ * 100.0L << " %)"
+          << commitMsg();
+    }
+    else
+      report_ << "there is no timing baseline" << commitMsg();
+  }
+
+  return report_.getResult();
+}
+
 bool RegressionAssertion::storeObjectMark(
     const std::string& key_,
     TestMarkPtr test_mark_) {
   assert(test_mark_ != nullptr);
 
   const Context& context_(otest2Context());
+  const std::string full_key_(context_.object_path->getRegressionKey(key_));
+
+  /* -- the mark stored by a forked process would be lost */
+  if(context_.test_mark_storage->isReadOnly()) {
+    AssertStream report_(enterAssertion(false));
+    report_ << "cannot store regression mark '" << full_key_
+        << "' in a forked testing object" << commitMsg();
+    return report_.getResult();
+  }
 
   /* -- store the mark */
-  const std::string full_key_(context_.object_path->getRegressionKey(key_));
   context_.test_mark_storage->setTestMark(full_key_, test_mark_);
 
   /* -- report the assertion */
@@ -121,4 +236,18 @@ bool RegressionAssertion::storeObjectMark(
   return report_.getResult();
 }
 
+bool RegressionAssertion::testPerfRegression(
+    const std::string& key_,
+    const std::function<void()>& fce_,
+    double threshold_) {
+  return comparePerfMark(
+      key_, measureTiming(otest2Context(), fce_), threshold_);
+}
+
+bool RegressionAssertion::testPerfRegressionW(
+    const std::string& key_,
+    const std::function<void()>& fce_) {
+  return storeObjectMark(key_, measureTiming(otest2Context(), fce_));
+}
+
 } /* -- namespace OTest2 */
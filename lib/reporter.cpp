@@ -24,4 +24,24 @@ namespace OTest2 {
 Reporter::Reporter() = default;
 Reporter::~Reporter() = default;
 
+void Reporter::reportBenchmark(
+    const Context& context_,
+    const BenchmarkResult& result_) {
+
+}
+
+void Reporter::reportResourceUsage(
+    const Context& context_,
+    const ResourceUsage& usage_) {
+
+}
+
+void Reporter::reportFixture(
+    const Context& context_,
+    bool start_up_,
+    int index_,
+    TimeSource::time_point begin_) {
+
+}
+
 } /* namespace OTest2 */
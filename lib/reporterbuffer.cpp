@@ -0,0 +1,408 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <reporterbuffer.h>
+
+#include <assert.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <assertbuffer.h>
+#include <benchmarkresult.h>
+#include <context.h>
+#include <objectpath.h>
+#include <parameters.h>
+#include <resourceusage.h>
+#include "timesourcereplay.h"
+#include <utils.h>
+
+namespace OTest2 {
+
+namespace {
+
+/**
+ * @brief One recorded operation of an assertion buffer
+ */
+struct AssertOp {
+    enum Kind {
+      TEXT,
+      FOREGROUND,
+      BACKGROUND,
+      STYLE,
+      RESET,
+      MESSAGE,
+      ASSERTION,
+    };
+
+    Kind kind;
+    std::string text;
+    Color color;
+    Style style;
+};
+
+typedef std::vector<AssertOp> AssertOps;
+
+/**
+ * @brief Assertion buffer recording the operations
+ */
+class Buffer : public AssertBuffer {
+  private:
+    std::shared_ptr<AssertOps> ops;
+
+  public:
+    /* -- avoid copying */
+    Buffer(
+        const Buffer&) = delete;
+    Buffer& operator = (
+        const Buffer&) = delete;
+
+    explicit Buffer(
+        std::shared_ptr<AssertOps> ops_);
+    virtual ~Buffer();
+
+  private:
+    void appendOp(
+        AssertOp::Kind kind_,
+        Color color_ = Color::BLACK,
+        Style style_ = Style::NORMAL);
+
+  protected:
+    /* -- stream buffer */
+    virtual int overflow(
+        int c_) override final;
+    virtual std::streamsize xsputn(
+        const char* s_,
+        std::streamsize n_) override final;
+
+  public:
+    /* -- assertion buffer */
+    virtual void setForeground(
+        Color color_) override;
+    virtual void setBackground(
+        Color color_) override;
+    virtual void setTextStyle(
+        Style style_) override;
+    virtual void resetAttributes() override;
+    virtual void commitMessage(
+        const Context& context_) override;
+    virtual void commitAssertion(
+        const Context& context_) override;
+};
+
+Buffer::Buffer(
+    std::shared_ptr<AssertOps> ops_) :
+  ops(ops_) {
+  assert(ops != nullptr);
+
+}
+
+Buffer::~Buffer() = default;
+
+void Buffer::appendOp(
+    AssertOp::Kind kind_,
+    Color color_,
+    Style style_) {
+  ops->push_back({kind_, std::string(), color_, style_});
+}
+
+int Buffer::overflow(
+    int c_) {
+  if(c_ != traits_type::eof()) {
+    const char char_(traits_type::to_char_type(c_));
+    xsputn(&char_, 1);
+  }
+  return traits_type::not_eof(c_);
+}
+
+std::streamsize Buffer::xsputn(
+    const char* s_,
+    std::streamsize n_) {
+  /* -- adjacent pieces of text are merged */
+  if(ops->empty() || ops->back().kind != AssertOp::TEXT)
+    appendOp(AssertOp::TEXT);
+  ops->back().text.append(s_, n_);
+  return n_;
+}
+
+void Buffer::setForeground(
+    Color color_) {
+  appendOp(AssertOp::FOREGROUND, color_);
+}
+
+void Buffer::setBackground(
+    Color color_) {
+  appendOp(AssertOp::BACKGROUND, color_);
+}
+
+void Buffer::setTextStyle(
+    Style style_) {
+  appendOp(AssertOp::STYLE, Color::BLACK, style_);
+}
+
+void Buffer::resetAttributes() {
+  appendOp(AssertOp::RESET);
+}
+
+void Buffer::commitMessage(
+    const Context& context_) {
+  appendOp(AssertOp::MESSAGE);
+}
+
+void Buffer::commitAssertion(
+    const Context& context_) {
+  appendOp(AssertOp::ASSERTION);
+}
+
+void replayAssertion(
+    AssertBuffer& buffer_,
+    const AssertOps& ops_,
+    const Context& context_) {
+  for(const auto& op_ : ops_) {
+    switch(op_.kind) {
+      case AssertOp::TEXT:
+        buffer_.sputn(op_.text.data(), op_.text.size());
+        break;
+      case AssertOp::FOREGROUND:
+        buffer_.setForeground(op_.color);
+        break;
+      case AssertOp::BACKGROUND:
+        buffer_.setBackground(op_.color);
+        break;
+      case AssertOp::STYLE:
+        buffer_.setTextStyle(op_.style);
+        break;
+      case AssertOp::RESET:
+        buffer_.resetAttributes();
+        break;
+      case AssertOp::MESSAGE:
+        buffer_.commitMessage(context_);
+        break;
+      case AssertOp::ASSERTION:
+        buffer_.commitAssertion(context_);
+        break;
+    }
+  }
+}
+
+} /* -- namespace */
+
+struct ReporterBuffer::Impl {
+    typedef std::function<void(Reporter&, const Context&)> Replay;
+    struct Event {
+        TimeSource::time_point time;
+        std::string path;
+        Replay replay;
+    };
+    std::vector<Event> events;
+
+    /* -- avoid copying */
+    Impl(
+        const Impl&) = delete;
+    Impl& operator = (
+        const Impl&) = delete;
+
+    Impl() = default;
+    ~Impl() = default;
+
+    void record(
+        const Context& context_,
+        Replay replay_);
+    AssertBufferPtr recordAssertion(
+        const Context& context_,
+        std::function<AssertBufferPtr(Reporter&, const Context&)> enter_);
+};
+
+void ReporterBuffer::Impl::record(
+    const Context& context_,
+    Replay replay_) {
+  events.push_back({
+      context_.time_source->now(),
+      context_.object_path->getCurrentPath(),
+      std::move(replay_)});
+}
+
+AssertBufferPtr ReporterBuffer::Impl::recordAssertion(
+    const Context& context_,
+    std::function<AssertBufferPtr(Reporter&, const Context&)> enter_) {
+  auto ops_(std::make_shared<AssertOps>());
+  record(context_, [ops_, enter_](Reporter& target_, const Context& context_) {
+    AssertBufferPtr buffer_(enter_(target_, context_));
+    replayAssertion(*buffer_, *ops_, context_);
+  });
+  return std::make_shared<Buffer>(ops_);
+}
+
+ReporterBuffer::ReporterBuffer() :
+  pimpl(new Impl) {
+
+}
+
+ReporterBuffer::~ReporterBuffer() {
+  odelete(pimpl);
+}
+
+void ReporterBuffer::replay(
+    Reporter& target_,
+    const Context& context_) {
+  for(const auto& event_ : pimpl->events) {
+    /* -- restore the time and the path of the event */
+    TimeSourceReplay time_(event_.time);
+    ObjectPath path_(event_.path);
+    Context replay_context_(
+        context_.command_stack,
+        context_.semantic_stack,
+        &path_,
+        &time_,
+        context_.exception_catcher,
+        &target_,
+        context_.test_mark_factory,
+        context_.test_mark_storage,
+        context_.user_data,
+        context_.scheduler);
+    event_.replay(target_, replay_context_);
+  }
+  pimpl->events.clear();
+}
+
+void ReporterBuffer::enterTest(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_) {
+  pimpl->record(context_, [name_, params_](Reporter& target_, const Context& context_) {
+    target_.enterTest(context_, name_, params_);
+  });
+}
+
+void ReporterBuffer::enterSuite(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_) {
+  pimpl->record(context_, [name_, params_](Reporter& target_, const Context& context_) {
+    target_.enterSuite(context_, name_, params_);
+  });
+}
+
+void ReporterBuffer::enterCase(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_) {
+  pimpl->record(context_, [name_, params_](Reporter& target_, const Context& context_) {
+    target_.enterCase(context_, name_, params_);
+  });
+}
+
+void ReporterBuffer::enterState(
+    const Context& context_,
+    const std::string& name_) {
+  pimpl->record(context_, [name_](Reporter& target_, const Context& context_) {
+    target_.enterState(context_, name_);
+  });
+}
+
+AssertBufferPtr ReporterBuffer::enterAssert(
+    const Context& context_,
+    bool condition_,
+    const std::string& file_,
+    int lineno_) {
+  return pimpl->recordAssertion(
+      context_,
+      [condition_, file_, lineno_](Reporter& target_, const Context& context_) {
+        return target_.enterAssert(context_, condition_, file_, lineno_);
+      });
+}
+
+AssertBufferPtr ReporterBuffer::enterError(
+    const Context& context_) {
+  return pimpl->recordAssertion(
+      context_,
+      [](Reporter& target_, const Context& context_) {
+        return target_.enterError(context_);
+      });
+}
+
+void ReporterBuffer::reportBenchmark(
+    const Context& context_,
+    const BenchmarkResult& result_) {
+  pimpl->record(context_, [result_](Reporter& target_, const Context& context_) {
+    target_.reportBenchmark(context_, result_);
+  });
+}
+
+void ReporterBuffer::reportResourceUsage(
+    const Context& context_,
+    const ResourceUsage& usage_) {
+  pimpl->record(context_, [usage_](Reporter& target_, const Context& context_) {
+    target_.reportResourceUsage(context_, usage_);
+  });
+}
+
+void ReporterBuffer::reportFixture(
+    const Context& context_,
+    bool start_up_,
+    int index_,
+    TimeSource::time_point begin_) {
+  pimpl->record(
+      context_,
+      [start_up_, index_, begin_](Reporter& target_, const Context& context_) {
+        target_.reportFixture(context_, start_up_, index_, begin_);
+      });
+}
+
+void ReporterBuffer::leaveState(
+    const Context& context_,
+    const std::string& name_,
+    bool result_) {
+  pimpl->record(context_, [name_, result_](Reporter& target_, const Context& context_) {
+    target_.leaveState(context_, name_, result_);
+  });
+}
+
+void ReporterBuffer::leaveCase(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_,
+    bool result_) {
+  pimpl->record(context_, [name_, params_, result_](Reporter& target_, const Context& context_) {
+    target_.leaveCase(context_, name_, params_, result_);
+  });
+}
+
+void ReporterBuffer::leaveSuite(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_,
+    bool result_) {
+  pimpl->record(context_, [name_, params_, result_](Reporter& target_, const Context& context_) {
+    target_.leaveSuite(context_, name_, params_, result_);
+  });
+}
+
+void ReporterBuffer::leaveTest(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_,
+    bool result_) {
+  pimpl->record(context_, [name_, params_, result_](Reporter& target_, const Context& context_) {
+    target_.leaveTest(context_, name_, params_, result_);
+  });
+}
+
+} /* -- namespace OTest2 */
@@ -18,17 +18,23 @@
  */
 #include <reporterconsole.h>
 
+#include <algorithm>
 #include <assert.h>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
 #include <utility>
+#include <vector>
 
+#include <allocationtracker.h>
 #include <assertbufferstr.h>
+#include <benchmarkresult.h>
+#include <const.h>
 #include <context.h>
 #include <objectpath.h>
 #include <parameters.h>
 #include <reporterstatistics.h>
+#include <resourceusage.h>
 #include <terminaldriver.h>
 #include <utils.h>
 
@@ -167,6 +173,81 @@ void printTotalErrors(
   printTotalResultLine(os_, label_, "        ", "        ", errors_str_.str());
 }
 
+struct BenchmarkUnit {
+    double scale;
+    const char* name;
+};
+
+/* -- the units are ordered from the biggest one */
+const BenchmarkUnit TIME_UNITS[] = {
+    {1.0e9, "s"},
+    {1.0e6, "ms"},
+    {1.0e3, "us"},
+    {1.0, "ns"},
+    {0.0, nullptr},
+};
+
+const BenchmarkUnit THROUGHPUT_UNITS[] = {
+    {1.0e9, "Gop/s"},
+    {1.0e6, "Mop/s"},
+    {1.0e3, "kop/s"},
+    {1.0, "op/s"},
+    {0.0, nullptr},
+};
+
+void printBenchmarkValue(
+    std::ostream& os_,
+    double value_,
+    const BenchmarkUnit* units_) {
+  /* -- select the biggest unit keeping the value at least 1 */
+  const BenchmarkUnit* unit_(units_);
+  while(unit_[1].name != nullptr && value_ < unit_->scale)
+    ++unit_;
+  os_ << value_ / unit_->scale << ' ' << unit_->name;
+}
+
+struct CaseUsage {
+    std::string path;
+    ResourceUsage usage;
+};
+
+void printExpensiveCases(
+    std::ostream& os_,
+    std::vector<CaseUsage> cases_) {
+  /* -- select the cases consuming the most of the CPU time */
+  const std::size_t count_(std::min<std::size_t>(cases_.size(), EXPENSIVE_CASES_REPORTED));
+  std::partial_sort(
+      cases_.begin(),
+      cases_.begin() + count_,
+      cases_.end(),
+      [](const CaseUsage& a_, const CaseUsage& b_) {
+        return a_.usage.cpu_time > b_.usage.cpu_time;
+      });
+
+  /* -- the allocations are known just if the instrumentation is linked */
+  const bool allocations_(AllocationTracker::isInstalled());
+
+  printHR(os_, '=', "Most expensive cases", 0);
+  os_ << "      CPU time     Max RSS    Faults  Switches";
+  if(allocations_)
+    os_ << "    Allocs";
+  os_ << "  Case" << std::endl;
+  for(std::size_t i_(0); i_ < count_; ++i_) {
+    const ResourceUsage& usage_(cases_[i_].usage);
+    std::ostringstream cpu_;
+    cpu_ << std::fixed << std::setprecision(3) << usage_.cpu_time / 1000.0 << " ms";
+    std::ostringstream rss_;
+    rss_ << usage_.max_rss << " kB";
+    os_ << "  " << std::setw(12) << cpu_.str()
+        << std::setw(12) << rss_.str()
+        << std::setw(10) << usage_.minor_faults + usage_.major_faults
+        << std::setw(10) << usage_.voluntary_switches + usage_.involuntary_switches;
+    if(allocations_)
+      os_ << std::setw(10) << usage_.allocations;
+    os_ << "  " << cases_[i_].path << std::endl;
+  }
+}
+
 } /* -- namespace */
 
 struct ReporterConsole::Impl : public AssertBufferListener {
@@ -217,6 +298,11 @@ struct ReporterConsole::Impl : public AssertBufferListener {
     /* -- buffer for assertion messages */
     AssertBufferStrPtr assert_buffer;
 
+    /* -- resources consumed by the test cases */
+    ResourceUsage last_usage;
+    bool last_usage_valid;
+    std::vector<CaseUsage> case_usages;
+
     /* -- avoid copying */
     Impl(
         const Impl&) = delete;
@@ -300,7 +386,10 @@ ReporterConsole::Impl::Impl(
   hide_location(hide_location_),
   indent(-1),
   stacked_hr(0, '='),
-  assert_buffer(std::make_shared<AssertBuffer>(this)) {
+  assert_buffer(std::make_shared<AssertBuffer>(this)),
+  last_usage(),
+  last_usage_valid(false),
+  case_usages() {
   assert(os != nullptr);
 
 }
@@ -472,6 +561,31 @@ AssertBufferPtr ReporterConsole::enterError(
   return pimpl->assert_buffer;
 }
 
+void ReporterConsole::reportBenchmark(
+    const Context& context_,
+    const BenchmarkResult& result_) {
+  pimpl->printStackedHR();
+
+  std::ostringstream oss_;
+  oss_ << std::fixed << std::setprecision(2);
+  printBenchmarkValue(oss_, result_.median, TIME_UNITS);
+  oss_ << "/op (" << result_.getVariation() * 100.0 << " % variation), ";
+  printBenchmarkValue(oss_, result_.getThroughput(), THROUGHPUT_UNITS);
+  oss_ << ", " << result_.samples << " samples x " << result_.iterations << " op";
+
+  *pimpl->os << "benchmark " << context_.object_path->getCurrentPath() << ": "
+      << oss_.str() << std::endl;
+}
+
+void ReporterConsole::reportResourceUsage(
+    const Context& context_,
+    const ResourceUsage& usage_) {
+  /* -- The usage is reported just before the object is left. The usages
+   *    of the test cases are kept for the final summary. */
+  pimpl->last_usage = usage_;
+  pimpl->last_usage_valid = true;
+}
+
 void ReporterConsole::leaveState(
     const Context& context_,
     const std::string& name_,
@@ -485,6 +599,11 @@ void ReporterConsole::leaveCase(
     const Parameters& params_,
     bool result_) {
   pimpl->statistics.reportCase(result_);
+  /* -- the usage of the interleaved cases isn't reported */
+  if(pimpl->verbose && pimpl->last_usage_valid)
+    pimpl->case_usages.push_back(
+        {context_.object_path->getCurrentPath(), pimpl->last_usage});
+  pimpl->last_usage_valid = false;
 
   /* -- print result of the test case */
   pimpl->printStackedHR();
@@ -502,6 +621,7 @@ void ReporterConsole::leaveSuite(
     const Parameters& params_,
     bool result_) {
   pimpl->statistics.reportSuite(result_);
+  pimpl->last_usage_valid = false;
 
   /* -- print result of the suite */
   pimpl->resetStackedHR();
@@ -522,6 +642,8 @@ void ReporterConsole::leaveTest(
     const Parameters& params_,
     bool result_) {
   pimpl->resetStackedHR();
+  if(!pimpl->case_usages.empty())
+    printExpensiveCases(*pimpl->os, std::move(pimpl->case_usages));
   printHR(*pimpl->os, '=', "Test results", 0);
   printTotalResultLine(
       *pimpl->os,
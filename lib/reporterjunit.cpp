@@ -29,9 +29,12 @@
 #include <time.h>
 #include <vector>
 
+#include <allocationtracker.h>
 #include <assertbufferstr.h>
+#include <benchmarkresult.h>
 #include <context.h>
 #include <parameters.h>
+#include <resourceusage.h>
 #include <timesource.h>
 #include <utils.h>
 
@@ -74,6 +77,7 @@ std::string formatDuration(
 struct ReporterJUnit::Impl : public AssertBufferListener {
     std::string filename;
     bool hide_location;
+    bool report_resources;
 
     /* -- XML structure */
     ::pugi::xml_document doc;
@@ -104,7 +108,8 @@ struct ReporterJUnit::Impl : public AssertBufferListener {
 
     explicit Impl(
         const std::string& file_,
-        bool hide_location_);
+        bool hide_location_,
+        bool report_resources_);
     virtual ~Impl();
 
     void cumulateStatistics(
@@ -126,6 +131,10 @@ struct ReporterJUnit::Impl : public AssertBufferListener {
     void appendMessage(
         const Context& context_,
         const std::string& message_);
+    void appendProperty(
+        Record& record_,
+        const char* name_,
+        const std::string& value_);
     void commitMessage(
         const Context& context_);
 
@@ -153,9 +162,11 @@ struct ReporterJUnit::Impl : public AssertBufferListener {
 
 ReporterJUnit::Impl::Impl(
     const std::string& file_,
-    bool hide_location_) :
+    bool hide_location_,
+    bool report_resources_) :
   filename(file_),
   hide_location(hide_location_),
+  report_resources(report_resources_),
   testname(),
   node_stack(),
   assert_buffer(std::make_shared<AssertBufferStr>(this)) {
@@ -222,6 +233,22 @@ void ReporterJUnit::Impl::appendMessage(
   message << "\n" << message_;
 }
 
+void ReporterJUnit::Impl::appendProperty(
+    Record& record_,
+    const char* name_,
+    const std::string& value_) {
+  /* -- the properties element must be the first child of the test case */
+  auto properties_(record_.node.child("properties"));
+  if(!properties_)
+    properties_ = record_.node.prepend_child("properties");
+
+  auto property_(properties_.append_child("property"));
+  auto name_attr_(property_.append_attribute("name"));
+  name_attr_ = name_;
+  auto value_attr_(property_.append_attribute("value"));
+  value_attr_ = value_.c_str();
+}
+
 void ReporterJUnit::Impl::commitMessage(
     const Context& context_) {
   auto& top_(node_stack.back());
@@ -284,8 +311,9 @@ void ReporterJUnit::Impl::errorClose(
 
 ReporterJUnit::ReporterJUnit(
     const std::string& file_,
-    bool hide_location_) :
-  pimpl(new Impl(file_, hide_location_)) {
+    bool hide_location_,
+    bool report_resources_) :
+  pimpl(new Impl(file_, hide_location_, report_resources_)) {
 
 }
 
@@ -386,6 +414,50 @@ AssertBufferPtr ReporterJUnit::enterError(
   return pimpl->assert_buffer;
 }
 
+void ReporterJUnit::reportBenchmark(
+    const Context& context_,
+    const BenchmarkResult& result_) {
+  /* -- the benchmark is stored as properties of the current test case,
+   *    all times are in nanoseconds per one operation */
+  auto& top_(pimpl->node_stack.back());
+  pimpl->appendProperty(top_, "benchmark.iterations", std::to_string(result_.iterations));
+  pimpl->appendProperty(top_, "benchmark.samples", std::to_string(result_.samples));
+  pimpl->appendProperty(top_, "benchmark.mean", std::to_string(result_.mean));
+  pimpl->appendProperty(top_, "benchmark.median", std::to_string(result_.median));
+  pimpl->appendProperty(top_, "benchmark.stddev", std::to_string(result_.stddev));
+  pimpl->appendProperty(top_, "benchmark.mad", std::to_string(result_.mad));
+  pimpl->appendProperty(top_, "benchmark.min", std::to_string(result_.min));
+  pimpl->appendProperty(top_, "benchmark.max", std::to_string(result_.max));
+}
+
+void ReporterJUnit::reportResourceUsage(
+    const Context& context_,
+    const ResourceUsage& usage_) {
+  if(!pimpl->report_resources)
+    return;
+
+  /* -- the usage is stored as properties of the left test case or suite,
+   *    times are in microseconds, the memory in kilobytes */
+  auto& top_(pimpl->node_stack.back());
+  pimpl->appendProperty(top_, "resources.cpu_time", std::to_string(usage_.cpu_time));
+  pimpl->appendProperty(top_, "resources.user_time", std::to_string(usage_.user_time));
+  pimpl->appendProperty(top_, "resources.system_time", std::to_string(usage_.system_time));
+  pimpl->appendProperty(top_, "resources.max_rss", std::to_string(usage_.max_rss));
+  pimpl->appendProperty(top_, "resources.minor_faults", std::to_string(usage_.minor_faults));
+  pimpl->appendProperty(top_, "resources.major_faults", std::to_string(usage_.major_faults));
+  pimpl->appendProperty(
+      top_, "resources.voluntary_switches", std::to_string(usage_.voluntary_switches));
+  pimpl->appendProperty(
+      top_, "resources.involuntary_switches", std::to_string(usage_.involuntary_switches));
+  if(AllocationTracker::isInstalled()) {
+    pimpl->appendProperty(top_, "resources.allocations", std::to_string(usage_.allocations));
+    pimpl->appendProperty(
+        top_, "resources.deallocations", std::to_string(usage_.deallocations));
+    pimpl->appendProperty(
+        top_, "resources.allocated_bytes", std::to_string(usage_.allocated_bytes));
+  }
+}
+
 void ReporterJUnit::leaveState(
     const Context& context_,
     const std::string& name_,
@@ -0,0 +1,857 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "reporterserial.h"
+
+#include <assert.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <assertbuffer.h>
+#include <assertstream.h>
+#include <benchmarkresult.h>
+#include <context.h>
+#include <objectpath.h>
+#include <parameters.h>
+#include <reporterattributes.h>
+#include <resourceusage.h>
+#include <timesource.h>
+#include "timesourcereplay.h"
+#include <utils.h>
+
+namespace OTest2 {
+
+namespace {
+
+enum class SerialTag : std::uint8_t {
+  ENTER_TEST = 1,
+  ENTER_SUITE = 2,
+  ENTER_CASE = 3,
+  ENTER_STATE = 4,
+  ENTER_ASSERT = 5,
+  ENTER_ERROR = 6,
+  LEAVE_STATE = 7,
+  LEAVE_CASE = 8,
+  LEAVE_SUITE = 9,
+  LEAVE_TEST = 10,
+  TEXT = 11,
+  FOREGROUND = 12,
+  BACKGROUND = 13,
+  STYLE = 14,
+  RESET = 15,
+  MESSAGE = 16,
+  ASSERTION = 17,
+  RESULT = 18,
+  BENCHMARK = 19,
+  RESOURCES = 20,
+  FIXTURE = 21,
+};
+
+/**
+ * @brief Encoder of one serialized record
+ */
+class SerialWriter {
+  private:
+    std::string data;
+
+  public:
+    void putByte(
+        std::uint8_t value_) {
+      data.push_back(static_cast<char>(value_));
+    }
+
+    void putInt(
+        std::int64_t value_) {
+      std::uint64_t v_(static_cast<std::uint64_t>(value_));
+      for(int i_(0); i_ < 8; ++i_) {
+        putByte(static_cast<std::uint8_t>(v_ & 0xff));
+        v_ >>= 8;
+      }
+    }
+
+    void putString(
+        const std::string& value_) {
+      putInt(value_.size());
+      data.append(value_);
+    }
+
+    void putDouble(
+        double value_) {
+      std::uint64_t v_;
+      static_assert(sizeof(v_) == sizeof(value_), "unexpected size of double");
+      std::memcpy(&v_, &value_, sizeof(v_));
+      putInt(static_cast<std::int64_t>(v_));
+    }
+
+    void putTag(
+        SerialTag tag_) {
+      putByte(static_cast<std::uint8_t>(tag_));
+    }
+
+    void putEvent(
+        SerialTag tag_,
+        const Context& context_) {
+      putTag(tag_);
+      putInt(context_.time_source->now().time_since_epoch().count());
+      putString(context_.object_path->getCurrentPath());
+    }
+
+    void putParameters(
+        const Parameters& params_) {
+      params_.visitParameters(
+          [this](const std::string& name_, const std::string& value_) {
+            putString(name_);
+            putString(value_);
+          });
+      /* -- terminated by an empty name, names are never empty */
+      putString(std::string());
+    }
+
+    const std::string& getData() const noexcept {
+      return data;
+    }
+
+    void clear() noexcept {
+      data.clear();
+    }
+};
+
+/**
+ * @brief Decoder of the serialized records
+ */
+class SerialReader {
+  private:
+    const std::string& data;
+    std::string::size_type pos;
+
+  public:
+    explicit SerialReader(
+        const std::string& data_) :
+      data(data_),
+      pos(0) {
+
+    }
+
+    bool isEnd() const noexcept {
+      return pos >= data.size();
+    }
+
+    bool getByte(
+        std::uint8_t& value_) {
+      if(pos >= data.size())
+        return false;
+      value_ = static_cast<std::uint8_t>(data[pos++]);
+      return true;
+    }
+
+    bool getInt(
+        std::int64_t& value_) {
+      std::uint64_t v_(0);
+      for(int i_(0); i_ < 8; ++i_) {
+        std::uint8_t byte_;
+        if(!getByte(byte_))
+          return false;
+        v_ |= static_cast<std::uint64_t>(byte_) << (8 * i_);
+      }
+      value_ = static_cast<std::int64_t>(v_);
+      return true;
+    }
+
+    bool getInt(
+        int& value_) {
+      std::int64_t v_;
+      if(!getInt(v_))
+        return false;
+      value_ = static_cast<int>(v_);
+      return true;
+    }
+
+    bool getDouble(
+        double& value_) {
+      std::int64_t v_;
+      if(!getInt(v_))
+        return false;
+      const std::uint64_t bits_(static_cast<std::uint64_t>(v_));
+      std::memcpy(&value_, &bits_, sizeof(value_));
+      return true;
+    }
+
+    bool getBool(
+        bool& value_) {
+      std::uint8_t byte_;
+      if(!getByte(byte_))
+        return false;
+      value_ = byte_ != 0;
+      return true;
+    }
+
+    bool getString(
+        std::string& value_) {
+      std::int64_t size_;
+      if(!getInt(size_)
+          || size_ < 0
+          || static_cast<std::uint64_t>(size_) > data.size() - pos)
+        return false;
+      value_.assign(data, pos, size_);
+      pos += size_;
+      return true;
+    }
+
+    bool getParameters(
+        Parameters& params_) {
+      std::string name_;
+      std::string value_;
+      while(true) {
+        if(!getString(name_))
+          return false;
+        if(name_.empty())
+          return true;
+        if(!getString(value_))
+          return false;
+        params_.appendParameter(name_, value_);
+      }
+    }
+};
+
+void writeAll(
+    int fd_,
+    const std::string& data_) {
+  const char* begin_(data_.data());
+  std::string::size_type rest_(data_.size());
+  while(rest_ > 0) {
+    const ssize_t written_(::write(fd_, begin_, rest_));
+    if(written_ < 0) {
+      if(errno == EINTR)
+        continue;
+      return; /* -- the parent is gone, nobody reads the report */
+    }
+    begin_ += written_;
+    rest_ -= written_;
+  }
+}
+
+/**
+ * @brief Assertion buffer serializing its operations
+ *
+ * Adjacent pieces of text are merged and written together with
+ * the following operation.
+ */
+class Buffer : public AssertBuffer {
+  private:
+    int fd;
+    SerialWriter writer;
+
+  public:
+    /* -- avoid copying */
+    Buffer(
+        const Buffer&) = delete;
+    Buffer& operator = (
+        const Buffer&) = delete;
+
+    explicit Buffer(
+        int fd_);
+    virtual ~Buffer();
+
+  private:
+    void writeOp(
+        SerialTag tag_,
+        std::uint8_t attribute_ = 0);
+
+  protected:
+    /* -- stream buffer */
+    virtual int overflow(
+        int c_) override final;
+    virtual std::streamsize xsputn(
+        const char* s_,
+        std::streamsize n_) override final;
+
+  public:
+    /* -- assertion buffer */
+    virtual void setForeground(
+        Color color_) override;
+    virtual void setBackground(
+        Color color_) override;
+    virtual void setTextStyle(
+        Style style_) override;
+    virtual void resetAttributes() override;
+    virtual void commitMessage(
+        const Context& context_) override;
+    virtual void commitAssertion(
+        const Context& context_) override;
+};
+
+Buffer::Buffer(
+    int fd_) :
+  fd(fd_),
+  writer() {
+
+}
+
+Buffer::~Buffer() = default;
+
+void Buffer::writeOp(
+    SerialTag tag_,
+    std::uint8_t attribute_) {
+  writer.putTag(tag_);
+  writer.putByte(attribute_);
+  writeAll(fd, writer.getData());
+  writer.clear();
+}
+
+int Buffer::overflow(
+    int c_) {
+  if(c_ != traits_type::eof()) {
+    const char char_(traits_type::to_char_type(c_));
+    xsputn(&char_, 1);
+  }
+  return traits_type::not_eof(c_);
+}
+
+std::streamsize Buffer::xsputn(
+    const char* s_,
+    std::streamsize n_) {
+  writer.putTag(SerialTag::TEXT);
+  writer.putString(std::string(s_, n_));
+  return n_;
+}
+
+void Buffer::setForeground(
+    Color color_) {
+  writeOp(SerialTag::FOREGROUND, static_cast<std::uint8_t>(color_));
+}
+
+void Buffer::setBackground(
+    Color color_) {
+  writeOp(SerialTag::BACKGROUND, static_cast<std::uint8_t>(color_));
+}
+
+void Buffer::setTextStyle(
+    Style style_) {
+  writeOp(SerialTag::STYLE, static_cast<std::uint8_t>(style_));
+}
+
+void Buffer::resetAttributes() {
+  writeOp(SerialTag::RESET);
+}
+
+void Buffer::commitMessage(
+    const Context& context_) {
+  writeOp(SerialTag::MESSAGE);
+}
+
+void Buffer::commitAssertion(
+    const Context& context_) {
+  writeOp(SerialTag::ASSERTION);
+}
+
+/**
+ * @brief Context of a replayed event
+ */
+struct ReplayEnvironment {
+    TimeSourceReplay time;
+    ObjectPath path;
+    Context context;
+
+    /* -- avoid copying */
+    ReplayEnvironment(
+        const ReplayEnvironment&) = delete;
+    ReplayEnvironment& operator = (
+        const ReplayEnvironment&) = delete;
+
+    explicit ReplayEnvironment(
+        const Context& context_,
+        Reporter& target_,
+        TimeSource::time_point time_,
+        const std::string& path_) :
+      time(time_),
+      path(path_),
+      context(
+          context_.command_stack,
+          context_.semantic_stack,
+          &path,
+          &time,
+          context_.exception_catcher,
+          &target_,
+          context_.test_mark_factory,
+          context_.test_mark_storage,
+          context_.user_data,
+          context_.scheduler) {
+
+    }
+};
+
+/**
+ * @brief An object entered but not left yet during the replay
+ */
+struct OpenObject {
+    SerialTag tag;
+    std::string name;
+    Parameters params;
+};
+
+/**
+ * @brief Replay the events until the final result
+ *
+ * @return True if the final result has been read
+ */
+bool replayEvents(
+    SerialReader& reader_,
+    Reporter& target_,
+    const Context& context_,
+    std::unique_ptr<ReplayEnvironment>& env_,
+    AssertBufferPtr& buffer_,
+    std::vector<OpenObject>& open_objects_,
+    bool& result_) {
+  while(!reader_.isEnd()) {
+    std::uint8_t tag_byte_;
+    reader_.getByte(tag_byte_);
+    const SerialTag tag_(static_cast<SerialTag>(tag_byte_));
+
+    /* -- the final result */
+    if(tag_ == SerialTag::RESULT)
+      return reader_.getBool(result_);
+
+    /* -- operations of an assertion buffer */
+    if(tag_ >= SerialTag::TEXT && tag_ <= SerialTag::ASSERTION) {
+      if(buffer_ == nullptr)
+        return false;
+
+      std::string text_;
+      std::uint8_t attribute_(0);
+      if(tag_ == SerialTag::TEXT) {
+        if(!reader_.getString(text_))
+          return false;
+      }
+      else if(!reader_.getByte(attribute_))
+        return false;
+
+      switch(tag_) {
+        case SerialTag::TEXT:
+          buffer_->sputn(text_.data(), text_.size());
+          break;
+        case SerialTag::FOREGROUND:
+          buffer_->setForeground(static_cast<Color>(attribute_));
+          break;
+        case SerialTag::BACKGROUND:
+          buffer_->setBackground(static_cast<Color>(attribute_));
+          break;
+        case SerialTag::STYLE:
+          buffer_->setTextStyle(static_cast<Style>(attribute_));
+          break;
+        case SerialTag::RESET:
+          buffer_->resetAttributes();
+          break;
+        case SerialTag::MESSAGE:
+          buffer_->commitMessage(env_->context);
+          break;
+        case SerialTag::ASSERTION:
+          buffer_->commitAssertion(env_->context);
+          buffer_.reset();
+          break;
+        default:
+          return false;
+      }
+      continue;
+    }
+
+    /* -- restore the time and the path of the event */
+    std::int64_t time_;
+    std::string path_;
+    if(!reader_.getInt(time_) || !reader_.getString(path_))
+      return false;
+    env_.reset(new ReplayEnvironment(
+        context_,
+        target_,
+        TimeSource::time_point(TimeSource::duration(time_)),
+        path_));
+    const Context& event_context_(env_->context);
+
+    std::string name_;
+    Parameters params_;
+    bool result_value_;
+    switch(tag_) {
+      case SerialTag::ENTER_TEST:
+      case SerialTag::ENTER_SUITE:
+      case SerialTag::ENTER_CASE:
+        if(!reader_.getString(name_) || !reader_.getParameters(params_))
+          return false;
+        open_objects_.push_back({tag_, name_, params_});
+        if(tag_ == SerialTag::ENTER_TEST)
+          target_.enterTest(event_context_, name_, params_);
+        else if(tag_ == SerialTag::ENTER_SUITE)
+          target_.enterSuite(event_context_, name_, params_);
+        else
+          target_.enterCase(event_context_, name_, params_);
+        break;
+
+      case SerialTag::ENTER_STATE:
+        if(!reader_.getString(name_))
+          return false;
+        open_objects_.push_back({tag_, name_, Parameters()});
+        target_.enterState(event_context_, name_);
+        break;
+
+      case SerialTag::ENTER_ASSERT: {
+        bool condition_;
+        std::string file_;
+        int lineno_;
+        if(!reader_.getBool(condition_)
+            || !reader_.getString(file_)
+            || !reader_.getInt(lineno_))
+          return false;
+        buffer_ = target_.enterAssert(event_context_, condition_, file_, lineno_);
+        break;
+      }
+
+      case SerialTag::ENTER_ERROR:
+        buffer_ = target_.enterError(event_context_);
+        break;
+
+      case SerialTag::BENCHMARK: {
+        BenchmarkResult benchmark_;
+        std::int64_t iterations_;
+        if(!reader_.getInt(iterations_)
+            || !reader_.getInt(benchmark_.samples)
+            || !reader_.getDouble(benchmark_.mean)
+            || !reader_.getDouble(benchmark_.median)
+            || !reader_.getDouble(benchmark_.stddev)
+            || !reader_.getDouble(benchmark_.mad)
+            || !reader_.getDouble(benchmark_.min)
+            || !reader_.getDouble(benchmark_.max))
+          return false;
+        benchmark_.iterations = static_cast<std::uint64_t>(iterations_);
+        target_.reportBenchmark(event_context_, benchmark_);
+        break;
+      }
+
+      case SerialTag::RESOURCES: {
+        ResourceUsage usage_;
+        if(!reader_.getInt(usage_.cpu_time)
+            || !reader_.getInt(usage_.user_time)
+            || !reader_.getInt(usage_.system_time)
+            || !reader_.getInt(usage_.max_rss)
+            || !reader_.getInt(usage_.minor_faults)
+            || !reader_.getInt(usage_.major_faults)
+            || !reader_.getInt(usage_.voluntary_switches)
+            || !reader_.getInt(usage_.involuntary_switches)
+            || !reader_.getInt(usage_.allocations)
+            || !reader_.getInt(usage_.deallocations)
+            || !reader_.getInt(usage_.allocated_bytes))
+          return false;
+        target_.reportResourceUsage(event_context_, usage_);
+        break;
+      }
+
+      case SerialTag::FIXTURE: {
+        bool start_up_;
+        int index_;
+        std::int64_t begin_;
+        if(!reader_.getBool(start_up_)
+            || !reader_.getInt(index_)
+            || !reader_.getInt(begin_))
+          return false;
+        target_.reportFixture(
+            event_context_,
+            start_up_,
+            index_,
+            TimeSource::time_point(TimeSource::duration(begin_)));
+        break;
+      }
+
+      case SerialTag::LEAVE_STATE:
+        if(!reader_.getString(name_) || !reader_.getBool(result_value_))
+          return false;
+        if(!open_objects_.empty())
+          open_objects_.pop_back();
+        target_.leaveState(event_context_, name_, result_value_);
+        break;
+
+      case SerialTag::LEAVE_CASE:
+      case SerialTag::LEAVE_SUITE:
+      case SerialTag::LEAVE_TEST:
+        if(!reader_.getString(name_)
+            || !reader_.getParameters(params_)
+            || !reader_.getBool(result_value_))
+          return false;
+        if(!open_objects_.empty())
+          open_objects_.pop_back();
+        if(tag_ == SerialTag::LEAVE_CASE)
+          target_.leaveCase(event_context_, name_, params_, result_value_);
+        else if(tag_ == SerialTag::LEAVE_SUITE)
+          target_.leaveSuite(event_context_, name_, params_, result_value_);
+        else
+          target_.leaveTest(event_context_, name_, params_, result_value_);
+        break;
+
+      default:
+        return false;
+    }
+  }
+
+  return false;
+}
+
+} /* -- namespace */
+
+struct ReporterSerial::Impl {
+    int fd;
+    SerialWriter writer;
+
+    /* -- avoid copying */
+    Impl(
+        const Impl&) = delete;
+    Impl& operator = (
+        const Impl&) = delete;
+
+    explicit Impl(
+        int fd_) :
+      fd(fd_),
+      writer() {
+
+    }
+
+    ~Impl() = default;
+
+    void flush() {
+      writeAll(fd, writer.getData());
+      writer.clear();
+    }
+};
+
+ReporterSerial::ReporterSerial(
+    int fd_) :
+  pimpl(new Impl(fd_)) {
+
+}
+
+ReporterSerial::~ReporterSerial() {
+  odelete(pimpl);
+}
+
+void ReporterSerial::writeResult(
+    bool result_) {
+  pimpl->writer.putTag(SerialTag::RESULT);
+  pimpl->writer.putByte(result_);
+  pimpl->flush();
+}
+
+void ReporterSerial::enterTest(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_) {
+  pimpl->writer.putEvent(SerialTag::ENTER_TEST, context_);
+  pimpl->writer.putString(name_);
+  pimpl->writer.putParameters(params_);
+  pimpl->flush();
+}
+
+void ReporterSerial::enterSuite(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_) {
+  pimpl->writer.putEvent(SerialTag::ENTER_SUITE, context_);
+  pimpl->writer.putString(name_);
+  pimpl->writer.putParameters(params_);
+  pimpl->flush();
+}
+
+void ReporterSerial::enterCase(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_) {
+  pimpl->writer.putEvent(SerialTag::ENTER_CASE, context_);
+  pimpl->writer.putString(name_);
+  pimpl->writer.putParameters(params_);
+  pimpl->flush();
+}
+
+void ReporterSerial::enterState(
+    const Context& context_,
+    const std::string& name_) {
+  pimpl->writer.putEvent(SerialTag::ENTER_STATE, context_);
+  pimpl->writer.putString(name_);
+  pimpl->flush();
+}
+
+AssertBufferPtr ReporterSerial::enterAssert(
+    const Context& context_,
+    bool condition_,
+    const std::string& file_,
+    int lineno_) {
+  pimpl->writer.putEvent(SerialTag::ENTER_ASSERT, context_);
+  pimpl->writer.putByte(condition_);
+  pimpl->writer.putString(file_);
+  pimpl->writer.putInt(lineno_);
+  pimpl->flush();
+  return std::make_shared<Buffer>(pimpl->fd);
+}
+
+AssertBufferPtr ReporterSerial::enterError(
+    const Context& context_) {
+  pimpl->writer.putEvent(SerialTag::ENTER_ERROR, context_);
+  pimpl->flush();
+  return std::make_shared<Buffer>(pimpl->fd);
+}
+
+void ReporterSerial::reportBenchmark(
+    const Context& context_,
+    const BenchmarkResult& result_) {
+  pimpl->writer.putEvent(SerialTag::BENCHMARK, context_);
+  pimpl->writer.putInt(static_cast<std::int64_t>(result_.iterations));
+  pimpl->writer.putInt(result_.samples);
+  pimpl->writer.putDouble(result_.mean);
+  pimpl->writer.putDouble(result_.median);
+  pimpl->writer.putDouble(result_.stddev);
+  pimpl->writer.putDouble(result_.mad);
+  pimpl->writer.putDouble(result_.min);
+  pimpl->writer.putDouble(result_.max);
+  pimpl->flush();
+}
+
+void ReporterSerial::reportResourceUsage(
+    const Context& context_,
+    const ResourceUsage& usage_) {
+  pimpl->writer.putEvent(SerialTag::RESOURCES, context_);
+  pimpl->writer.putInt(usage_.cpu_time);
+  pimpl->writer.putInt(usage_.user_time);
+  pimpl->writer.putInt(usage_.system_time);
+  pimpl->writer.putInt(usage_.max_rss);
+  pimpl->writer.putInt(usage_.minor_faults);
+  pimpl->writer.putInt(usage_.major_faults);
+  pimpl->writer.putInt(usage_.voluntary_switches);
+  pimpl->writer.putInt(usage_.involuntary_switches);
+  pimpl->writer.putInt(usage_.allocations);
+  pimpl->writer.putInt(usage_.deallocations);
+  pimpl->writer.putInt(usage_.allocated_bytes);
+  pimpl->flush();
+}
+
+void ReporterSerial::reportFixture(
+    const Context& context_,
+    bool start_up_,
+    int index_,
+    TimeSource::time_point begin_) {
+  pimpl->writer.putEvent(SerialTag::FIXTURE, context_);
+  pimpl->writer.putByte(start_up_);
+  pimpl->writer.putInt(index_);
+  pimpl->writer.putInt(begin_.time_since_epoch().count());
+  pimpl->flush();
+}
+
+void ReporterSerial::leaveState(
+    const Context& context_,
+    const std::string& name_,
+    bool result_) {
+  pimpl->writer.putEvent(SerialTag::LEAVE_STATE, context_);
+  pimpl->writer.putString(name_);
+  pimpl->writer.putByte(result_);
+  pimpl->flush();
+}
+
+void ReporterSerial::leaveCase(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_,
+    bool result_) {
+  pimpl->writer.putEvent(SerialTag::LEAVE_CASE, context_);
+  pimpl->writer.putString(name_);
+  pimpl->writer.putParameters(params_);
+  pimpl->writer.putByte(result_);
+  pimpl->flush();
+}
+
+void ReporterSerial::leaveSuite(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_,
+    bool result_) {
+  pimpl->writer.putEvent(SerialTag::LEAVE_SUITE, context_);
+  pimpl->writer.putString(name_);
+  pimpl->writer.putParameters(params_);
+  pimpl->writer.putByte(result_);
+  pimpl->flush();
+}
+
+void ReporterSerial::leaveTest(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_,
+    bool result_) {
+  pimpl->writer.putEvent(SerialTag::LEAVE_TEST, context_);
+  pimpl->writer.putString(name_);
+  pimpl->writer.putParameters(params_);
+  pimpl->writer.putByte(result_);
+  pimpl->flush();
+}
+
+bool replaySerialReport(
+    const std::string& data_,
+    Reporter& target_,
+    const Context& context_,
+    const std::string& crash_message_,
+    bool& result_) {
+  SerialReader reader_(data_);
+  std::unique_ptr<ReplayEnvironment> env_;
+  AssertBufferPtr buffer_;
+  std::vector<OpenObject> open_objects_;
+
+  if(replayEvents(reader_, target_, context_, env_, buffer_, open_objects_, result_))
+    return true;
+
+  /* -- The report is truncated. Finish the open assertion, report
+   *    the crash and leave all open objects as failed. */
+  if(env_ == nullptr)
+    env_.reset(new ReplayEnvironment(
+        context_,
+        target_,
+        context_.time_source->now(),
+        context_.object_path->getCurrentPath()));
+  if(buffer_ != nullptr)
+    buffer_->commitAssertion(env_->context);
+  {
+    AssertStream report_(env_->context, target_.enterError(env_->context), false, {});
+    report_ << crash_message_ << commitMsg();
+  }
+  for(auto iter_(open_objects_.rbegin()); iter_ != open_objects_.rend(); ++iter_) {
+    switch(iter_->tag) {
+      case SerialTag::ENTER_TEST:
+        target_.leaveTest(env_->context, iter_->name, iter_->params, false);
+        break;
+      case SerialTag::ENTER_SUITE:
+        target_.leaveSuite(env_->context, iter_->name, iter_->params, false);
+        break;
+      case SerialTag::ENTER_CASE:
+        target_.leaveCase(env_->context, iter_->name, iter_->params, false);
+        break;
+      default:
+        target_.leaveState(env_->context, iter_->name, false);
+        break;
+    }
+  }
+
+  result_ = false;
+  return false;
+}
+
+} /* -- namespace OTest2 */
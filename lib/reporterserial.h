@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__LIB_REPORTERSERIAL_H_
+#define OTest2__LIB_REPORTERSERIAL_H_
+
+#include <string>
+
+#include <reporter.h>
+
+namespace OTest2 {
+
+class Context;
+
+/**
+ * @brief A reporter serializing the reported events into a file descriptor
+ *
+ * The reporter is used by forked testing objects to pass their reports
+ * back into the parent process. Each event is written immediately, so
+ * the parent gets all events reported before a possible crash of the child.
+ */
+class ReporterSerial : public Reporter {
+  private:
+    struct Impl;
+    Impl* pimpl;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param fd_ The file descriptor. The reporter doesn't own it.
+     */
+    explicit ReporterSerial(
+        int fd_);
+
+    /**
+     * @brief Dtor
+     */
+    virtual ~ReporterSerial();
+
+    /* -- avoid copying */
+    ReporterSerial(
+        const ReporterSerial&) = delete;
+    ReporterSerial& operator = (
+        const ReporterSerial&) = delete;
+
+    /**
+     * @brief Write the final result of the forked object
+     *
+     * @param result_ The result
+     */
+    void writeResult(
+        bool result_);
+
+    /* -- reporter interface */
+    virtual void enterTest(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_) override;
+    virtual void enterSuite(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_) override;
+    virtual void enterCase(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_) override;
+    virtual void enterState(
+        const Context& context_,
+        const std::string& name_) override;
+    virtual AssertBufferPtr enterAssert(
+        const Context& context_,
+        bool condition_,
+        const std::string& file_,
+        int lineno_) override;
+    virtual AssertBufferPtr enterError(
+        const Context& context_) override;
+    virtual void reportBenchmark(
+        const Context& context_,
+        const BenchmarkResult& result_) override;
+    virtual void reportResourceUsage(
+        const Context& context_,
+        const ResourceUsage& usage_) override;
+    virtual void reportFixture(
+        const Context& context_,
+        bool start_up_,
+        int index_,
+        TimeSource::time_point begin_) override;
+    virtual void leaveState(
+        const Context& context_,
+        const std::string& name_,
+        bool result_) override;
+    virtual void leaveCase(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_,
+        bool result_) override;
+    virtual void leaveSuite(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_,
+        bool result_) override;
+    virtual void leaveTest(
+        const Context& context_,
+        const std::string& name_,
+        const Parameters& params_,
+        bool result_) override;
+};
+
+/**
+ * @brief Replay serialized events into a reporter
+ *
+ * @param[in] data_ The serialized events
+ * @param[in] target_ The target reporter
+ * @param[in] context_ The OTest2 context used as a base of contexts
+ *     of the replayed events
+ * @param[in] crash_message_ A message reported if the data are truncated
+ *     (the child has crashed). The objects left open are reported as
+ *     failed then.
+ * @param[out] result_ The final result written by the forked object
+ * @return True if the final result has been found
+ */
+bool replaySerialReport(
+    const std::string& data_,
+    Reporter& target_,
+    const Context& context_,
+    const std::string& crash_message_,
+    bool& result_);
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__LIB_REPORTERSERIAL_H_ */
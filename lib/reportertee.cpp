@@ -25,6 +25,8 @@
 #include <vector>
 
 #include <assertbuffer.h>
+#include <benchmarkresult.h>
+#include <resourceusage.h>
 
 namespace OTest2 {
 
@@ -242,6 +244,49 @@ AssertBufferPtr ReporterTee::enterError(
   return buffer_;
 }
 
+void ReporterTee::reportBenchmark(
+    const Context& context_,
+    const BenchmarkResult& result_) {
+  std::for_each(
+      reporters.begin(),
+      reporters.end(),
+      std::bind(
+          &Reporter::reportBenchmark,
+          _1,
+          std::cref(context_),
+          std::cref(result_)));
+}
+
+void ReporterTee::reportResourceUsage(
+    const Context& context_,
+    const ResourceUsage& usage_) {
+  std::for_each(
+      reporters.begin(),
+      reporters.end(),
+      std::bind(
+          &Reporter::reportResourceUsage,
+          _1,
+          std::cref(context_),
+          std::cref(usage_)));
+}
+
+void ReporterTee::reportFixture(
+    const Context& context_,
+    bool start_up_,
+    int index_,
+    TimeSource::time_point begin_) {
+  std::for_each(
+      reporters.begin(),
+      reporters.end(),
+      std::bind(
+          &Reporter::reportFixture,
+          _1,
+          std::cref(context_),
+          start_up_,
+          index_,
+          begin_));
+}
+
 void ReporterTee::leaveState(
     const Context& context_,
     const std::string& name_,
@@ -0,0 +1,650 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <reportertrace.h>
+
+#include <assert.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <allocationtracker.h>
+#include <assertbufferstr.h>
+#include <benchmarkresult.h>
+#include <context.h>
+#include <objectpath.h>
+#include <parameters.h>
+#include <resourceusage.h>
+#include <timesource.h>
+#include <utils.h>
+
+namespace OTest2 {
+
+namespace {
+
+constexpr const char CATEGORY_TEST[] = "test";
+constexpr const char CATEGORY_SUITE[] = "suite";
+constexpr const char CATEGORY_CASE[] = "case";
+constexpr const char CATEGORY_STATE[] = "state";
+constexpr const char CATEGORY_FIXTURE[] = "fixture";
+constexpr const char CATEGORY_ASSERTION[] = "assertion";
+constexpr const char CATEGORY_ERROR[] = "error";
+constexpr const char CATEGORY_BENCHMARK[] = "benchmark";
+
+std::string quoteString(
+    const std::string& value_) {
+  std::ostringstream oss_;
+  oss_ << '"';
+  for(unsigned char c_ : value_) {
+    switch(c_) {
+      case '"':
+        oss_ << "\\\"";
+        break;
+      case '\\':
+        oss_ << "\\\\";
+        break;
+      case '\n':
+        oss_ << "\\n";
+        break;
+      case '\r':
+        oss_ << "\\r";
+        break;
+      case '\t':
+        oss_ << "\\t";
+        break;
+      default:
+        if(c_ < 0x20) {
+          char buffer_[8];
+          std::snprintf(buffer_, sizeof(buffer_), "\\u%04x", c_);
+          oss_ << buffer_;
+        }
+        else
+          oss_ << c_;
+        break;
+    }
+  }
+  oss_ << '"';
+  return oss_.str();
+}
+
+std::string formatDouble(
+    double value_) {
+  std::ostringstream oss_;
+  oss_ << std::setprecision(3) << std::fixed << value_;
+  return oss_.str();
+}
+
+} /* -- namespace */
+
+struct ReporterTrace::Impl : public AssertBufferListener {
+    typedef std::vector<std::pair<const char*, std::string> > Arguments;
+
+    std::string filename;
+    bool hide_location;
+    bool report_resources;
+
+    /* -- output stream and the beginning of the timeline */
+    std::ofstream file;
+    bool first_event;
+    TimeSource::time_point origin;
+
+    /* -- Lanes of the timeline (worker threads in the trace). Each lane
+     *    keeps a stack of open spans. Spans of objects running simultaneously
+     *    cannot be nested, so they are placed at different lanes. */
+    struct Span {
+        std::string path;
+        const char* category;
+    };
+    struct Lane {
+        std::vector<Span> spans;
+        TimeSource::time_point last;
+    };
+    std::vector<Lane> lanes;
+    int last_lane;
+
+    /* -- resources of the object which is just being left */
+    bool usage_valid;
+    ResourceUsage usage;
+
+    /* -- currently reported failure */
+    AssertBufferStrPtr assert_buffer;
+    std::ostringstream message;
+
+    /* -- avoid copying */
+    Impl(
+        const Impl&) = delete;
+    Impl& operator = (
+        const Impl&) = delete;
+
+    explicit Impl(
+        const std::string& file_,
+        bool hide_location_,
+        bool report_resources_);
+    virtual ~Impl();
+
+    std::string formatTime(
+        TimeSource::time_point time_) const;
+    void writeEvent(
+        const std::string& event_);
+    void writeMetadata(
+        const char* name_,
+        int lane_,
+        const std::string& value_);
+    void writeTimedEvent(
+        const std::string& name_,
+        const char* category_,
+        const char* phase_,
+        TimeSource::time_point time_,
+        int lane_,
+        const std::string& extra_,
+        const Arguments& args_);
+
+    bool isParent(
+        const Span& span_,
+        const std::string& path_,
+        bool nested_object_) const;
+    int selectLane(
+        const std::string& path_,
+        bool nested_object_,
+        TimeSource::time_point time_);
+    void touchLane(
+        int lane_,
+        TimeSource::time_point time_);
+
+    void beginSpan(
+        const Context& context_,
+        const std::string& name_,
+        const char* category_);
+    void endSpan(
+        const Context& context_,
+        const std::string& name_,
+        const char* category_,
+        bool result_);
+    void instantEvent(
+        const Context& context_,
+        const std::string& name_,
+        const char* category_,
+        const Arguments& args_);
+
+    /* -- listener of the assertion buffer */
+    virtual void assertionOpeningMessage(
+        const Context& context_,
+        const AssertBufferAssertData& data_,
+        const std::string& message_) override;
+    virtual void assertionAdditionalMessage(
+        const Context& context_,
+        const AssertBufferAssertData& data_,
+        const std::string& message_) override;
+    virtual void assertionClose(
+        const Context& context_,
+        const AssertBufferAssertData& data_) override;
+    virtual void errorOpeningMessage(
+        const Context& context_,
+        const std::string& message_) override;
+    virtual void errorAdditionalMessage(
+        const Context& context_,
+        const std::string& message_) override;
+    virtual void errorClose(
+        const Context& context_) override;
+};
+
+ReporterTrace::Impl::Impl(
+    const std::string& file_,
+    bool hide_location_,
+    bool report_resources_) :
+  filename(file_),
+  hide_location(hide_location_),
+  report_resources(report_resources_),
+  file(),
+  first_event(true),
+  origin(),
+  lanes(),
+  last_lane(-1),
+  usage_valid(false),
+  usage(),
+  assert_buffer(std::make_shared<AssertBufferStr>(this)),
+  message() {
+
+}
+
+ReporterTrace::Impl::~Impl() {
+
+}
+
+std::string ReporterTrace::Impl::formatTime(
+    TimeSource::time_point time_) const {
+  /* -- the trace format expects microseconds */
+  std::chrono::duration<double, std::micro> offset_(time_ - origin);
+  return formatDouble(offset_.count());
+}
+
+void ReporterTrace::Impl::writeEvent(
+    const std::string& event_) {
+  /* -- The events are streamed. If the test crashes the array stays
+   *    unterminated which is accepted by the trace viewers. */
+  if(first_event) {
+    file << "[\n";
+    first_event = false;
+  }
+  else
+    file << ",\n";
+  file << event_;
+}
+
+void ReporterTrace::Impl::writeMetadata(
+    const char* name_,
+    int lane_,
+    const std::string& value_) {
+  std::ostringstream oss_;
+  oss_ << "{\"name\":\"" << name_ << "\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+      << (lane_ + 1) << ",\"args\":{\"name\":" << quoteString(value_) << "}}";
+  writeEvent(oss_.str());
+}
+
+void ReporterTrace::Impl::writeTimedEvent(
+    const std::string& name_,
+    const char* category_,
+    const char* phase_,
+    TimeSource::time_point time_,
+    int lane_,
+    const std::string& extra_,
+    const Arguments& args_) {
+  std::ostringstream oss_;
+  oss_ << "{\"name\":" << quoteString(name_)
+      << ",\"cat\":\"" << category_ << "\",\"ph\":\"" << phase_
+      << "\",\"ts\":" << formatTime(time_) << extra_
+      << ",\"pid\":1,\"tid\":" << (lane_ + 1);
+  if(!args_.empty()) {
+    oss_ << ",\"args\":{";
+    bool first_(true);
+    for(const auto& arg_ : args_) {
+      if(!first_)
+        oss_ << ',';
+      first_ = false;
+      oss_ << '"' << arg_.first << "\":" << arg_.second;
+    }
+    oss_ << '}';
+  }
+  oss_ << '}';
+  writeEvent(oss_.str());
+}
+
+bool ReporterTrace::Impl::isParent(
+    const Span& span_,
+    const std::string& path_,
+    bool nested_object_) const {
+  if(span_.category == CATEGORY_STATE)
+    return false;
+
+  /* -- The states and the fixtures share the path with their object.
+   *    The nested objects extend the path of their parent. */
+  if(!nested_object_)
+    return span_.path == path_;
+  return path_.size() > span_.path.size() + 2
+      && path_.compare(0, span_.path.size(), span_.path) == 0
+      && path_.compare(span_.path.size(), 2, "::") == 0;
+}
+
+int ReporterTrace::Impl::selectLane(
+    const std::string& path_,
+    bool nested_object_,
+    TimeSource::time_point time_) {
+  /* -- Prefer the lane of the last event, then a lane whose top span is
+   *    the parent. A nested object needs the lane free at the time of
+   *    the event - reports of forked children are replayed after they
+   *    finish, so they may overlap the previous events. The states and
+   *    the fixtures always belong to the lane of their object. */
+  auto parent_lane_([this, &path_, nested_object_, time_](int lane_) {
+    const auto& lane_data_(lanes[lane_]);
+    return (!nested_object_ || lane_data_.last <= time_)
+        && !lane_data_.spans.empty()
+        && isParent(lane_data_.spans.back(), path_, nested_object_);
+  });
+  if(last_lane >= 0 && parent_lane_(last_lane))
+    return last_lane;
+  for(int i_(0); i_ < static_cast<int>(lanes.size()); ++i_) {
+    if(parent_lane_(i_))
+      return i_;
+  }
+
+  /* -- no parent, reuse an idle lane */
+  for(int i_(0); i_ < static_cast<int>(lanes.size()); ++i_) {
+    if(lanes[i_].spans.empty() && lanes[i_].last <= time_)
+      return i_;
+  }
+
+  /* -- create new lane */
+  const int lane_(lanes.size());
+  lanes.push_back({{}, time_});
+  writeMetadata("thread_name", lane_, "worker " + std::to_string(lane_ + 1));
+  return lane_;
+}
+
+void ReporterTrace::Impl::touchLane(
+    int lane_,
+    TimeSource::time_point time_) {
+  if(lanes[lane_].last < time_)
+    lanes[lane_].last = time_;
+  last_lane = lane_;
+}
+
+void ReporterTrace::Impl::beginSpan(
+    const Context& context_,
+    const std::string& name_,
+    const char* category_) {
+  const std::string path_(context_.object_path->getCurrentPath());
+  const auto time_(context_.time_source->now());
+  const int lane_(selectLane(path_, category_ != CATEGORY_STATE, time_));
+
+  writeTimedEvent(name_, category_, "B", time_, lane_, "", {});
+  lanes[lane_].spans.push_back({path_, category_});
+  touchLane(lane_, time_);
+}
+
+void ReporterTrace::Impl::endSpan(
+    const Context& context_,
+    const std::string& name_,
+    const char* category_,
+    bool result_) {
+  const std::string path_(context_.object_path->getCurrentPath());
+  const auto time_(context_.time_source->now());
+
+  /* -- find the lane of the span */
+  auto span_lane_([this, &path_, category_](int lane_) {
+    const auto& spans_(lanes[lane_].spans);
+    return !spans_.empty()
+        && spans_.back().path == path_
+        && spans_.back().category == category_;
+  });
+  int lane_(-1);
+  if(last_lane >= 0 && span_lane_(last_lane))
+    lane_ = last_lane;
+  for(int i_(0); lane_ < 0 && i_ < static_cast<int>(lanes.size()); ++i_) {
+    if(span_lane_(i_))
+      lane_ = i_;
+  }
+  if(lane_ < 0)
+    return;  /* -- not opened span, the end event would break the trace */
+
+  Arguments args_{{"result", result_ ? "\"passed\"" : "\"failed\""}};
+  if(usage_valid && category_ != CATEGORY_STATE) {
+    /* -- times are in microseconds, the memory in kilobytes */
+    args_.push_back({"cpu_time", std::to_string(usage.cpu_time)});
+    args_.push_back({"user_time", std::to_string(usage.user_time)});
+    args_.push_back({"system_time", std::to_string(usage.system_time)});
+    args_.push_back({"max_rss", std::to_string(usage.max_rss)});
+    args_.push_back({"minor_faults", std::to_string(usage.minor_faults)});
+    args_.push_back({"major_faults", std::to_string(usage.major_faults)});
+    args_.push_back({"voluntary_switches", std::to_string(usage.voluntary_switches)});
+    args_.push_back({"involuntary_switches", std::to_string(usage.involuntary_switches)});
+    if(AllocationTracker::isInstalled()) {
+      args_.push_back({"allocations", std::to_string(usage.allocations)});
+      args_.push_back({"deallocations", std::to_string(usage.deallocations)});
+      args_.push_back({"allocated_bytes", std::to_string(usage.allocated_bytes)});
+    }
+    usage_valid = false;
+  }
+
+  writeTimedEvent(name_, category_, "E", time_, lane_, "", args_);
+  lanes[lane_].spans.pop_back();
+  touchLane(lane_, time_);
+}
+
+void ReporterTrace::Impl::instantEvent(
+    const Context& context_,
+    const std::string& name_,
+    const char* category_,
+    const Arguments& args_) {
+  if(lanes.empty())
+    return;
+
+  /* -- place the event at the lane of the current object */
+  const std::string path_(context_.object_path->getCurrentPath());
+  int lane_(-1);
+  auto object_lane_([this, &path_](int lane_) {
+    const auto& spans_(lanes[lane_].spans);
+    return !spans_.empty() && spans_.back().path == path_;
+  });
+  if(last_lane >= 0 && object_lane_(last_lane))
+    lane_ = last_lane;
+  for(int i_(0); lane_ < 0 && i_ < static_cast<int>(lanes.size()); ++i_) {
+    if(object_lane_(i_))
+      lane_ = i_;
+  }
+  if(lane_ < 0)
+    lane_ = last_lane;
+
+  const auto time_(context_.time_source->now());
+  writeTimedEvent(name_, category_, "i", time_, lane_, ",\"s\":\"t\"", args_);
+  touchLane(lane_, time_);
+}
+
+void ReporterTrace::Impl::assertionOpeningMessage(
+    const Context& context_,
+    const AssertBufferAssertData& data_,
+    const std::string& message_) {
+  if(!data_.condition)
+    message << message_;
+}
+
+void ReporterTrace::Impl::assertionAdditionalMessage(
+    const Context& context_,
+    const AssertBufferAssertData& data_,
+    const std::string& message_) {
+  if(!data_.condition)
+    message << "\n" << message_;
+}
+
+void ReporterTrace::Impl::assertionClose(
+    const Context& context_,
+    const AssertBufferAssertData& data_) {
+  /* -- just the failures are reported, the passed assertions would
+   *    clutter the timeline */
+  if(!data_.condition) {
+    Arguments args_{{"message", quoteString(message.str())}};
+    if(!hide_location) {
+      args_.push_back({"file", quoteString(data_.file)});
+      args_.push_back({"line", std::to_string(data_.line)});
+    }
+    instantEvent(context_, "assertion failed", CATEGORY_ASSERTION, args_);
+  }
+  message.str("");
+}
+
+void ReporterTrace::Impl::errorOpeningMessage(
+    const Context& context_,
+    const std::string& message_) {
+  message << message_;
+}
+
+void ReporterTrace::Impl::errorAdditionalMessage(
+    const Context& context_,
+    const std::string& message_) {
+  message << "\n" << message_;
+}
+
+void ReporterTrace::Impl::errorClose(
+    const Context& context_) {
+  instantEvent(context_, "error", CATEGORY_ERROR, {{"message", quoteString(message.str())}});
+  message.str("");
+}
+
+ReporterTrace::ReporterTrace(
+    const std::string& file_,
+    bool hide_location_,
+    bool report_resources_) :
+  pimpl(new Impl(file_, hide_location_, report_resources_)) {
+
+}
+
+ReporterTrace::~ReporterTrace() {
+  odelete(pimpl);
+}
+
+void ReporterTrace::enterTest(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_) {
+  const std::string name_params_(params_.mixWithName(name_));
+
+  pimpl->file.open(pimpl->filename, std::ios::out | std::ios::trunc);
+  if(!pimpl->file)
+    throw std::runtime_error("cannot open the trace file " + pimpl->filename);
+  pimpl->first_event = true;
+  pimpl->origin = context_.time_source->now();
+  pimpl->lanes.clear();
+  pimpl->last_lane = -1;
+
+  pimpl->writeMetadata("process_name", -1, name_params_);
+  pimpl->beginSpan(context_, name_params_, CATEGORY_TEST);
+}
+
+void ReporterTrace::enterSuite(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_) {
+  pimpl->beginSpan(context_, params_.mixWithName(name_), CATEGORY_SUITE);
+}
+
+void ReporterTrace::enterCase(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_) {
+  pimpl->beginSpan(context_, params_.mixWithName(name_), CATEGORY_CASE);
+}
+
+void ReporterTrace::enterState(
+    const Context& context_,
+    const std::string& name_) {
+  pimpl->beginSpan(context_, name_, CATEGORY_STATE);
+}
+
+AssertBufferPtr ReporterTrace::enterAssert(
+    const Context& context_,
+    bool condition_,
+    const std::string& file_,
+    int lineno_) {
+  pimpl->assert_buffer->openAssertion({condition_, file_, lineno_});
+  return pimpl->assert_buffer;
+}
+
+AssertBufferPtr ReporterTrace::enterError(
+    const Context& context_) {
+  pimpl->assert_buffer->openError();
+  return pimpl->assert_buffer;
+}
+
+void ReporterTrace::reportBenchmark(
+    const Context& context_,
+    const BenchmarkResult& result_) {
+  /* -- all times are in nanoseconds per one operation */
+  pimpl->instantEvent(context_, "benchmark", CATEGORY_BENCHMARK, {
+    {"iterations", std::to_string(result_.iterations)},
+    {"samples", std::to_string(result_.samples)},
+    {"mean", formatDouble(result_.mean)},
+    {"median", formatDouble(result_.median)},
+    {"stddev", formatDouble(result_.stddev)},
+    {"mad", formatDouble(result_.mad)},
+    {"min", formatDouble(result_.min)},
+    {"max", formatDouble(result_.max)},
+  });
+}
+
+void ReporterTrace::reportResourceUsage(
+    const Context& context_,
+    const ResourceUsage& usage_) {
+  /* -- The usage is reported just before the object is left. It's stored
+   *    as arguments of the end event. */
+  if(pimpl->report_resources) {
+    pimpl->usage_valid = true;
+    pimpl->usage = usage_;
+  }
+}
+
+void ReporterTrace::reportFixture(
+    const Context& context_,
+    bool start_up_,
+    int index_,
+    TimeSource::time_point begin_) {
+  /* -- The fixtures are reported as complete events. The start-up function
+   *    is reported after it's run as it's not known in advance whether
+   *    the function exists. */
+  const std::string path_(context_.object_path->getCurrentPath());
+  const auto end_(context_.time_source->now());
+  const int lane_(pimpl->selectLane(path_, false, begin_));
+  std::chrono::duration<double, std::micro> duration_(end_ - begin_);
+  pimpl->writeTimedEvent(
+      start_up_ ? "start-up" : "tear-down",
+      CATEGORY_FIXTURE,
+      "X",
+      begin_,
+      lane_,
+      ",\"dur\":" + formatDouble(duration_.count()),
+      {{"index", std::to_string(index_)}});
+  pimpl->touchLane(lane_, end_);
+}
+
+void ReporterTrace::leaveState(
+    const Context& context_,
+    const std::string& name_,
+    bool result_) {
+  pimpl->endSpan(context_, name_, CATEGORY_STATE, result_);
+}
+
+void ReporterTrace::leaveCase(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_,
+    bool result_) {
+  pimpl->endSpan(context_, params_.mixWithName(name_), CATEGORY_CASE, result_);
+  pimpl->file.flush();
+}
+
+void ReporterTrace::leaveSuite(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_,
+    bool result_) {
+  pimpl->endSpan(context_, params_.mixWithName(name_), CATEGORY_SUITE, result_);
+  pimpl->file.flush();
+}
+
+void ReporterTrace::leaveTest(
+    const Context& context_,
+    const std::string& name_,
+    const Parameters& params_,
+    bool result_) {
+  pimpl->endSpan(context_, params_.mixWithName(name_), CATEGORY_TEST, result_);
+
+  /* -- terminate the array of the events */
+  if(!pimpl->first_event)
+    pimpl->file << "\n";
+  pimpl->file << "]\n";
+  pimpl->file.close();
+  if(!pimpl->file)
+    throw std::runtime_error("cannot write the trace file " + pimpl->filename);
+}
+
+} /* -- namespace OTest2 */
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <resourceusage.h>
+
+#include <algorithm>
+#include <sys/resource.h>
+#include <time.h>
+
+#include <allocationtracker.h>
+
+namespace OTest2 {
+
+namespace {
+
+std::int64_t toMicroseconds(
+    const struct timeval& time_) noexcept {
+  return static_cast<std::int64_t>(time_.tv_sec) * 1000000 + time_.tv_usec;
+}
+
+} /* -- namespace */
+
+ResourceUsage ResourceUsage::sample() noexcept {
+  ResourceUsage result_{};
+
+  struct timespec cpu_;
+  if(::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_) == 0)
+    result_.cpu_time =
+        static_cast<std::int64_t>(cpu_.tv_sec) * 1000000 + cpu_.tv_nsec / 1000;
+
+  struct rusage usage_;
+  if(::getrusage(RUSAGE_SELF, &usage_) == 0) {
+    result_.user_time = toMicroseconds(usage_.ru_utime);
+    result_.system_time = toMicroseconds(usage_.ru_stime);
+    result_.max_rss = usage_.ru_maxrss;
+    result_.minor_faults = usage_.ru_minflt;
+    result_.major_faults = usage_.ru_majflt;
+    result_.voluntary_switches = usage_.ru_nvcsw;
+    result_.involuntary_switches = usage_.ru_nivcsw;
+  }
+
+  const AllocationStats allocations_(AllocationTracker::sample());
+  result_.allocations = allocations_.allocations;
+  result_.deallocations = allocations_.deallocations;
+  result_.allocated_bytes = allocations_.bytes;
+
+  return result_;
+}
+
+ResourceUsage ResourceUsage::operator - (
+    const ResourceUsage& other_) const noexcept {
+  return {
+    cpu_time - other_.cpu_time,
+    user_time - other_.user_time,
+    system_time - other_.system_time,
+    std::max<std::int64_t>(max_rss - other_.max_rss, 0),
+    minor_faults - other_.minor_faults,
+    major_faults - other_.major_faults,
+    voluntary_switches - other_.voluntary_switches,
+    involuntary_switches - other_.involuntary_switches,
+    allocations - other_.allocations,
+    deallocations - other_.deallocations,
+    allocated_bytes - other_.allocated_bytes,
+  };
+}
+
+} /* -- namespace OTest2 */
@@ -27,7 +27,8 @@ namespace OTest2 {
 RunnerResult::RunnerResult() :
   running(false),
   result(false),
-  delay_ms(-1) {
+  delay_ms(-1),
+  wait_sources() {
 
 }
 
@@ -37,16 +38,29 @@ RunnerResult::RunnerResult(
     int delay_ms_) :
   running(running_),
   result(result_),
-  delay_ms(delay_ms_) {
+  delay_ms(delay_ms_),
+  wait_sources() {
   assert((running && delay_ms >= 0) || (!running_));
 
 }
 
+RunnerResult::RunnerResult(
+    int delay_ms_,
+    const WaitSources& wait_sources_) :
+  running(true),
+  result(false),
+  delay_ms(delay_ms_),
+  wait_sources(wait_sources_) {
+  assert(delay_ms >= 0);
+
+}
+
 RunnerResult::RunnerResult(
     const RunnerResult& src_) :
   running(src_.running),
   result(src_.result),
-  delay_ms(src_.delay_ms) {
+  delay_ms(src_.delay_ms),
+  wait_sources(src_.wait_sources) {
 
 }
 
@@ -59,6 +73,7 @@ void RunnerResult::swap(
   std::swap(running, r2_.running);
   std::swap(result, r2_.result);
   std::swap(delay_ms, r2_.delay_ms);
+  wait_sources.swap(r2_.wait_sources);
 }
 
 RunnerResult& RunnerResult::operator = (
@@ -77,6 +92,11 @@ int RunnerResult::getDelayMS() const {
   return delay_ms;
 }
 
+const WaitSources& RunnerResult::getWaitSources() const {
+  assert(running);
+  return wait_sources;
+}
+
 bool RunnerResult::getResult() const {
   assert(!running);
   return result;
@@ -0,0 +1,478 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <runnerinterleaved.h>
+
+#include <assert.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <poll.h>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include <cmdnextobject.h>
+#include <commandptr.h>
+#include <commandstack.h>
+#include <context.h>
+#include <objectpath.h>
+#include <reporterbuffer.h>
+#include <scheduler.h>
+#include <semanticstack.h>
+#include <timesource.h>
+#include <utils.h>
+#include <waitsource.h>
+
+namespace OTest2 {
+
+namespace {
+
+/**
+ * @brief One interleaved testing object
+ */
+struct Lane {
+    Lane* parent;
+    CommandStack command_stack;
+    SemanticStack semantic_stack;
+    ObjectPath object_path;
+    ReporterBuffer buffer;
+    Context context;
+
+    int children;           /* -- number of running spawned lanes */
+    bool joining;           /* -- the lane waits for its children */
+    bool resumed;           /* -- the lane has just finished a wait */
+    WaitSources wait_sources;
+
+    /* -- avoid copying */
+    Lane(
+        const Lane&) = delete;
+    Lane& operator =(
+        const Lane&) = delete;
+
+    /**
+     * @param parent_ The parent lane. Null for the root lane.
+     * @param reporter_ The reporter of the root lane. The other lanes
+     *     report into their buffer.
+     */
+    explicit Lane(
+        Lane* parent_,
+        const std::string& path_,
+        TimeSource* time_source_,
+        ExcCatcher* exc_catcher_,
+        Reporter* reporter_,
+        TestMarkFactory* test_mark_factory_,
+        TestMarkStorage* test_mark_storage_,
+        UserData* user_data_,
+        Scheduler* scheduler_) :
+      parent(parent_),
+      command_stack(),
+      semantic_stack(),
+      object_path(path_),
+      buffer(),
+      context(
+          &command_stack,
+          &semantic_stack,
+          &object_path,
+          time_source_,
+          exc_catcher_,
+          (reporter_ != nullptr) ? reporter_ : &buffer,
+          test_mark_factory_,
+          test_mark_storage_,
+          user_data_,
+          scheduler_),
+      children(0),
+      joining(false),
+      resumed(false),
+      wait_sources() {
+      /* -- the object passes by default */
+      semantic_stack.push(true);
+    }
+};
+
+/**
+ * @brief Wake-up time of a waiting lane
+ */
+struct Timer {
+    TimeSource::time_point wake_up;
+    std::uint64_t wait_id;
+
+    bool operator > (
+        const Timer& t2_) const noexcept {
+      if(wake_up != t2_.wake_up)
+        return wake_up > t2_.wake_up;
+      /* -- the lanes waking up at the same time keep their order */
+      return wait_id > t2_.wait_id;
+    }
+};
+
+} /* -- namespace */
+
+struct RunnerInterleaved::Impl : public Scheduler {
+  public:
+    RunnerInterleaved* owner;
+
+    TimeSource* time_source;
+    ExcCatcher* exc_catcher;
+    TestMarkFactory* test_mark_factory;
+    TestMarkStorage* test_mark_storage;
+    UserData* user_data;
+
+    std::map<const Lane*, std::unique_ptr<Lane>> lanes;
+    Lane* root;
+    Lane* current;
+
+    /* -- scheduling of the lanes */
+    std::deque<Lane*> ready;
+    std::uint64_t last_wait_id;
+    std::map<std::uint64_t, Lane*> waiting;
+    std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> timers;
+
+    /* -- result of the test */
+    bool finished;
+    bool result;
+
+    /* -- avoid copying */
+    Impl(
+        const Impl&) = delete;
+    Impl& operator =(
+        const Impl&) = delete;
+
+    explicit Impl(
+        RunnerInterleaved* owner_,
+        TimeSource* time_source_,
+        ExcCatcher* exc_catcher_,
+        Reporter* reporter_,
+        TestMarkFactory* test_mark_factory_,
+        TestMarkStorage* test_mark_storage_,
+        UserData* user_data_,
+        ScenarioIterPtr test_scenario_);
+    virtual ~Impl();
+
+    Lane* createLane(
+        Lane* parent_,
+        Reporter* reporter_);
+    void wakeUpTimers();
+    void wakeUpEvents();
+    void runLane(
+        Lane* lane_);
+    void waitLane(
+        Lane* lane_,
+        int delay_,
+        const WaitSources& wait_sources_);
+    void finishLane(
+        Lane* lane_);
+    int getDelay();
+    WaitSources getWaitSources() const;
+
+    /* -- scheduler interface */
+    virtual const Context& spawnObject(
+        const Context& context_) override;
+    virtual void joinObjects(
+        const Context& context_) override;
+};
+
+RunnerInterleaved::Impl::Impl(
+    RunnerInterleaved* owner_,
+    TimeSource* time_source_,
+    ExcCatcher* exc_catcher_,
+    Reporter* reporter_,
+    TestMarkFactory* test_mark_factory_,
+    TestMarkStorage* test_mark_storage_,
+    UserData* user_data_,
+    ScenarioIterPtr test_scenario_) :
+  owner(owner_),
+  time_source(time_source_),
+  exc_catcher(exc_catcher_),
+  test_mark_factory(test_mark_factory_),
+  test_mark_storage(test_mark_storage_),
+  user_data(user_data_),
+  lanes(),
+  root(nullptr),
+  current(nullptr),
+  ready(),
+  last_wait_id(0),
+  waiting(),
+  timers(),
+  finished(false),
+  result(false) {
+  assert(reporter_ != nullptr);
+  assert(exc_catcher != nullptr);
+
+  /* -- the root lane reports directly into the reporter */
+  root = createLane(nullptr, reporter_);
+
+  /* -- schedule start of the test */
+  root->command_stack.pushCommand(
+      std::make_shared<CmdNextObject>(test_scenario_, nullptr));
+}
+
+RunnerInterleaved::Impl::~Impl() {
+
+}
+
+Lane* RunnerInterleaved::Impl::createLane(
+    Lane* parent_,
+    Reporter* reporter_) {
+  std::string path_;
+  if(parent_ != nullptr)
+    path_ = parent_->object_path.getCurrentPath();
+
+  std::unique_ptr<Lane> lane_(new Lane(
+      parent_,
+      path_,
+      time_source,
+      exc_catcher,
+      reporter_,
+      test_mark_factory,
+      test_mark_storage,
+      user_data,
+      this));
+  Lane* ptr_(lane_.get());
+  lanes.emplace(ptr_, std::move(lane_));
+  ready.push_back(ptr_);
+  return ptr_;
+}
+
+void RunnerInterleaved::Impl::wakeUpTimers() {
+  const auto now_(time_source->now());
+  while(!timers.empty()) {
+    const Timer timer_(timers.top());
+    auto iter_(waiting.find(timer_.wait_id));
+    if(iter_ != waiting.end()) {
+      if(timer_.wake_up > now_)
+        break;
+
+      /* -- the delay has elapsed */
+      Lane* lane_((*iter_).second);
+      waiting.erase(iter_);
+      lane_->resumed = true;
+      lane_->wait_sources.clear();
+      ready.push_back(lane_);
+    }
+    /* -- else the lane has been already woken up by an event */
+    timers.pop();
+  }
+}
+
+void RunnerInterleaved::Impl::wakeUpEvents() {
+  /* -- check the wait sources without blocking */
+  std::vector<struct pollfd> fds_;
+  std::vector<std::uint64_t> ids_;
+  for(const auto& wait_ : waiting) {
+    for(const auto& source_ : wait_.second->wait_sources) {
+      short events_(0);
+      if(source_.getEvents() & WaitSource::READ)
+        events_ |= POLLIN;
+      if(source_.getEvents() & WaitSource::WRITE)
+        events_ |= POLLOUT;
+      fds_.push_back({source_.getFD(), events_, 0});
+      ids_.push_back(wait_.first);
+    }
+  }
+  if(fds_.empty() || ::poll(fds_.data(), fds_.size(), 0) <= 0)
+    return;
+
+  /* -- resume the lanes with a ready source. The timers are left
+   *    in the heap, they're dropped when they elapse. */
+  for(std::size_t i_(0); i_ < fds_.size(); ++i_) {
+    if(fds_[i_].revents == 0)
+      continue;
+    auto iter_(waiting.find(ids_[i_]));
+    if(iter_ != waiting.end()) {
+      Lane* lane_((*iter_).second);
+      waiting.erase(iter_);
+      lane_->resumed = true;
+      lane_->wait_sources.clear();
+      ready.push_back(lane_);
+    }
+  }
+}
+
+void RunnerInterleaved::Impl::runLane(
+    Lane* lane_) {
+  current = lane_;
+  while(!lane_->command_stack.empty()) {
+    /* -- the lane is parked until its children finish */
+    if(lane_->joining) {
+      current = nullptr;
+      return;
+    }
+
+    /* -- check whether the lane should wait. The first command after
+     *    a wait runs immediately. */
+    CommandPtr cmd_(lane_->command_stack.topCommand());
+    int delay_(0);
+    WaitSources wait_sources_;
+    if(!lane_->resumed
+        && cmd_->shouldWait(lane_->context, delay_, wait_sources_)) {
+      assert(delay_ >= 0);
+      waitLane(lane_, delay_, wait_sources_);
+      current = nullptr;
+      return;
+    }
+
+    /* -- run the command */
+    lane_->resumed = false;
+    lane_->command_stack.popCommand();
+    cmd_->run(lane_->context);
+  }
+  current = nullptr;
+
+  finishLane(lane_);
+}
+
+void RunnerInterleaved::Impl::waitLane(
+    Lane* lane_,
+    int delay_,
+    const WaitSources& wait_sources_) {
+  const std::uint64_t wait_id_(++last_wait_id);
+  lane_->wait_sources = wait_sources_;
+  waiting.emplace(wait_id_, lane_);
+  timers.push({
+      time_source->now() + std::chrono::milliseconds(delay_),
+      wait_id_});
+}
+
+void RunnerInterleaved::Impl::finishLane(
+    Lane* lane_) {
+  /* -- there is only one value meant the result of the object */
+  assert(lane_->semantic_stack.isFinished());
+  assert(lane_->children == 0);
+
+  if(lane_ == root) {
+    finished = true;
+    result = lane_->semantic_stack.top();
+    return;
+  }
+
+  /* -- pass the report and the result to the parent */
+  Lane* parent_(lane_->parent);
+  lane_->buffer.replay(*parent_->context.reporter, parent_->context);
+  parent_->semantic_stack.setTop(
+      parent_->semantic_stack.top() && lane_->semantic_stack.top());
+
+  /* -- wake up the parent if it's the last child */
+  --parent_->children;
+  if(parent_->children == 0 && parent_->joining) {
+    parent_->joining = false;
+    ready.push_back(parent_);
+  }
+
+  lanes.erase(lane_);
+}
+
+int RunnerInterleaved::Impl::getDelay() {
+  /* -- drop timers of the lanes woken up by events */
+  while(!timers.empty()
+      && waiting.find(timers.top().wait_id) == waiting.end()) {
+    timers.pop();
+  }
+  assert(!timers.empty());
+
+  /* -- round the delay up, the lane mustn't wake up too early */
+  const auto rest_(timers.top().wake_up - time_source->now());
+  if(rest_ <= TimeSource::duration::zero())
+    return 0;
+  auto delay_(std::chrono::duration_cast<std::chrono::milliseconds>(rest_));
+  if(delay_ < rest_)
+    ++delay_;
+  return static_cast<int>(delay_.count());
+}
+
+WaitSources RunnerInterleaved::Impl::getWaitSources() const {
+  WaitSources sources_;
+  for(const auto& wait_ : waiting)
+    sources_.insert(
+        sources_.end(),
+        wait_.second->wait_sources.begin(),
+        wait_.second->wait_sources.end());
+  return sources_;
+}
+
+const Context& RunnerInterleaved::Impl::spawnObject(
+    const Context& context_) {
+  assert(current != nullptr && &current->context == &context_);
+
+  ++current->children;
+  return createLane(current, nullptr)->context;
+}
+
+void RunnerInterleaved::Impl::joinObjects(
+    const Context& context_) {
+  assert(current != nullptr && &current->context == &context_);
+
+  current->joining = current->children > 0;
+}
+
+RunnerInterleaved::RunnerInterleaved(
+    TimeSource* time_source_,
+    ExcCatcher* exc_catcher_,
+    Reporter* reporter_,
+    TestMarkFactory* test_mark_factory_,
+    TestMarkStorage* test_mark_storage_,
+    UserData* user_data_,
+    ScenarioIterPtr test_scenario_) :
+  pimpl(new Impl(
+      this,
+      time_source_,
+      exc_catcher_,
+      reporter_,
+      test_mark_factory_,
+      test_mark_storage_,
+      user_data_,
+      test_scenario_)) {
+
+}
+
+RunnerInterleaved::~RunnerInterleaved() {
+  odelete(pimpl);
+}
+
+RunnerResult RunnerInterleaved::runNext() {
+  while(!pimpl->finished) {
+    /* -- run the ready lanes */
+    pimpl->wakeUpTimers();
+    if(pimpl->ready.empty())
+      pimpl->wakeUpEvents();
+    if(!pimpl->ready.empty()) {
+      Lane* lane_(pimpl->ready.front());
+      pimpl->ready.pop_front();
+      pimpl->runLane(lane_);
+      continue;
+    }
+
+    /* -- All lanes wait. If the time source is virtual and there is
+     *    no event to wait for, the time is moved. */
+    const int delay_(pimpl->getDelay());
+    WaitSources wait_sources_(pimpl->getWaitSources());
+    if(!wait_sources_.empty())
+      return RunnerResult(delay_, wait_sources_);
+    if(!pimpl->time_source->fastForward(std::chrono::milliseconds(delay_)))
+      return RunnerResult(true, false, delay_);
+  }
+
+  /* -- no other work - get the test result and stop */
+  return RunnerResult(false, pimpl->result, -1);
+}
+
+} /* namespace OTest2 */
@@ -20,6 +20,7 @@
 #include <runnerordinary.h>
 
 #include <assert.h>
+#include <chrono>
 #include <string>
 
 #include <cmdnextobject.h>
@@ -28,7 +29,9 @@
 #include <context.h>
 #include <objectpath.h>
 #include <semanticstack.h>
+#include <timesource.h>
 #include <utils.h>
+#include <waitsource.h>
 
 namespace OTest2 {
 
@@ -81,7 +84,8 @@ RunnerOrdinary::Impl::Impl(
       reporter_,
       test_mark_factory_,
       test_mark_storage_,
-      user_data_) {
+      user_data_,
+      nullptr) {
   assert(context.reporter != nullptr);
   assert(context.exception_catcher != nullptr);
 
@@ -127,9 +131,18 @@ RunnerResult RunnerOrdinary::runNext() {
 
     /* -- check whether we should get back into the main loop */
     int delay_(0);
-    if(!first_command_ && cmd_->shouldWait(pimpl->context, delay_)) {
+    WaitSources wait_sources_;
+    if(!first_command_
+        && cmd_->shouldWait(pimpl->context, delay_, wait_sources_)) {
       assert(delay_ >= 0);
-      return RunnerResult(true, false, delay_);
+      if(!wait_sources_.empty())
+        return RunnerResult(delay_, wait_sources_);
+
+      /* -- The only work waits for the delay. If the time source is
+       *    virtual, the time is moved and the command runs immediately. */
+      if(!pimpl->context.time_source->fastForward(
+          std::chrono::milliseconds(delay_)))
+        return RunnerResult(true, false, delay_);
     }
 
     /* -- run the command */
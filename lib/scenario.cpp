@@ -28,4 +28,12 @@ Scenario::~Scenario() {
 
 }
 
+bool Scenario::forkChildren() const noexcept {
+  return false;
+}
+
+bool Scenario::parallelRuns() const noexcept {
+  return false;
+}
+
 } /* -- namespace OTest2 */
@@ -21,6 +21,7 @@
 #include <assert.h>
 #include <vector>
 
+#include <const.h>
 #include <context.h>
 #include <objectpath.h>
 #include <objectrepeater.h>
@@ -206,6 +207,10 @@ ScenarioIterPtr ScenarioCase::getChildren() const {
   return ScenarioIterPtr();
 }
 
+bool ScenarioCase::parallelRuns() const noexcept {
+  return pimpl->tags.findTag(PARALLEL_RUNS_TAG);
+}
+
 struct ScenarioCaseBuilder::Impl {
     ScenarioPtr scenario;
     ScenarioCase* scenario_case;
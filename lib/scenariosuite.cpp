@@ -24,6 +24,7 @@
 #include <memory>
 #include <vector>
 
+#include <const.h>
 #include <context.h>
 #include <objectpath.h>
 #include <objectrepeater.h>
@@ -136,6 +137,14 @@ ScenarioIterPtr ScenarioSuite::getChildren() const {
   return std::make_shared<ScenarioIterContainer>(pimpl->children);
 }
 
+bool ScenarioSuite::forkChildren() const noexcept {
+  return pimpl->tags.findTag(FORK_CASES_TAG);
+}
+
+bool ScenarioSuite::parallelRuns() const noexcept {
+  return pimpl->tags.findTag(PARALLEL_RUNS_TAG);
+}
+
 void ScenarioSuite::appendScenario(
     ScenarioPtr scenario_) {
   assert(scenario_ != nullptr);
@@ -23,9 +23,12 @@
 #include <string>
 
 #include <caseordinaryptr.h>
+#include <cmdrunstate.h>
 #include <cmdstate.h>
+#include <commandptr.h>
 #include <commandstack.h>
 #include <context.h>
+#include <coroutineframe.h>
 #include <objectpath.h>
 #include "runcode.h"
 #include <utils.h>
@@ -41,6 +44,8 @@ struct StateGenerated::Impl {
     ObjectPath section;
 
     CaseOrdinaryPtr parent;
+    std::unique_ptr<CoroutineFrame> coroutine;
+    CommandPtr pending_switch;
 
     /* -- avoid copying */
     Impl(
@@ -54,6 +59,9 @@ struct StateGenerated::Impl {
         const std::string& name_,
         const std::string& section_path_);
     ~Impl();
+
+    void finishCoroutine(
+        const Context& context_);
 };
 
 StateGenerated::Impl::Impl(
@@ -65,7 +73,9 @@ StateGenerated::Impl::Impl(
   context(&context_),
   name(name_),
   section(section_path_),
-  parent() {
+  parent(),
+  coroutine(),
+  pending_switch() {
 
 }
 
@@ -73,6 +83,17 @@ StateGenerated::Impl::~Impl() {
 
 }
 
+void StateGenerated::Impl::finishCoroutine(
+    const Context& context_) {
+  coroutine.reset();
+
+  /* -- the state switch requested by the coroutine is done now */
+  if(pending_switch != nullptr) {
+    context_.command_stack->replaceCommand(pending_switch);
+    pending_switch.reset();
+  }
+}
+
 StateGenerated::StateGenerated(
     const Context& context_,
     const std::string& name_,
@@ -97,11 +118,30 @@ void StateGenerated::executeState(
 
   pimpl->parent = parent_;
   runUserCode(context_, [this](const Context& context_) {
-    runState(context_);
+    /* -- A coroutine state function just attaches its frame. The frame
+     *    is resumed then until the coroutine finishes. */
+    if(pimpl->coroutine == nullptr)
+      runState(context_);
+    if(pimpl->coroutine != nullptr) {
+      bool finished_(true);
+      try {
+        finished_ = pimpl->coroutine->resumeFrame();
+      }
+      catch(...) {
+        pimpl->finishCoroutine(context_);
+        throw;
+      }
+      if(finished_)
+        pimpl->finishCoroutine(context_);
+    }
   });
   pimpl->parent = CaseOrdinaryPtr();
 }
 
+bool StateGenerated::isSuspended() const {
+  return pimpl->coroutine != nullptr;
+}
+
 const Context& StateGenerated::otest2Context() const {
   return *pimpl->context;
 }
@@ -109,12 +149,43 @@ const Context& StateGenerated::otest2Context() const {
 void StateGenerated::switchState(
     const Context& context_,
     const std::string& name_,
-    int delay_) {
+    int delay_,
+    const WaitSources& wait_sources_) {
   assert(pimpl->parent != nullptr && !name_.empty() && delay_ >= 0);
 
-  /* -- schedule the commands */
+  /* -- Schedule the commands. A running coroutine may be suspended yet,
+   *    so the switch is postponed until the coroutine finishes. */
+  CommandPtr command_(std::make_shared<CmdState>(
+      pimpl->parent, name_, delay_, wait_sources_));
+  if(pimpl->coroutine != nullptr)
+    pimpl->pending_switch = command_;
+  else
+    context_.command_stack->replaceCommand(command_);
+}
+
+void StateGenerated::attachCoroutine(
+    std::unique_ptr<CoroutineFrame> frame_) {
+  assert(frame_ != nullptr && pimpl->coroutine == nullptr);
+  pimpl->coroutine = std::move(frame_);
+}
+
+void StateGenerated::suspendCoroutine(
+    const Context& context_,
+    int delay_,
+    const WaitSources& wait_sources_) {
+  assert(pimpl->parent != nullptr && pimpl->coroutine != nullptr && delay_ >= 0);
+
+  /* -- Schedule the resumption directly. The state is owned by its parent
+   *    case, hence the aliasing pointer keeps it alive and no lookup
+   *    in the state registry is needed. */
   context_.command_stack->replaceCommand(
-      std::make_shared<CmdState>(pimpl->parent, name_, delay_));
+      std::make_shared<CmdRunState>(
+          pimpl->parent,
+          StateOrdinaryPtr(pimpl->parent, this),
+          true,
+          delay_,
+          wait_sources_,
+          true));
 }
 
 bool StateGenerated::isTestSectionActive(
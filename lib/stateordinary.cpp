@@ -38,12 +38,17 @@ StateOrdinary::~StateOrdinary() {
 
 }
 
+bool StateOrdinary::isSuspended() const {
+  return false;
+}
+
 void StateOrdinary::scheduleRun(
     const Context& context_,
     CaseOrdinaryPtr parent_,
     StatePtr this_ptr_,
     bool wait_,
-    int delay_) {
+    int delay_,
+    const WaitSources& wait_sources_) {
   assert(this_ptr_.get() == this);
 
   /* -- schedule the commands */
@@ -52,7 +57,9 @@ void StateOrdinary::scheduleRun(
           parent_,
           std::static_pointer_cast<StateOrdinary>(this_ptr_),
           wait_,
-          delay_));
+          delay_,
+          wait_sources_,
+          false));
 }
 
 } /* namespace OTest2 */
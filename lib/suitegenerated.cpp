@@ -24,7 +24,9 @@
 #include <string>
 #include <vector>
 
+#include <cmdforkobject.h>
 #include <cmdnextobject.h>
+#include <cmdspawnobjects.h>
 #include <commandstack.h>
 #include <context.h>
 #include <fcemarshaler.h>
@@ -106,8 +108,17 @@ void SuiteGenerated::scheduleBody(
     const Context& context_,
     ScenarioPtr scenario_,
     ObjectPtr me_) {
-  context_.command_stack->pushCommand(
-      std::make_shared<CmdNextObject>(scenario_->getChildren(), me_));
+  /* -- The cases run one by one, each of them in a forked process
+   *    or they're interleaved by the scheduler. */
+  if(scenario_->forkChildren())
+    context_.command_stack->pushCommand(
+        std::make_shared<CmdForkObject>(scenario_->getChildren(), me_));
+  else if(context_.scheduler != nullptr)
+    context_.command_stack->pushCommand(
+        std::make_shared<CmdSpawnObjects>(scenario_->getChildren(), me_));
+  else
+    context_.command_stack->pushCommand(
+        std::make_shared<CmdNextObject>(scenario_->getChildren(), me_));
 }
 
 void SuiteGenerated::tearDownObject(
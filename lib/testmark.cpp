@@ -30,6 +30,13 @@ namespace OTest2 {
 
 namespace {
 
+bool isSameRecord(
+    const TestMark::LinearizedRecord& left_,
+    const TestMark::LinearizedRecord& right_) {
+  return left_.me->isEqualValueHash(*right_.me)
+      && left_.label == right_.label;
+}
+
 class TestMarkScore {
   public:
     std::tuple<bool, int> scoreSub(
@@ -39,11 +46,7 @@ class TestMarkScore {
         const TestMark::LinearizedRecord right_[],
         int right_index_) const {
       /* -- check equality of both nodes */
-      const TestMark::LinearizedRecord& lrec_(left_[left_index_]);
-      const TestMark::LinearizedRecord& rrec_(right_[right_index_]);
-      auto same_(lrec_.me->isEqualValueHash(*rrec_.me)
-          && lrec_.label == rrec_.label);
-      if(same_)
+      if(isSameRecord(left_[left_index_], right_[right_index_]))
         return std::make_tuple(true, 1);
       else
         return std::make_tuple(false, -1);
@@ -147,10 +150,36 @@ void TestMark::computeDiff(
     std::vector<LinearizedRecord>& left_result_,
     std::vector<LinearizedRecord>& right_result_,
     DiffLogBuilder& diff_) {
+  /* -- Skip the common head and tail of the sequences. The packed arrays
+   *    produce long sequences of items which mostly match, so the quadratic
+   *    diff algorithm runs just over the changed part. */
+  std::size_t head_(0);
+  while(head_ < left_.size() && head_ < right_.size()
+      && isSameRecord(left_[head_], right_[head_])) {
+    ++head_;
+  }
+  std::size_t tail_(0);
+  while(head_ + tail_ < left_.size() && head_ + tail_ < right_.size()
+      && isSameRecord(
+          left_[left_.size() - tail_ - 1],
+          right_[right_.size() - tail_ - 1])) {
+    ++tail_;
+  }
+
   /* -- compute difference of current level */
   DiffLogArray diff_array_;
   DiffLogBuilderArray diff_level_(&diff_array_);
-  hirschbergDiff(left_, right_, diff_level_, TestMarkScore());
+  hirschbergDiff(
+      left_.data() + head_,
+      left_.size() - head_ - tail_,
+      right_.data() + head_,
+      right_.size() - head_ - tail_,
+      diff_level_,
+      TestMarkScore());
+  for(auto& diff_rec_ : diff_array_) {
+    diff_rec_.left_index += head_;
+    diff_rec_.right_index += head_;
+  }
 
   int left_index_(0);
   int right_index_(0);
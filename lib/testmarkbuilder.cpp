@@ -22,8 +22,11 @@
 #include <vector>
 
 #include <testmarkbool.h>
+#include <testmarkbytes.h>
 #include <testmarkfloat.h>
+#include <testmarkfloatarray.h>
 #include <testmarkint.h>
+#include <testmarkintarray.h>
 #include <testmarklist.h>
 #include <testmarkmap.h>
 #include <testmarknull.h>
@@ -155,6 +158,26 @@ void TestMarkBuilder::appendString(
   pimpl->appendItem(new TestMarkString(value_));
 }
 
+void TestMarkBuilder::appendIntArray(
+    std::vector<std::int64_t> values_) {
+  pimpl->appendItem(new TestMarkIntArray(std::move(values_)));
+}
+
+void TestMarkBuilder::appendFloatArray(
+    std::vector<long double> values_) {
+  pimpl->appendItem(new TestMarkFloatArray(std::move(values_)));
+}
+
+void TestMarkBuilder::appendBytes(
+    const void* data_,
+    std::size_t size_) {
+  assert(data_ != nullptr || size_ == 0);
+
+  const std::uint8_t* bytes_(static_cast<const std::uint8_t*>(data_));
+  pimpl->appendItem(
+      new TestMarkBytes(std::vector<std::uint8_t>(bytes_, bytes_ + size_)));
+}
+
 void TestMarkBuilder::openContainerImpl(
     std::unique_ptr<typename TestMarkBuilder::Container>&& container_) {
   pimpl->stack.emplace_back("", std::move(container_));
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <testmarkbytes.h>
+
+#include <algorithm>
+#include <assert.h>
+
+#include <testmarkhash.h>
+#include <testmarkin.h>
+#include <testmarkout.h>
+#include <testmarkstring.h>
+
+namespace OTest2 {
+
+namespace {
+
+const char SERIALIZE_TYPE_MARK[] = "ot2:bytes";
+constexpr std::size_t ROW_LENGTH(16);
+
+} /* -- namespace */
+
+TestMarkBytes::TestMarkBytes(
+    std::vector<std::uint8_t> values_) :
+  TestMarkBytes("", std::move(values_)) {
+
+}
+
+TestMarkBytes::TestMarkBytes(
+    const std::string& prefix_,
+    std::vector<std::uint8_t> values_) :
+  TestMarkPrefix(SERIALIZE_TYPE_MARK, prefix_),
+  values(std::move(values_)),
+  items() {
+  hashValues();
+}
+
+TestMarkBytes::TestMarkBytes(
+    const CtorMark* ctor_mark_) :
+  TestMarkPrefix(ctor_mark_, SERIALIZE_TYPE_MARK),
+  values(),
+  items() {
+
+}
+
+TestMarkBytes::~TestMarkBytes() {
+
+}
+
+const char* TestMarkBytes::typeMark() {
+  return SERIALIZE_TYPE_MARK;
+}
+
+void TestMarkBytes::hashValues() {
+  hash.addData(values.data(), values.size());
+  hash.addTerminator();
+}
+
+const std::vector<TestMarkPtr>& TestMarkBytes::getItems() const {
+  /* -- The nested marks are created lazily just for diffing and printing.
+   *    Each row keeps ROW_LENGTH bytes in the hexadecimal form. */
+  const std::size_t rows_((values.size() + ROW_LENGTH - 1) / ROW_LENGTH);
+  if(items.size() != rows_) {
+    static const char digits_[] = "0123456789abcdef";
+    items.clear();
+    items.reserve(rows_);
+    for(std::size_t begin_(0); begin_ < values.size(); begin_ += ROW_LENGTH) {
+      const std::size_t end_(std::min(begin_ + ROW_LENGTH, values.size()));
+      std::string row_;
+      for(std::size_t i_(begin_); i_ < end_; ++i_) {
+        if(i_ != begin_)
+          row_ += ' ';
+        row_ += digits_[values[i_] >> 4];
+        row_ += digits_[values[i_] & 0x0f];
+      }
+      items.push_back(std::make_shared<TestMarkString>(row_));
+    }
+  }
+  return items;
+}
+
+bool TestMarkBytes::doIsEqualPrefixed(
+    const TestMark& other_,
+    long double precision_) const {
+  const TestMarkBytes* o_(static_cast<const TestMarkBytes*>(&other_));
+  return values == o_->values;
+}
+
+void TestMarkBytes::doDiffArray(
+    int level_,
+    std::vector<LinearizedRecord>& array_) const {
+  for(const auto& item_ : getItems()) {
+    array_.push_back({level_, item_.get(), ""});
+  }
+}
+
+void TestMarkBytes::doLinearizedMark(
+    int level_,
+    const std::string& label_,
+    std::vector<LinearizedRecord>& array_) const {
+  array_.push_back({level_, this, label_});
+  for(const auto& item_ : getItems()) {
+    item_->doLinearizedMark(level_ + 1, "", array_);
+  }
+}
+
+const char* TestMarkBytes::getParenthesis() const {
+  return "[]";
+}
+
+void TestMarkBytes::serializeItems(
+    TestMarkOut& serializer_) const {
+  serializer_.writeString(std::string(values.begin(), values.end()));
+}
+
+void TestMarkBytes::deserializeItems(
+    TestMarkFactory& factory_,
+    TestMarkIn& deserializer_) {
+  const std::string data_(deserializer_.readString());
+  values.assign(data_.begin(), data_.end());
+  hashValues();
+}
+
+} /* namespace OTest2 */
@@ -24,12 +24,16 @@
 
 #include <exctestmarkin.h>
 #include <testmarkbool.h>
+#include <testmarkbytes.h>
 #include <testmarkfloat.h>
+#include <testmarkfloatarray.h>
 #include <testmarkint.h>
+#include <testmarkintarray.h>
 #include <testmarklist.h>
 #include <testmarkmap.h>
 #include <testmarknull.h>
 #include <testmarkstring.h>
+#include <testmarktiming.h>
 #include <utils.h>
 
 namespace OTest2 {
@@ -73,6 +77,10 @@ TestMarkFactory::TestMarkFactory() :
   registerMark<TestMarkString>();
   registerMark<TestMarkList>();
   registerMark<TestMarkMap>();
+  registerMark<TestMarkIntArray>();
+  registerMark<TestMarkFloatArray>();
+  registerMark<TestMarkBytes>();
+  registerMark<TestMarkTiming>();
 }
 
 TestMarkFactory::~TestMarkFactory() {
@@ -81,10 +89,15 @@ TestMarkFactory::~TestMarkFactory() {
 
 TestMarkPtr TestMarkFactory::createMark(
     const std::string& typemark_) {
+  return (*getConstructor(typemark_))();
+}
+
+const std::function<TestMarkPtr()>* TestMarkFactory::getConstructor(
+    const std::string& typemark_) const {
   auto iter_(pimpl->ctors.find(typemark_));
   if(iter_ == pimpl->ctors.end())
     throw ExcTestMarkIn("unknown type mark '" + typemark_ + "'");
-  return (*iter_).second();
+  return &(*iter_).second;
 }
 
 } /* -- namespace OTest2 */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <testmarkfloatarray.h>
+
+#include <assert.h>
+#include <cmath>
+
+#include <testmarkfloat.h>
+#include <testmarkhash.h>
+#include <testmarkin.h>
+#include <testmarkout.h>
+
+namespace OTest2 {
+
+namespace {
+
+const char SERIALIZE_TYPE_MARK[] = "ot2:floatarray";
+
+} /* -- namespace */
+
+TestMarkFloatArray::TestMarkFloatArray(
+    std::vector<long double> values_) :
+  TestMarkFloatArray("", std::move(values_)) {
+
+}
+
+TestMarkFloatArray::TestMarkFloatArray(
+    const std::string& prefix_,
+    std::vector<long double> values_) :
+  TestMarkPrefix(SERIALIZE_TYPE_MARK, prefix_),
+  values(std::move(values_)),
+  items() {
+  hashValues();
+}
+
+TestMarkFloatArray::TestMarkFloatArray(
+    const CtorMark* ctor_mark_) :
+  TestMarkPrefix(ctor_mark_, SERIALIZE_TYPE_MARK),
+  values(),
+  items() {
+
+}
+
+TestMarkFloatArray::~TestMarkFloatArray() {
+
+}
+
+const char* TestMarkFloatArray::typeMark() {
+  return SERIALIZE_TYPE_MARK;
+}
+
+void TestMarkFloatArray::hashValues() {
+  /* -- The long double type may contain padding bytes with undefined
+   *    content. Hence, the values are hashed in the binary64 form. */
+  std::vector<double> block_(values.begin(), values.end());
+  hash.addData(
+      reinterpret_cast<const std::uint8_t*>(block_.data()),
+      block_.size() * sizeof(double));
+  hash.addTerminator();
+}
+
+const std::vector<TestMarkPtr>& TestMarkFloatArray::getItems() const {
+  /* -- the nested marks are created lazily just for diffing and printing */
+  if(items.size() != values.size()) {
+    items.clear();
+    items.reserve(values.size());
+    for(long double value_ : values)
+      items.push_back(std::make_shared<TestMarkFloat>(value_));
+  }
+  return items;
+}
+
+bool TestMarkFloatArray::doIsEqualPrefixed(
+    const TestMark& other_,
+    long double precision_) const {
+  const TestMarkFloatArray* o_(static_cast<const TestMarkFloatArray*>(&other_));
+  if(values.size() != o_->values.size())
+    return false;
+  for(std::size_t i_(0); i_ < values.size(); ++i_)
+    if(!(std::abs(values[i_] - o_->values[i_]) <= precision_))
+      return false;
+  return true;
+}
+
+void TestMarkFloatArray::doDiffArray(
+    int level_,
+    std::vector<LinearizedRecord>& array_) const {
+  for(const auto& item_ : getItems()) {
+    array_.push_back({level_, item_.get(), ""});
+  }
+}
+
+void TestMarkFloatArray::doLinearizedMark(
+    int level_,
+    const std::string& label_,
+    std::vector<LinearizedRecord>& array_) const {
+  array_.push_back({level_, this, label_});
+  for(const auto& item_ : getItems()) {
+    item_->doLinearizedMark(level_ + 1, "", array_);
+  }
+}
+
+const char* TestMarkFloatArray::getParenthesis() const {
+  return "[]";
+}
+
+void TestMarkFloatArray::serializeItems(
+    TestMarkOut& serializer_) const {
+  serializer_.writeFloatArray(values);
+}
+
+void TestMarkFloatArray::deserializeItems(
+    TestMarkFactory& factory_,
+    TestMarkIn& deserializer_) {
+  deserializer_.readFloatArray(values);
+  hashValues();
+}
+
+} /* namespace OTest2 */
@@ -21,6 +21,7 @@
 
 #include <string>
 
+#include <exctestmarkin.h>
 #include <testmark.h>
 #include <testmarkfactory.h>
 
@@ -34,11 +35,33 @@ TestMarkIn::~TestMarkIn() {
 
 }
 
+void TestMarkIn::readIntArray(
+    std::vector<std::int64_t>& values_) {
+  const std::int64_t size_(readInt());
+  if(size_ < 0)
+    throw ExcTestMarkIn("invalid size of an array");
+  for(std::int64_t i_(0); i_ < size_; ++i_)
+    values_.push_back(readInt());
+}
+
+void TestMarkIn::readFloatArray(
+    std::vector<long double>& values_) {
+  const std::int64_t size_(readInt());
+  if(size_ < 0)
+    throw ExcTestMarkIn("invalid size of an array");
+  for(std::int64_t i_(0); i_ < size_; ++i_)
+    values_.push_back(readFloat());
+}
+
+TestMarkPtr TestMarkIn::createMark(
+    TestMarkFactory& factory_) {
+  return factory_.createMark(readTypeMark());
+}
+
 TestMarkPtr TestMarkIn::deserialize(
     TestMarkFactory& factory_,
     TestMarkIn& deserializer_) {
-  std::string typemark_(deserializer_.readTypeMark());
-  TestMarkPtr testmark_(factory_.createMark(typemark_));
+  TestMarkPtr testmark_(deserializer_.createMark(factory_));
   testmark_->deserializeMark(factory_, deserializer_);
   return testmark_;
 }
@@ -16,23 +16,39 @@
  * You should have received a copy of the GNU Lesser General Public License
  * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
  */
-
 #include <testmarkinbin.h>
 
 #include <algorithm>
 #include <assert.h>
 #include <boost/endian/conversion.hpp>
 #include <cstdlib>
+#include <cstring>
 #include <initializer_list>
 #include <limits>
 #include <vector>
 
 #include <exctestmarkin.h>
+#include <testmarkfactory.h>
 #include "testmarkoutbintags.h"
 
 namespace OTest2 {
 
-TestMarkInBin::TestMarkInBin() {
+namespace {
+
+long double makeFloat(
+    std::uint64_t bits_) {
+  double value_;
+  std::memcpy(&value_, &bits_, sizeof(value_));
+  return value_;
+}
+
+} /* -- namespace */
+
+TestMarkInBin::TestMarkInBin() :
+  current(nullptr),
+  end(nullptr),
+  typemarks(),
+  typemarks_factory(nullptr) {
 
 }
 
@@ -40,10 +56,36 @@ TestMarkInBin::~TestMarkInBin() {
 
 }
 
+void TestMarkInBin::setBuffer(
+    const std::uint8_t* begin_,
+    std::uint64_t size_) {
+  current = begin_;
+  end = begin_ + size_;
+}
+
+void TestMarkInBin::readBinaryData(
+    std::uint64_t size_,
+    std::uint8_t* buffer_) {
+  while(size_ > 0) {
+    if(current == end && !fillBuffer())
+      throw ExcTestMarkIn("missing data in the stream");
+    const std::uint64_t chunk_(std::min<std::uint64_t>(size_, end - current));
+    std::memcpy(buffer_, current, chunk_);
+    current += chunk_;
+    buffer_ += chunk_;
+    size_ -= chunk_;
+  }
+}
+
+std::uint8_t TestMarkInBin::readByte() {
+  if(current == end && !fillBuffer())
+    throw ExcTestMarkIn("missing data in the stream");
+  return *current++;
+}
+
 TestMarkOutBinTag TestMarkInBin::readTag(
     std::initializer_list<TestMarkOutBinTag> tags_) {
-  std::uint8_t rtag_;
-  readBinaryData(sizeof(rtag_), &rtag_);
+  const std::uint8_t rtag_(readByte());
   if(std::find(
       tags_.begin(),
       tags_.end(),
@@ -52,15 +94,90 @@ TestMarkOutBinTag TestMarkInBin::readTag(
   return static_cast<TestMarkOutBinTag>(rtag_);
 }
 
+std::uint16_t TestMarkInBin::readUInt16() {
+  std::uint16_t buffer_;
+  readBinaryData(sizeof(buffer_), reinterpret_cast<std::uint8_t*>(&buffer_));
+  return boost::endian::big_to_native(buffer_);
+}
+
+std::uint64_t TestMarkInBin::readUInt64() {
+  std::uint64_t buffer_;
+  readBinaryData(sizeof(buffer_), reinterpret_cast<std::uint8_t*>(&buffer_));
+  return boost::endian::big_to_native(buffer_);
+}
+
+void TestMarkInBin::readRawString(
+    std::uint64_t length_,
+    std::string& string_) {
+  /* -- the string is copied directly from the window if it's possible */
+  if(static_cast<std::uint64_t>(end - current) >= length_) {
+    string_.assign(reinterpret_cast<const char*>(current), length_);
+    current += length_;
+  }
+  else {
+    /* -- The length comes from the stream. The string grows just by
+     *    the read data, so a corrupted length cannot allocate more memory
+     *    than the stream actually contains. */
+    string_.clear();
+    string_.reserve(std::min<std::uint64_t>(length_, end - current));
+    while(length_ > 0) {
+      if(current == end && !fillBuffer())
+        throw ExcTestMarkIn("missing data in the stream");
+      const std::uint64_t chunk_(
+          std::min<std::uint64_t>(length_, end - current));
+      string_.append(reinterpret_cast<const char*>(current), chunk_);
+      current += chunk_;
+      length_ -= chunk_;
+    }
+  }
+}
+
+TestMarkInBin::TypeMarkRecord& TestMarkInBin::readTypeMarkRecord() {
+  auto tag_(readTag({TestMarkOutBinTag::TYPE, TestMarkOutBinTag::TYPE_REF}));
+
+  /* -- Reference of a type mark. The type marks get the IDs in the order
+   *    of their first occurrence. */
+  if(tag_ == TestMarkOutBinTag::TYPE_REF) {
+    const std::uint8_t id_(readByte());
+    if(id_ >= typemarks.size())
+      throw ExcTestMarkIn("invalid reference of a type mark");
+    return typemarks[id_];
+  }
+
+  const std::uint8_t length_(readByte());
+  typemarks.push_back({std::string(), nullptr});
+  readRawString(length_, typemarks.back().typemark);
+  return typemarks.back();
+}
+
 std::string TestMarkInBin::readTypeMark() {
-  readTag({TestMarkOutBinTag::TYPE});
+  return readTypeMarkRecord().typemark;
+}
+
+TestMarkPtr TestMarkInBin::createMark(
+    TestMarkFactory& factory_) {
+  /* -- the constructors are cached for one factory only */
+  if(typemarks_factory != &factory_) {
+    for(auto& record_ : typemarks)
+      record_.ctor = nullptr;
+    typemarks_factory = &factory_;
+  }
+
+  /* -- resolve the type mark just once */
+  TypeMarkRecord& record_(readTypeMarkRecord());
+  if(record_.ctor == nullptr)
+    record_.ctor = factory_.getConstructor(record_.typemark);
+  return (*record_.ctor)();
+}
 
-  std::uint8_t length_;
-  readBinaryData(sizeof(length_), &length_);
-  boost::endian::big_to_native_inplace(length_);
-  std::vector<std::uint8_t> buffer_(length_);
-  readBinaryData(length_, buffer_.data());
-  return std::string(buffer_.data(), buffer_.data() + length_);
+std::int64_t TestMarkInBin::readIntValue(
+    TestMarkOutBinTag tag_) {
+  if(tag_ == TestMarkOutBinTag::INT_SHORT)
+    return static_cast<std::int64_t>(static_cast<std::int8_t>(readByte()));
+  else if(tag_ == TestMarkOutBinTag::INT_NORMAL)
+    return static_cast<std::int64_t>(static_cast<std::int16_t>(readUInt16()));
+  else
+    return static_cast<std::int64_t>(readUInt64());
 }
 
 std::int64_t TestMarkInBin::readInt() {
@@ -69,44 +186,34 @@ std::int64_t TestMarkInBin::readInt() {
       TestMarkOutBinTag::INT_NORMAL,
       TestMarkOutBinTag::INT_HUGE
   }));
-
-  if(tag_ == TestMarkOutBinTag::INT_SHORT) {
-    std::uint8_t buffer_;
-    readBinaryData(sizeof(buffer_), &buffer_);
-    return static_cast<std::int64_t>(static_cast<std::int8_t>(buffer_));
-  }
-  else if(tag_ == TestMarkOutBinTag::INT_NORMAL) {
-    std::uint16_t buffer_;
-    readBinaryData(sizeof(buffer_), reinterpret_cast<std::uint8_t*>(&buffer_));
-    boost::endian::big_to_native_inplace(buffer_);
-    return static_cast<std::int64_t>(static_cast<std::int16_t>(buffer_));
-  }
-  else {
-    std::uint64_t buffer_;
-    readBinaryData(sizeof(buffer_), reinterpret_cast<std::uint8_t*>(&buffer_));
-    boost::endian::big_to_native_inplace(buffer_);
-    return static_cast<std::int64_t>(buffer_);
-  }
+  return readIntValue(tag_);
 }
 
-long double TestMarkInBin::readFloat() {
-  readTag({TestMarkOutBinTag::FLOAT});
+long double TestMarkInBin::readFloatValue(
+    TestMarkOutBinTag tag_) {
+  if(tag_ == TestMarkOutBinTag::FLOAT_BINARY)
+    return makeFloat(readUInt64());
 
-  std::uint8_t length_;
-  readBinaryData(sizeof(length_), &length_);
-  std::vector<std::uint8_t> buffer_(length_ + 1);
-  readBinaryData(length_, buffer_.data());
-  buffer_[length_] = 0;  /* -- string terminator */
+  const std::uint8_t length_(readByte());
+  std::string buffer_;
+  readRawString(length_, buffer_);
 
   char* end_(nullptr);
-  long double value_(
-      std::strtold(reinterpret_cast<const char*>(buffer_.data()), &end_));
-  if(reinterpret_cast<std::uint8_t*>(end_) != buffer_.data() + length_)
+  long double value_(std::strtold(buffer_.c_str(), &end_));
+  if(end_ != buffer_.c_str() + length_)
     throw ExcTestMarkIn("invalid format of a floating point number");
 
   return value_;
 }
 
+long double TestMarkInBin::readFloat() {
+  auto tag_(readTag({
+      TestMarkOutBinTag::FLOAT,
+      TestMarkOutBinTag::FLOAT_BINARY
+  }));
+  return readFloatValue(tag_);
+}
+
 std::string TestMarkInBin::readString() {
   auto tag_(readTag({
       TestMarkOutBinTag::STRING_SHORT,
@@ -115,26 +222,70 @@ std::string TestMarkInBin::readString() {
   }));
 
   std::uint64_t length_;
-  if(tag_ == TestMarkOutBinTag::STRING_SHORT) {
-    std::uint8_t buffer_;
-    readBinaryData(sizeof(buffer_), &buffer_);
-    length_ = buffer_;
-  }
-  else if(tag_ == TestMarkOutBinTag::STRING_NORMAL) {
-    std::uint16_t buffer_;
-    readBinaryData(sizeof(buffer_), reinterpret_cast<std::uint8_t*>(&buffer_));
-    boost::endian::big_to_native_inplace(buffer_);
-    length_ = buffer_;
+  if(tag_ == TestMarkOutBinTag::STRING_SHORT)
+    length_ = readByte();
+  else if(tag_ == TestMarkOutBinTag::STRING_NORMAL)
+    length_ = readUInt16();
+  else
+    length_ = readUInt64();
+
+  std::string string_;
+  readRawString(length_, string_);
+  return string_;
+}
+
+void TestMarkInBin::readIntArray(
+    std::vector<std::int64_t>& values_) {
+  auto tag_(readTag({
+      TestMarkOutBinTag::INT_ARRAY,
+      TestMarkOutBinTag::INT_SHORT,
+      TestMarkOutBinTag::INT_NORMAL,
+      TestMarkOutBinTag::INT_HUGE
+  }));
+
+  /* -- generic form of the array */
+  if(tag_ != TestMarkOutBinTag::INT_ARRAY) {
+    const std::int64_t size_(readIntValue(tag_));
+    if(size_ < 0)
+      throw ExcTestMarkIn("invalid size of an array");
+    for(std::int64_t i_(0); i_ < size_; ++i_)
+      values_.push_back(readInt());
+    return;
   }
-  else {
-    std::uint64_t buffer_;
-    readBinaryData(sizeof(buffer_), reinterpret_cast<std::uint8_t*>(&buffer_));
-    boost::endian::big_to_native_inplace(buffer_);
-    length_ = buffer_;
+
+  /* -- packed form */
+  const std::uint64_t size_(readUInt64());
+  values_.reserve(values_.size() + std::min<std::uint64_t>(
+      size_, (end - current) / sizeof(std::uint64_t)));
+  for(std::uint64_t i_(0); i_ < size_; ++i_)
+    values_.push_back(static_cast<std::int64_t>(readUInt64()));
+}
+
+void TestMarkInBin::readFloatArray(
+    std::vector<long double>& values_) {
+  auto tag_(readTag({
+      TestMarkOutBinTag::FLOAT_ARRAY,
+      TestMarkOutBinTag::INT_SHORT,
+      TestMarkOutBinTag::INT_NORMAL,
+      TestMarkOutBinTag::INT_HUGE
+  }));
+
+  /* -- generic form of the array */
+  if(tag_ != TestMarkOutBinTag::FLOAT_ARRAY) {
+    const std::int64_t size_(readIntValue(tag_));
+    if(size_ < 0)
+      throw ExcTestMarkIn("invalid size of an array");
+    for(std::int64_t i_(0); i_ < size_; ++i_)
+      values_.push_back(readFloat());
+    return;
   }
-  std::vector<std::uint8_t> str_(length_);
-  readBinaryData(length_, str_.data());
-  return std::string(str_.data(), str_.data() + length_);
+
+  /* -- packed form */
+  const std::uint64_t size_(readUInt64());
+  values_.reserve(values_.size() + std::min<std::uint64_t>(
+      size_, (end - current) / sizeof(std::uint64_t)));
+  for(std::uint64_t i_(0); i_ < size_; ++i_)
+    values_.push_back(makeFloat(readUInt64()));
 }
 
 } /* -- namespace OTest2 */
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <testmarkinbinbuffer.h>
+
+namespace OTest2 {
+
+TestMarkInBinBuffer::TestMarkInBinBuffer(
+    const std::uint8_t* data_,
+    std::uint64_t size_) {
+  setBuffer(data_, size_);
+}
+
+TestMarkInBinBuffer::TestMarkInBinBuffer(
+    const std::string& data_) {
+  setBuffer(reinterpret_cast<const std::uint8_t*>(data_.data()), data_.size());
+}
+
+TestMarkInBinBuffer::~TestMarkInBinBuffer() {
+
+}
+
+bool TestMarkInBinBuffer::fillBuffer() {
+  /* -- all the data are in the buffer */
+  return false;
+}
+
+} /* -- namespace OTest2 */
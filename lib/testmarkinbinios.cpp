@@ -20,27 +20,41 @@
 #include <testmarkinbinios.h>
 
 #include <assert.h>
+#include <cstddef>
 #include <istream>
 
 #include <exctestmarkin.h>
 
 namespace OTest2 {
 
+namespace {
+
+constexpr std::size_t BLOCK_SIZE(64 * 1024);
+
+} /* -- namespace */
+
 TestMarkInBinIOS::TestMarkInBinIOS(
     std::istream* is_) :
-  is(is_) {
+  is(is_),
+  block(BLOCK_SIZE) {
   assert(is != nullptr);
 
 }
 
-void TestMarkInBinIOS::readBinaryData(
-    std::uint64_t size_,
-    std::uint8_t* buffer_) {
-  is->read(reinterpret_cast<char*>(buffer_), size_);
-  if(!*is)
+bool TestMarkInBinIOS::fillBuffer() {
+  if(is->bad())
+    throw ExcTestMarkIn("an input error");
+  if(is->eof())
+    return false;
+
+  is->read(reinterpret_cast<char*>(block.data()), block.size());
+  if(is->bad())
     throw ExcTestMarkIn("an input error");
-  if(static_cast<std::uint64_t>(is->gcount()) != size_)
-    throw ExcTestMarkIn("missing data in the stream");
+  const std::uint64_t size_(is->gcount());
+  if(size_ == 0)
+    return false;
+  setBuffer(block.data(), size_);
+  return true;
 }
 
 TestMarkInBinIOS::~TestMarkInBinIOS() {
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <testmarkintarray.h>
+
+#include <assert.h>
+
+#include <testmarkhash.h>
+#include <testmarkin.h>
+#include <testmarkint.h>
+#include <testmarkout.h>
+
+namespace OTest2 {
+
+namespace {
+
+const char SERIALIZE_TYPE_MARK[] = "ot2:intarray";
+
+} /* -- namespace */
+
+TestMarkIntArray::TestMarkIntArray(
+    std::vector<std::int64_t> values_) :
+  TestMarkIntArray("", std::move(values_)) {
+
+}
+
+TestMarkIntArray::TestMarkIntArray(
+    const std::string& prefix_,
+    std::vector<std::int64_t> values_) :
+  TestMarkPrefix(SERIALIZE_TYPE_MARK, prefix_),
+  values(std::move(values_)),
+  items() {
+  hashValues();
+}
+
+TestMarkIntArray::TestMarkIntArray(
+    const CtorMark* ctor_mark_) :
+  TestMarkPrefix(ctor_mark_, SERIALIZE_TYPE_MARK),
+  values(),
+  items() {
+
+}
+
+TestMarkIntArray::~TestMarkIntArray() {
+
+}
+
+const char* TestMarkIntArray::typeMark() {
+  return SERIALIZE_TYPE_MARK;
+}
+
+void TestMarkIntArray::hashValues() {
+  /* -- The whole block is hashed at once. The hash code is never stored
+   *    so the native byte order doesn't matter. */
+  hash.addData(
+      reinterpret_cast<const std::uint8_t*>(values.data()),
+      values.size() * sizeof(std::int64_t));
+  hash.addTerminator();
+}
+
+const std::vector<TestMarkPtr>& TestMarkIntArray::getItems() const {
+  /* -- the nested marks are created lazily just for diffing and printing */
+  if(items.size() != values.size()) {
+    items.clear();
+    items.reserve(values.size());
+    for(std::int64_t value_ : values)
+      items.push_back(std::make_shared<TestMarkInt>(value_));
+  }
+  return items;
+}
+
+bool TestMarkIntArray::doIsEqualPrefixed(
+    const TestMark& other_,
+    long double precision_) const {
+  const TestMarkIntArray* o_(static_cast<const TestMarkIntArray*>(&other_));
+  return values == o_->values;
+}
+
+void TestMarkIntArray::doDiffArray(
+    int level_,
+    std::vector<LinearizedRecord>& array_) const {
+  for(const auto& item_ : getItems()) {
+    array_.push_back({level_, item_.get(), ""});
+  }
+}
+
+void TestMarkIntArray::doLinearizedMark(
+    int level_,
+    const std::string& label_,
+    std::vector<LinearizedRecord>& array_) const {
+  array_.push_back({level_, this, label_});
+  for(const auto& item_ : getItems()) {
+    item_->doLinearizedMark(level_ + 1, "", array_);
+  }
+}
+
+const char* TestMarkIntArray::getParenthesis() const {
+  return "[]";
+}
+
+void TestMarkIntArray::serializeItems(
+    TestMarkOut& serializer_) const {
+  serializer_.writeIntArray(values);
+}
+
+void TestMarkIntArray::deserializeItems(
+    TestMarkFactory& factory_,
+    TestMarkIn& deserializer_) {
+  deserializer_.readIntArray(values);
+  hashValues();
+}
+
+} /* namespace OTest2 */
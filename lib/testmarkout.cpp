@@ -29,4 +29,18 @@ TestMarkOut::~TestMarkOut() {
 
 }
 
+void TestMarkOut::writeIntArray(
+    const std::vector<std::int64_t>& values_) {
+  writeInt(values_.size());
+  for(auto value_ : values_)
+    writeInt(value_);
+}
+
+void TestMarkOut::writeFloatArray(
+    const std::vector<long double>& values_) {
+  writeInt(values_.size());
+  for(auto value_ : values_)
+    writeFloat(value_);
+}
+
 } /* -- namespace OTest2 */
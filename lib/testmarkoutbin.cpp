@@ -19,18 +19,47 @@
 
 #include <testmarkoutbin.h>
 
+#include <algorithm>
 #include <assert.h>
 #include <boost/endian/conversion.hpp>
+#include <cmath>
 #include <limits>
 #include <cstring>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "testmarkoutbintags.h"
 
 namespace OTest2 {
 
-TestMarkOutBin::TestMarkOutBin() {
+static_assert(
+    std::numeric_limits<double>::is_iec559 && sizeof(double) == sizeof(std::uint64_t),
+    "the binary format of floats requires IEEE-754 doubles");
+
+namespace {
+
+/* -- Check whether the value can be stored as IEEE-754 double without
+ *    any loss of precision. */
+bool isBinaryFloat(
+    long double value_) {
+  return std::isnan(value_)
+      || static_cast<long double>(static_cast<double>(value_)) == value_;
+}
+
+std::uint64_t getFloatBits(
+    long double value_) {
+  const double dvalue_(static_cast<double>(value_));
+  std::uint64_t bits_;
+  std::memcpy(&bits_, &dvalue_, sizeof(bits_));
+  return bits_;
+}
+
+} /* -- namespace */
+
+TestMarkOutBin::TestMarkOutBin() :
+  typemarks(),
+  typemarks_count(0) {
 
 }
 
@@ -43,10 +72,30 @@ void TestMarkOutBin::writeTag(
   writeBinaryData(sizeof(tag_), reinterpret_cast<const std::uint8_t*>(&tag_));
 }
 
+void TestMarkOutBin::writeUInt64(
+    std::uint64_t value_) {
+  const std::uint64_t be_value_(boost::endian::native_to_big(value_));
+  writeBinaryData(sizeof(be_value_), reinterpret_cast<const std::uint8_t*>(&be_value_));
+}
+
 void TestMarkOutBin::writeTypeMark(
     const char* typemark_) {
   assert(typemark_ != nullptr);
 
+  /* -- The type marks get IDs in the order they are written. Repeated type
+   *    marks are written as references of the IDs. */
+  auto iter_(typemarks.find(typemark_));
+  if(iter_ != typemarks.end()
+      && (*iter_).second <= std::numeric_limits<std::uint8_t>::max()) {
+    writeTag(TestMarkOutBinTag::TYPE_REF);
+    const std::uint8_t id_(static_cast<std::uint8_t>((*iter_).second));
+    writeBinaryData(sizeof(id_), &id_);
+    return;
+  }
+  if(iter_ == typemarks.end())
+    typemarks.insert({typemark_, typemarks_count});
+  ++typemarks_count;
+
   writeTag(TestMarkOutBinTag::TYPE);
 
   const std::uint64_t length_(std::strlen(typemark_));
@@ -81,11 +130,19 @@ void TestMarkOutBin::writeInt(
 
 void TestMarkOutBin::writeFloat(
     long double value_) {
+  /* -- Most of the values fit the IEEE-754 double precision. They are
+   *    stored in the binary form. */
+  if(isBinaryFloat(value_)) {
+    writeTag(TestMarkOutBinTag::FLOAT_BINARY);
+    writeUInt64(getFloatBits(value_));
+    return;
+  }
+
   writeTag(TestMarkOutBinTag::FLOAT);
 
-  /* -- There is no platform independent way how to store floating points
-   *    in binary form. Hence, I print the float in the hexadecimal
-   *    format and I store the float as a string. */
+  /* -- There is no platform independent way how to store extended
+   *    floating points in binary form. Hence, I print the float in
+   *    the hexadecimal format and I store the float as a string. */
   std::ostringstream oss_;
   oss_ << std::hexfloat << value_;
   const std::string& str_value_(oss_.str());
@@ -111,7 +168,7 @@ void TestMarkOutBin::writeString(
   else if(length_ <= std::numeric_limits<std::uint16_t>::max()) {
     writeTag(TestMarkOutBinTag::STRING_NORMAL);
     const std::uint16_t be_length_(
-        boost::endian::native_to_big(static_cast<std::uint8_t>(length_)));
+        boost::endian::native_to_big(static_cast<std::uint16_t>(length_)));
     writeBinaryData(
         sizeof(be_length_), reinterpret_cast<const std::uint8_t*>(&be_length_));
   }
@@ -124,4 +181,38 @@ void TestMarkOutBin::writeString(
   writeBinaryData(length_, reinterpret_cast<const std::uint8_t*>(string_.c_str()));
 }
 
+void TestMarkOutBin::writeIntArray(
+    const std::vector<std::int64_t>& values_) {
+  writeTag(TestMarkOutBinTag::INT_ARRAY);
+  writeUInt64(values_.size());
+
+  /* -- the items are written in one block */
+  std::vector<std::uint64_t> buffer_(values_.size());
+  for(std::size_t i_(0); i_ < values_.size(); ++i_)
+    buffer_[i_] = boost::endian::native_to_big(static_cast<std::uint64_t>(values_[i_]));
+  writeBinaryData(
+      buffer_.size() * sizeof(std::uint64_t),
+      reinterpret_cast<const std::uint8_t*>(buffer_.data()));
+}
+
+void TestMarkOutBin::writeFloatArray(
+    const std::vector<long double>& values_) {
+  /* -- the packed form is used only if all the values are stored exactly */
+  if(!std::all_of(values_.begin(), values_.end(), isBinaryFloat)) {
+    TestMarkOut::writeFloatArray(values_);
+    return;
+  }
+
+  writeTag(TestMarkOutBinTag::FLOAT_ARRAY);
+  writeUInt64(values_.size());
+
+  /* -- the items are written in one block */
+  std::vector<std::uint64_t> buffer_(values_.size());
+  for(std::size_t i_(0); i_ < values_.size(); ++i_)
+    buffer_[i_] = boost::endian::native_to_big(getFloatBits(values_[i_]));
+  writeBinaryData(
+      buffer_.size() * sizeof(std::uint64_t),
+      reinterpret_cast<const std::uint8_t*>(buffer_.data()));
+}
+
 } /* -- namespace OTest2 */
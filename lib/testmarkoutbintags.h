@@ -33,6 +33,10 @@ enum class TestMarkOutBinTag : std::uint8_t {
   STRING_SHORT = 6,
   STRING_NORMAL = 7,
   STRING_HUGE = 8,
+  FLOAT_BINARY = 9,
+  INT_ARRAY = 10,
+  FLOAT_ARRAY = 11,
+  TYPE_REF = 12,
 };
 
 } /* -- namespace OTest2 */
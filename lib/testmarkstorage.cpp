@@ -21,12 +21,20 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <atomic>
 #include <cctype>
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <strstream>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 #include <base64istream.h>
 #include <base64ostream.h>
@@ -35,7 +43,7 @@
 #include <exctestmarkin.h>
 #include <testmark.h>
 #include <testmarkfactory.h>
-#include <testmarkinbinios.h>
+#include <testmarkinbinbuffer.h>
 #include <testmarkoutbinios.h>
 #include <testmarkptr.h>
 #include <utils.h>
@@ -101,6 +109,94 @@ std::string unescapeKey(
   return oss_.str();
 }
 
+void readWholeStream(
+    std::istream& is_,
+    std::string& data_) {
+  char block_[16 * 1024];
+  while(is_.read(block_, sizeof(block_)) || is_.gcount() > 0)
+    data_.append(block_, is_.gcount());
+  if(is_.bad())
+    throw ExcTestMarkIn("an input error");
+}
+
+/**
+ * @brief Run a job for each record on a pool of worker threads
+ *
+ * The records are independent so they are distributed among the workers
+ * one by one. The first exception thrown by a job is passed to the caller
+ * after all the workers finish.
+ *
+ * @param count_ Number of records
+ * @param job_ The job. The argument is an index of the record.
+ */
+void runParallel(
+    std::size_t count_,
+    const std::function<void(std::size_t)>& job_) {
+  std::size_t workers_count_(std::thread::hardware_concurrency());
+  workers_count_ = std::min(std::max<std::size_t>(workers_count_, 1), count_);
+
+  std::atomic<std::size_t> next_(0);
+  std::mutex lock_;
+  std::exception_ptr exception_;
+  auto worker_([&]() {
+    for(std::size_t index_(next_++); index_ < count_; index_ = next_++) {
+      try {
+        job_(index_);
+      }
+      catch(...) {
+        std::lock_guard<std::mutex> guard_(lock_);
+        if(!exception_)
+          exception_ = std::current_exception();
+        next_ = count_;  /* -- stop the other workers */
+      }
+    }
+  });
+
+  /* -- The current thread is one of the workers. If a thread cannot be
+   *    started, the records are processed by the already running ones. */
+  std::vector<std::thread> workers_;
+  for(std::size_t i_(1); i_ < workers_count_; ++i_) {
+    try {
+      workers_.emplace_back(worker_);
+    }
+    catch(const std::system_error&) {
+      break;
+    }
+  }
+  worker_();
+  for(auto& thread_ : workers_)
+    thread_.join();
+
+  if(exception_)
+    std::rethrow_exception(exception_);
+}
+
+TestMarkPtr decodeTestMark(
+    TestMarkFactory& factory_,
+    const char* data_,
+    std::size_t size_) {
+  std::istrstream iss_(data_, size_);
+  Base64IStream base64i_(&iss_);
+  Bzip2IStream bzip2i_(&base64i_);
+  std::string decoded_;
+  readWholeStream(bzip2i_, decoded_);
+
+  TestMarkInBinBuffer reader_(decoded_);
+  return TestMarkInBinBuffer::deserialize(factory_, reader_);
+}
+
+std::string encodeTestMark(
+    const TestMark& mark_) {
+  std::ostringstream oss_;
+  {
+    Base64OStream base64o_(&oss_);
+    Bzip2OStream bzip2o_(&base64o_);
+    TestMarkOutBinIOS writer_(&bzip2o_);
+    mark_.serializeMark(writer_);
+  }
+  return oss_.str();
+}
+
 } /* -- namespace */
 
 struct TestMarkStorage::Impl {
@@ -110,6 +206,7 @@ struct TestMarkStorage::Impl {
     typedef std::map<std::string, TestMarkPtr> Storage;
     Storage storage;
     bool changed;
+    bool read_only;
 
     /* -- avoid copying */
     Impl(
@@ -121,6 +218,8 @@ struct TestMarkStorage::Impl {
         TestMarkFactory* factory_,
         const std::string& storage_file_);
     ~Impl();
+
+    void save();
 };
 
 TestMarkStorage::Impl::Impl(
@@ -129,16 +228,35 @@ TestMarkStorage::Impl::Impl(
   factory(factory_),
   storage_file(storage_file_),
   storage(),
-  changed(false) {
+  changed(false),
+  read_only(false) {
   assert(factory != nullptr);
 
-  /* -- read the test marks from the file */
-  std::ifstream ifs_(storage_file.c_str());
-  while(!!ifs_) {
-    std::ostringstream oss_;
-    ifs_.get(*oss_.rdbuf());  /* -- get the whole line */
-    ifs_.get();               /* -- skip the newline */
-    std::string line_(oss_.str());
+  /* -- read the whole file */
+  std::string content_;
+  {
+    std::ifstream ifs_(storage_file.c_str(), std::ios::binary);
+    if(!ifs_)
+      return;
+    readWholeStream(ifs_, content_);
+  }
+
+  /* -- Split the file into records. One record per line. */
+  struct Record {
+    std::string key;
+    const char* data;
+    std::size_t size;
+    TestMarkPtr mark;
+  };
+  std::vector<Record> records_;
+  std::string::size_type begin_(0);
+  while(begin_ < content_.size()) {
+    std::string::size_type end_(content_.find('\n', begin_));
+    if(end_ == std::string::npos)
+      end_ = content_.size();
+    const std::string::size_type line_begin_(begin_);
+    const std::string line_(content_, line_begin_, end_ - line_begin_);
+    begin_ = end_ + 1;
 
     /* -- ignore empty lines */
     if(isLineEmpty(line_))
@@ -148,40 +266,64 @@ TestMarkStorage::Impl::Impl(
     auto sep_index_(searchForSeparator(line_));
     if(sep_index_ <= 0 || sep_index_ == std::string::npos) /* -- wrong line */
       throw ExcTestMarkIn("invalid format of the test mark storage file " + storage_file);
-    std::string key_(line_.data(), line_.data() + sep_index_);
-
-    /* -- parse the test mark */
-    std::istrstream iss_(
-        line_.data() + sep_index_ + 1, line_.size() - sep_index_ - 1);
-    Base64IStream base64i_(&iss_);
-    Bzip2IStream bzip2i_(&base64i_);
-    TestMarkInBinIOS reader_(&bzip2i_);
-    TestMarkPtr testmark_(TestMarkInBinIOS::deserialize(*factory, reader_));
-
-    /* -- insert into the map */
-    storage.insert({unescapeKey(key_), testmark_});
+    const std::size_t offset_(line_begin_ + sep_index_ + 1);
+    records_.push_back({
+        line_.substr(0, sep_index_),
+        content_.data() + offset_,
+        end_ - offset_,
+        TestMarkPtr()});
   }
+
+  /* -- decode the test marks in parallel */
+  runParallel(records_.size(), [this, &records_](std::size_t index_) {
+    Record& record_(records_[index_]);
+    record_.mark = decodeTestMark(*factory, record_.data, record_.size);
+  });
+
+  /* -- insert into the map */
+  for(auto& record_ : records_)
+    storage.insert({unescapeKey(record_.key), std::move(record_.mark)});
 }
 
 TestMarkStorage::Impl::~Impl() {
+  /* -- The storage is saved implicitly if the owner hasn't done it. An escaping
+   *    exception would terminate the program, hence it's just reported. */
+  try {
+    save();
+  }
+  catch(const std::exception& exc_) {
+    std::cerr << "cannot store the test marks into '" << storage_file
+        << "': " << exc_.what() << std::endl;
+  }
+  catch(...) {
+    std::cerr << "cannot store the test marks into '" << storage_file
+        << "'" << std::endl;
+  }
+}
+
+void TestMarkStorage::Impl::save() {
   /* -- store the storage if it changed */
   if(changed) {
-    std::ofstream ofs_(storage_file.c_str());
-    for(const auto& mark_ : storage) {
-      /* -- write key */
-      ofs_ << escapeKey(mark_.first) << ':';
-
-      /* -- write the mark */
-      {
-        Base64OStream base64o_(&ofs_);
-        Bzip2OStream bzip2o_(&base64o_);
-        TestMarkOutBinIOS writer_(&bzip2o_);
-        mark_.second->serializeMark(writer_);
-      }
+    /* -- encode the test marks in parallel */
+    std::vector<const Storage::value_type*> marks_;
+    marks_.reserve(storage.size());
+    for(const auto& mark_ : storage)
+      marks_.push_back(&mark_);
+    std::vector<std::string> encoded_(marks_.size());
+    runParallel(marks_.size(), [&marks_, &encoded_](std::size_t index_) {
+      encoded_[index_] = encodeTestMark(*marks_[index_]->second);
+    });
 
-      /* -- record separator */
-      ofs_ << '\n';
+    /* -- write the records in order of the keys */
+    std::ofstream ofs_(storage_file.c_str());
+    for(std::size_t i_(0); i_ < marks_.size(); ++i_) {
+      ofs_ << escapeKey(marks_[i_]->first) << ':' << encoded_[i_] << '\n';
     }
+    ofs_.close();
+    if(!ofs_)
+      throw std::runtime_error(
+          "cannot write the test mark storage file " + storage_file);
+    changed = false;
   }
 }
 
@@ -196,15 +338,27 @@ TestMarkStorage::~TestMarkStorage() {
   odelete(pimpl);
 }
 
+void TestMarkStorage::setReadOnly() {
+  pimpl->read_only = true;
+}
+
+bool TestMarkStorage::isReadOnly() const {
+  return pimpl->read_only;
+}
+
 void TestMarkStorage::setTestMark(
     const std::string& key_,
     TestMarkPtr test_mark_) {
-  assert(!key_.empty() && test_mark_ != nullptr);
+  assert(!key_.empty() && test_mark_ != nullptr && !pimpl->read_only);
 
   pimpl->storage[key_] = test_mark_;
   pimpl->changed = true;
 }
 
+void TestMarkStorage::save() {
+  pimpl->save();
+}
+
 TestMarkPtr TestMarkStorage::getTestMark(
     const std::string& key_) const {
   assert(!key_.empty());
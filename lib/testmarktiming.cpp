@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <testmarktiming.h>
+
+#include <assert.h>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include <testmarkhash.h>
+#include <testmarkin.h>
+#include <testmarkout.h>
+
+namespace OTest2 {
+
+namespace {
+
+const char SERIALIZE_TYPE_MARK[] = "ot2:timing";
+
+} /* -- namespace */
+
+TestMarkTiming::TestMarkTiming(
+    long double median_,
+    long double mad_,
+    std::int64_t samples_) :
+  median(median_),
+  mad(mad_),
+  samples(samples_) {
+
+}
+
+TestMarkTiming::TestMarkTiming(
+    const CtorMark*) :
+  median(0.0L),
+  mad(0.0L),
+  samples(0) {
+
+}
+
+TestMarkTiming::~TestMarkTiming() {
+
+}
+
+const char* TestMarkTiming::typeMark() {
+  return SERIALIZE_TYPE_MARK;
+}
+
+long double TestMarkTiming::getMedian() const noexcept {
+  return median;
+}
+
+long double TestMarkTiming::getMad() const noexcept {
+  return mad;
+}
+
+std::int64_t TestMarkTiming::getSamples() const noexcept {
+  return samples;
+}
+
+TestMarkHashCode TestMarkTiming::doGetHashCode() const noexcept {
+  TestMarkHash hash_;
+  hash_.addBasicType(
+      SERIALIZE_TYPE_MARK,
+      reinterpret_cast<const std::uint8_t*>(&median),
+      sizeof(median));
+  hash_.addData(reinterpret_cast<const std::uint8_t*>(&mad), sizeof(mad));
+  hash_.addData(reinterpret_cast<const std::uint8_t*>(&samples), sizeof(samples));
+  return hash_.getHashCode();
+}
+
+bool TestMarkTiming::doIsEqual(
+    const TestMark& other_,
+    long double precision_) const {
+  const TestMarkTiming* o_(static_cast<const TestMarkTiming*>(&other_));
+  return std::abs(median - o_->median) <= precision_
+      && std::abs(mad - o_->mad) <= precision_
+      && samples == o_->samples;
+}
+
+bool TestMarkTiming::doIsEqualValue(
+    const TestMark& other_,
+    long double precision_) const {
+  return doIsEqual(other_, precision_);
+}
+
+void TestMarkTiming::doDiffArray(
+    int level_,
+    std::vector<LinearizedRecord>& array_) const
+{
+  /* -- there are no children */
+}
+
+void TestMarkTiming::doLinearizedMark(
+    int level_,
+    const std::string& label_,
+    std::vector<LinearizedRecord>& array_) const {
+  array_.push_back({level_, this, label_});
+}
+
+void TestMarkTiming::doPrintOpen(
+    std::ostream& os_,
+    const std::string& prefix_) const {
+  /* -- format the times separately to keep the state of the stream */
+  std::ostringstream oss_;
+  oss_ << std::fixed << std::setprecision(2)
+      << "timing<median: " << median << " ns, MAD: " << mad
+      << " ns, samples: " << samples << ">";
+  os_ << prefix_ << oss_.str() << '\n';
+}
+
+void TestMarkTiming::doPrintClose(
+    std::ostream& os_,
+    const std::string& prefix_) const {
+  /* -- nothing to do */
+}
+
+void TestMarkTiming::doSerializeMark(
+    TestMarkOut& serializer_) const {
+  serializer_.writeTypeMark(SERIALIZE_TYPE_MARK);
+  serializer_.writeFloat(median);
+  serializer_.writeFloat(mad);
+  serializer_.writeInt(samples);
+}
+
+void TestMarkTiming::doDeserializeMark(
+    TestMarkFactory& factory_,
+    TestMarkIn& deserializer_) {
+  median = deserializer_.readFloat();
+  mad = deserializer_.readFloat();
+  samples = deserializer_.readInt();
+}
+
+} /* namespace OTest2 */
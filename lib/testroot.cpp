@@ -23,6 +23,7 @@
 #include <memory>
 
 #include <cmdnextobject.h>
+#include <cmdspawnobjects.h>
 #include <commandstack.h>
 #include <context.h>
 #include <scenario.h>
@@ -55,8 +56,12 @@ void TestRoot::scheduleBody(
     ScenarioPtr scenario_,
     ObjectPtr me_) {
   ScenarioIterPtr children_(scenario_->getChildren());
-  context_.command_stack->pushCommand(
-      std::make_shared<CmdNextObject>(children_, me_));
+  if(context_.scheduler != nullptr)
+    context_.command_stack->pushCommand(
+        std::make_shared<CmdSpawnObjects>(children_, me_));
+  else
+    context_.command_stack->pushCommand(
+        std::make_shared<CmdNextObject>(children_, me_));
 }
 
 void TestRoot::tearDownObject(
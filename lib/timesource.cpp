@@ -29,4 +29,9 @@ TimeSource::~TimeSource() {
 
 }
 
+bool TimeSource::fastForward(
+    duration delay_) {
+  return false;
+}
+
 } /* -- namespace OTest2 */
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__LIB_TIMESOURCEREPLAY_H_
+#define OTest2__LIB_TIMESOURCEREPLAY_H_
+
+#include <timesource.h>
+
+namespace OTest2 {
+
+/**
+ * @brief Time source returning the time of a replayed event
+ */
+class TimeSourceReplay : public TimeSource {
+  private:
+    time_point just_now;
+
+  public:
+    explicit TimeSourceReplay(
+        time_point now_) :
+      just_now(now_) {
+
+    }
+
+    virtual ~TimeSourceReplay() = default;
+
+    /* -- avoid copying */
+    TimeSourceReplay(
+        const TimeSourceReplay&) = delete;
+    TimeSourceReplay& operator = (
+        const TimeSourceReplay&) = delete;
+
+    virtual time_point now() override {
+      return just_now;
+    }
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__LIB_TIMESOURCEREPLAY_H_ */
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <timesourcevirtual.h>
+
+namespace OTest2 {
+
+TimeSourceVirtual::TimeSourceVirtual() :
+  TimeSourceVirtual(std::chrono::system_clock::now()) {
+
+}
+
+TimeSourceVirtual::TimeSourceVirtual(
+    time_point start_) :
+  start(start_),
+  real_start(std::chrono::steady_clock::now()),
+  skipped(duration::zero()) {
+
+}
+
+TimeSourceVirtual::~TimeSourceVirtual() {
+
+}
+
+TimeSourceVirtual::time_point TimeSourceVirtual::now() {
+  /* -- the steady clock keeps the virtual time monotonic */
+  const auto real_(std::chrono::duration_cast<duration>(
+      std::chrono::steady_clock::now() - real_start));
+  return start + real_ + skipped;
+}
+
+bool TimeSourceVirtual::fastForward(
+    duration delay_) {
+  if(delay_ > duration::zero())
+    skipped += delay_;
+  return true;
+}
+
+} /* -- namespace OTest2 */
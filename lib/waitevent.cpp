@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <waitevent.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <fcntl.h>
+#include <poll.h>
+#include <system_error>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#endif
+
+namespace OTest2 {
+
+namespace {
+
+[[noreturn]] void throwSystemError(
+    const char* what_) {
+  throw std::system_error(errno, std::generic_category(), what_);
+}
+
+} /* -- namespace */
+
+WaitEvent::WaitEvent() :
+  fd(-1),
+  write_fd(-1) {
+#if defined(__linux__)
+  fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if(fd < 0)
+    throwSystemError("eventfd");
+  write_fd = fd;
+#else
+  /* -- the self-pipe fallback */
+  int pipe_[2];
+  if(::pipe(pipe_) < 0)
+    throwSystemError("pipe");
+  for(int end_ : pipe_) {
+    ::fcntl(end_, F_SETFL, ::fcntl(end_, F_GETFL) | O_NONBLOCK);
+    ::fcntl(end_, F_SETFD, FD_CLOEXEC);
+  }
+  fd = pipe_[0];
+  write_fd = pipe_[1];
+#endif
+}
+
+WaitEvent::~WaitEvent() {
+  if(write_fd != fd)
+    ::close(write_fd);
+  ::close(fd);
+}
+
+void WaitEvent::notify() const {
+  /* -- A full counter or pipe means the event is already signaled.
+   *    Hence, the result can be ignored. */
+#if defined(__linux__)
+  const std::uint64_t value_(1);
+#else
+  const char value_(1);
+#endif
+  ssize_t written_;
+  do {
+    written_ = ::write(write_fd, &value_, sizeof(value_));
+  } while(written_ < 0 && errno == EINTR);
+}
+
+void WaitEvent::reset() const {
+  /* -- drain the descriptor */
+  char buffer_[64];
+  while(true) {
+    const ssize_t read_(::read(fd, buffer_, sizeof(buffer_)));
+    if(read_ < 0 && errno == EINTR)
+      continue;
+    if(read_ <= 0 || read_ < static_cast<ssize_t>(sizeof(buffer_)))
+      break;
+  }
+}
+
+bool WaitEvent::isNotified() const {
+  struct pollfd pfd_ = {fd, POLLIN, 0};
+  return ::poll(&pfd_, 1, 0) > 0 && (pfd_.revents & POLLIN) != 0;
+}
+
+int WaitEvent::getFD() const {
+  return fd;
+}
+
+} /* -- namespace OTest2 */
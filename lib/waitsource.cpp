@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <waitsource.h>
+
+#include <waitevent.h>
+
+namespace OTest2 {
+
+WaitSource::WaitSource(
+    int fd_,
+    int events_) :
+  fd(fd_),
+  events(events_) {
+
+}
+
+WaitSource::WaitSource(
+    const WaitEvent& event_) :
+  fd(event_.getFD()),
+  events(READ) {
+
+}
+
+WaitSource::WaitSource(
+    const WaitSource& src_) :
+  fd(src_.fd),
+  events(src_.events) {
+
+}
+
+WaitSource::~WaitSource() {
+
+}
+
+WaitSource& WaitSource::operator = (
+    const WaitSource& src_) {
+  fd = src_.fd;
+  events = src_.events;
+  return *this;
+}
+
+int WaitSource::getFD() const {
+  return fd;
+}
+
+int WaitSource::getEvents() const {
+  return events;
+}
+
+} /* -- namespace OTest2 */
@@ -258,7 +258,7 @@ void Function::generateDeclaration(
     int indent_,
     const std::string& fce_name_) const {
   Formatting::printIndent(os_, indent_);
-  os_ << "void " << fce_name_ << "(";
+  os_ << rettype << " " << fce_name_ << "(";
   generateFceParameters(os_, indent_ + 2);
   os_ << ")";
 }
@@ -162,6 +162,8 @@ class Function {
     /**
      * @brief Generate declaration of the function with different name
      *
+     * The return type is kept. Coroutine test states rely on it.
+     *
      * @param os_ An output stream
      * @param indent_ Indentation level
      * @param fce_name_ The new function name
@@ -90,11 +90,14 @@ class Generator {
      * @param assertion_method_ Name of the assertion method
      * @param args_ranges_ Ordered ranges of assertion arguments. The first
      *     range is used as a message in the generic assertion functions.
+     * @param declaration_file_ File declaring the assertion function. It's
+     *     empty if the assertion is declared in the test file itself.
      */
     virtual void makeAssertion(
         const std::string& assertion_class_,
         const std::string& assertion_method_,
-        const std::vector<AssertionArg>& args_ranges_) = 0;
+        const std::vector<AssertionArg>& args_ranges_,
+        const std::string& declaration_file_) = 0;
 
     /**
      * @brief Generate state switch
@@ -103,12 +106,15 @@ class Generator {
      * @param state_end_ Ending location of the state name
      * @param delay_begin_ Beginning location of the delay expression
      * @param delay_end_ End location of the delay expression
+     * @param wait_sources_ Ranges of expressions of the wait sources.
+     *     The list is empty if the state switch doesn't wait for any event.
      */
     virtual void makeStateSwitch(
         const Location& state_begin_,
         const Location& state_end_,
         const Location& delay_begin_,
-        const Location& delay_end_) = 0;
+        const Location& delay_end_,
+        const std::vector<AssertionArg>& wait_sources_) = 0;
 
     /**
      * @brief Begin asserted try/catch block
@@ -187,6 +193,8 @@ class Generator {
      * @param name_ Name of the state
      * @param first_ If it's true the state is the entering state - the
      *     scenario
+     * @param benchmark_ If it's true the state is a benchmark - the body
+     *     of the state function is run in a measuring loop
      * @param state_fce_ Description of the state function
      * @param fbegin_ Beginning of the declaration of the state function
      * @param fend_ End of the declaration of the state function
@@ -194,6 +202,7 @@ class Generator {
     virtual void enterState(
         const std::string& name_,
         bool first_,
+        bool benchmark_,
         FunctionPtr state_fce_,
         const Location& fbegin_,
         const Location& fend_) = 0;
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <memory>
 #include <otest2/utils.h>
+#include <set>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -33,18 +34,57 @@
 #include "formatting.h"
 #include "lcstream.h"
 #include "objectlist.h"
+#include "sha256.h"
 #include "vartable.h"
 
 namespace OTest2 {
 
+namespace {
+
+/* -- Declaration and implementation headers of the assertion classes.
+ *    The implementation headers contain heavy templates, hence the headers
+ *    are included only if the assertion class is used in the generated
+ *    file. */
+struct AssertionHeader {
+    const char* assertion_class;
+    const char* declaration;
+    const char* implementation;
+};
+const AssertionHeader ASSERTION_HEADERS[] = {
+    {"::OTest2::AllocationAssertion", "otest2/assertionsalloc.h", nullptr},
+    {"::OTest2::GenericAssertion", "otest2/assertions.h", "otest2/assertionsimpl.h"},
+    {"::OTest2::ItemWiseAssertion", "otest2/assertionsitemwise.h", "otest2/assertionsitemwiseimpl.h"},
+    {"::OTest2::LexicographicalAssertion", "otest2/assertionslexi.h", "otest2/assertionslexiimpl.h"},
+    {"::OTest2::LongTextAssertion", "otest2/assertionstext.h", nullptr},
+    {"::OTest2::MapAssertion", "otest2/assertionsmap.h", "otest2/assertionsmapimpl.h"},
+    {"::OTest2::NearItemWiseAssertion", "otest2/assertionsnear.h", "otest2/assertionsnearimpl.h"},
+    {"::OTest2::RegressionAssertion", "otest2/regressions.h", "otest2/regressionsimpl.h"},
+};
+
+} /* -- namespace */
+
 struct GeneratorStd::Impl {
   public:
     GeneratorStd* owner;
 
-    /* -- reading and writing */
+    /* -- Reading and writing. The body of the file is buffered until
+     *    the end of the file as the list of included headers is known
+     *    after all the assertions are generated. */
+    std::ostream* target;
+    std::ostringstream body;
     LCStream output;
     FileReader* reader;
 
+    /* -- headers included by the generated file - the OTest2 headers
+     *    and the user headers declaring the used assertions */
+    std::set<std::string> headers;
+    std::set<std::string> user_headers;
+
+    /* -- positions of the line numbers of the #line directives pointing
+     *    into the generated file (offset in the body and the line number
+     *    in the body) */
+    std::vector<std::pair<std::string::size_type, int> > gener_lines;
+
     /* -- testing domain which is used for registration of the suites */
     std::string domain;
 
@@ -66,6 +106,7 @@ struct GeneratorStd::Impl {
 
     /* -- state function */
     FunctionPtr state_fce;
+    bool benchmark_state;
 
     /* -- current indentation */
     int indent;
@@ -98,9 +139,13 @@ struct GeneratorStd::Impl {
         const std::string& outfile_);
     ~Impl();
 
+    void requireAssertionClass(
+        const std::string& assertion_class_,
+        const std::string& declaration_file_);
     void writeUserLineDirective(
         const Location& begin_);
     void writeGenerLineDirective();
+    void writeFile();
     void writeStateClass(
         const std::string& state_);
     void writeObjectCtors(
@@ -120,13 +165,32 @@ GeneratorStd::Impl::Impl(
     const std::string& infile_,
     const std::string& outfile_) :
   owner(owner_),
-  output(output_),
+  target(output_),
+  body(),
+  output(&body),
   reader(reader_),
+  headers({
+      "otest2/casegenerated.h",
+      "otest2/context.h",
+      "otest2/fcemarshaler.h",
+      "otest2/generutils.h",
+      "otest2/objectptr.h",
+      "otest2/registry.h",
+      "otest2/scenariocase.h",
+      "otest2/scenariosuite.h",
+      "otest2/stategenerated.h",
+      "otest2/suitegenerated.h",
+      "otest2/tags.h",
+      "otest2/typetraits.h",
+      "otest2/userdata.h",
+  }),
+  user_headers(),
   domain(domain_),
   infile(infile_),
   outfile(outfile_),
   variables(),
   repeater(),
+  benchmark_state(false),
   indent(0) {
 
 }
@@ -143,13 +207,83 @@ void GeneratorStd::Impl::writeUserLineDirective(
   output << "\n";
 }
 
+void GeneratorStd::Impl::requireAssertionClass(
+    const std::string& assertion_class_,
+    const std::string& declaration_file_) {
+  /* -- strip the template arguments */
+  const std::string name_(
+      assertion_class_.substr(0, assertion_class_.find('<')));
+  for(const auto& item_ : ASSERTION_HEADERS) {
+    if(name_ == item_.assertion_class) {
+      headers.insert(item_.declaration);
+      if(item_.implementation != nullptr)
+        headers.insert(item_.implementation);
+      return;
+    }
+  }
+
+  /* -- Unknown (user) assertion class. The header declaring the assertion
+   *    is included, the generated code doesn't rely on the includes
+   *    of the test file. */
+  if(!declaration_file_.empty())
+    user_headers.insert(declaration_file_);
+}
+
 void GeneratorStd::Impl::writeGenerLineDirective() {
   output << '\n';
-  output << "#line " << (output.getLineNo() + 1) << " ";
+  output << "#line ";
+  /* -- The line number is written when the length of the heading
+   *    is known. */
+  gener_lines.push_back({
+      static_cast<std::string::size_type>(body.tellp()),
+      output.getLineNo() + 1});
+  output << " ";
   writeCString(output, outfile);
   output << "\n";
 }
 
+void GeneratorStd::Impl::writeFile() {
+  /* -- write the heading */
+  std::ostringstream heading_;
+  heading_
+      << "/*\n"
+      << "  This file is generated by the otest2 preprocessor. Don't modify it!\n"
+      << "*/\n"
+      << '\n'
+      << "#include <memory>\n"
+      << "#include <string>\n"
+      << "\n";
+  for(const auto& header_ : headers)
+    heading_ << "#include <" << header_ << ">\n";
+  if(!user_headers.empty()) {
+    heading_ << '\n';
+    for(const auto& header_ : user_headers)
+      heading_ << "#include \"" << header_ << "\"\n";
+  }
+  heading_ << '\n';
+  const std::string heading_text_(heading_.str());
+  int heading_lines_(0);
+  for(char c_ : heading_text_) {
+    if(c_ == '\n')
+      ++heading_lines_;
+  }
+  *target << heading_text_;
+
+  /* -- write the body and fix the line numbers of the #line directives */
+  const std::string body_text_(body.str());
+  std::string::size_type begin_(0);
+  for(const auto& line_ : gener_lines) {
+    target->write(body_text_.data() + begin_, line_.first - begin_);
+    *target << (line_.second + heading_lines_);
+    begin_ = line_.first;
+  }
+  target->write(body_text_.data() + begin_, body_text_.size() - begin_);
+
+  body.str(std::string());
+  gener_lines.clear();
+  user_headers.clear();
+}
+
 void GeneratorStd::Impl::writeStateClass(
     const std::string& state_) {
   output << "\n\n";
@@ -297,41 +431,6 @@ void GeneratorStd::beginFile() {
   /* -- initialize the list of testing objects */
   assert(pimpl->objects.empty());
   pimpl->objects.push_back(::OTest2::make_unique<Parser::ObjectList>());
-
-  /* -- write heading of the generated source file */
-  pimpl->output
-      << "/*\n"
-      << "  This file is generated by the otest2 preprocessor. Don't modify it!\n"
-      << "*/\n"
-      << '\n'
-      << "#include <memory>\n"
-      << "#include <string>\n"
-      << "\n"
-      << "#include <otest2/assertions.h>\n"
-      << "#include <otest2/assertionsimpl.h>\n"
-      << "#include <otest2/assertionsitemwise.h>\n"
-      << "#include <otest2/assertionsitemwiseimpl.h>\n"
-      << "#include <otest2/assertionslexi.h>\n"
-      << "#include <otest2/assertionslexiimpl.h>\n"
-      << "#include <otest2/assertionsmap.h>\n"
-      << "#include <otest2/assertionsmapimpl.h>\n"
-      << "#include <otest2/assertionstext.h>\n"
-      << "#include <otest2/casegenerated.h>\n"
-      << "#include <otest2/context.h>\n"
-      << "#include <otest2/fcemarshaler.h>\n"
-      << "#include <otest2/generutils.h>\n"
-      << "#include <otest2/objectptr.h>\n"
-      << "#include <otest2/registry.h>\n"
-      << "#include <otest2/regressions.h>\n"
-      << "#include <otest2/regressionsimpl.h>\n"
-      << "#include <otest2/scenariocase.h>\n"
-      << "#include <otest2/scenariosuite.h>\n"
-      << "#include <otest2/stategenerated.h>\n"
-      << "#include <otest2/suitegenerated.h>\n"
-      << "#include <otest2/tags.h>\n"
-      << "#include <otest2/typetraits.h>\n"
-      << "#include <otest2/userdata.h>\n"
-      << '\n';
 }
 
 void GeneratorStd::startUserArea(
@@ -348,7 +447,8 @@ void GeneratorStd::copySource(
 void GeneratorStd::makeAssertion(
     const std::string& assertion_class_,
     const std::string& assertion_method_,
-    const std::vector<AssertionArg>& args_ranges_) {
+    const std::vector<AssertionArg>& args_ranges_,
+    const std::string& declaration_file_) {
   pimpl->writeGenerLineDirective();
 
   /* -- read all assertion parameters */
@@ -357,6 +457,8 @@ void GeneratorStd::makeAssertion(
     args_texts_.push_back(pimpl->reader->getPart(arg_.begin, arg_.end));
   }
 
+  pimpl->requireAssertionClass(assertion_class_, declaration_file_);
+
   /* -- make an instance of the assertion class initialized with the filename,
    *    line number and the list of stringifized arguments */
   pimpl->output << assertion_class_ << "(otest2Context(), ";
@@ -408,7 +510,8 @@ void GeneratorStd::makeStateSwitch(
     const Location& state_begin_,
     const Location& state_end_,
     const Location& delay_begin_,
-    const Location& delay_end_) {
+    const Location& delay_end_,
+    const std::vector<AssertionArg>& wait_sources_) {
   pimpl->writeGenerLineDirective();
 
   /* -- invoke the switching function */
@@ -416,13 +519,29 @@ void GeneratorStd::makeStateSwitch(
   writeCString(pimpl->output, pimpl->reader->getPart(state_begin_, state_end_));
   pimpl->output << ", ";
   pimpl->reader->writePart(pimpl->output, delay_begin_, &delay_end_);
+
+  /* -- the wait sources are passed as an initializer list */
+  if(!wait_sources_.empty()) {
+    pimpl->output << ", {";
+    bool comma_(false);
+    for(const auto& source_ : wait_sources_) {
+      if(comma_)
+        pimpl->output << ", ";
+      else
+        comma_ = true;
+      pimpl->reader->writePart(pimpl->output, source_.begin, &source_.end);
+    }
+    pimpl->output << "}";
+  }
   pimpl->output << ")";
 
-  pimpl->writeUserLineDirective(delay_end_);
+  pimpl->writeUserLineDirective(
+      wait_sources_.empty() ? delay_end_ : wait_sources_.back().end);
 }
 
 void GeneratorStd::makeTryCatchBegin(
     const Location& begin_) {
+  pimpl->requireAssertionClass("::OTest2::GenericAssertion", std::string());
   Formatting::printIndent(pimpl->output, pimpl->indent + 1);
   pimpl->output << "::OTest2::GenericAssertion(otest2Context(), ";
   writeCString(pimpl->output, pimpl->infile);
@@ -555,6 +674,7 @@ void GeneratorStd::finishCaseFunctions() {
 void GeneratorStd::enterState(
     const std::string& state_,
     bool first_,
+    bool benchmark_,
     FunctionPtr state_fce_,
     const Location& fbegin_,
     const Location& fend_) {
@@ -568,6 +688,9 @@ void GeneratorStd::enterState(
     pimpl->first_state = state_;
   pimpl->indent += 2;
   pimpl->state_fce = state_fce_;
+  pimpl->benchmark_state = benchmark_;
+  if(benchmark_)
+    pimpl->headers.insert("otest2/benchmark.h");
 
   pimpl->writeStateClass(state_);
 
@@ -720,9 +843,29 @@ void GeneratorStd::leaveState() {
   pimpl->output << "virtual void runState(\n";
   Formatting::printIndent(pimpl->output, pimpl->indent + 2);
   pimpl->output << "const ::OTest2::Context& context_) {\n";
-  pimpl->state_fce->generateInvocation(
-      pimpl->output, pimpl->indent + 1, "stateFunction");
-  pimpl->output << "\n";
+  if(pimpl->benchmark_state) {
+    /* -- the benchmark body is invoked in the measuring loop */
+    Formatting::printIndent(pimpl->output, pimpl->indent + 1);
+    pimpl->output << "::OTest2::Benchmark benchmark_(context_);\n";
+    Formatting::printIndent(pimpl->output, pimpl->indent + 1);
+    pimpl->output << "while(benchmark_.nextSample()) {\n";
+    Formatting::printIndent(pimpl->output, pimpl->indent + 2);
+    pimpl->output << "for(std::uint64_t i_(benchmark_.getIterations()); i_ > 0; --i_) {\n";
+    pimpl->state_fce->generateInvocation(
+        pimpl->output, pimpl->indent + 3, "stateFunction");
+    pimpl->output << "\n";
+    Formatting::printIndent(pimpl->output, pimpl->indent + 2);
+    pimpl->output << "}\n";
+    Formatting::printIndent(pimpl->output, pimpl->indent + 1);
+    pimpl->output << "}\n";
+    Formatting::printIndent(pimpl->output, pimpl->indent + 1);
+    pimpl->output << "benchmark_.report();\n";
+  }
+  else {
+    pimpl->state_fce->generateInvocation(
+        pimpl->output, pimpl->indent + 1, "stateFunction");
+    pimpl->output << "\n";
+  }
   Formatting::printIndent(pimpl->output, pimpl->indent);
   pimpl->output << "}\n";
   Formatting::printIndent(pimpl->output, pimpl->indent - 2);
@@ -736,6 +879,7 @@ void GeneratorStd::leaveState() {
   pimpl->objectpath.pop_back();
   pimpl->variables = pimpl->variables->getPrevLevel();
   pimpl->state_fce = nullptr;
+  pimpl->benchmark_state = false;
 }
 
 void GeneratorStd::leaveCase() {
@@ -857,23 +1001,30 @@ void GeneratorStd::endFile(
     const Location& last_) {
   assert(!pimpl->objects.empty());
 
-  /* -- generate registration of suites */
+  /* -- Generate registration of suites. The name of the registrator is
+   *    unique to allow merging of several generated files into one
+   *    translation unit. */
   if(!pimpl->objects.back()->isEmpty()) {
+    Sha256 digest_;
+    digest_.addString(pimpl->infile);
+    const std::string suffix_(digest_.finish().substr(0, 16));
+    const std::string registrator_("ObjectsRegistrator_" + suffix_);
+
     pimpl->output << "\n";
     Formatting::printIndent(pimpl->output, pimpl->indent);
     pimpl->output << "namespace {\n\n";
     Formatting::printIndent(pimpl->output, pimpl->indent);
-    pimpl->output << "class ObjectsRegistrator {\n";
+    pimpl->output << "class " << registrator_ << " {\n";
     Formatting::printIndent(pimpl->output, pimpl->indent + 1);
     pimpl->output << "public:\n";
     Formatting::printIndent(pimpl->output, pimpl->indent + 2);
-    pimpl->output << "ObjectsRegistrator() {\n";
+    pimpl->output << registrator_ << "() {\n";
     pimpl->objects.back()->printRegistrationsInFile(
         pimpl->output, pimpl->domain, pimpl->indent + 3);
     Formatting::printIndent(pimpl->output, pimpl->indent + 2);
     pimpl->output << "}\n";
     Formatting::printIndent(pimpl->output, pimpl->indent);
-    pimpl->output << "} registrator_of_generated_test_objects;\n\n";
+    pimpl->output << "} registrator_of_generated_test_objects_" << suffix_ << ";\n\n";
     Formatting::printIndent(pimpl->output, pimpl->indent);
     pimpl->output << "} /* -- namespace */\n";
   }
@@ -882,6 +1033,8 @@ void GeneratorStd::endFile(
   pimpl->reader->writePart(pimpl->output, last_, nullptr);
 
   pimpl->objects.pop_back();
+
+  pimpl->writeFile();
 }
 
 } /* -- namespace OTest2 */
@@ -75,12 +75,14 @@ class GeneratorStd : public Generator {
     virtual void makeAssertion(
         const std::string& assertion_class_,
         const std::string& assertion_method_,
-        const std::vector<AssertionArg>& args_ranges_) override;
+        const std::vector<AssertionArg>& args_ranges_,
+        const std::string& declaration_file_) override;
     virtual void makeStateSwitch(
         const Location& state_begin_,
         const Location& state_end_,
         const Location& delay_begin_,
-        const Location& delay_end_) override;
+        const Location& delay_end_,
+        const std::vector<AssertionArg>& wait_sources_) override;
     virtual void makeTryCatchBegin(
         const Location& begin_) override;
     virtual void makeCatchHandler(
@@ -102,6 +104,7 @@ class GeneratorStd : public Generator {
     virtual void enterState(
         const std::string& name_,
         bool first_,
+        bool benchmark_,
         FunctionPtr state_fce_,
         const Location& fbegin_,
         const Location& fend_) override;
@@ -19,11 +19,15 @@
 
 #include "options.h"
 
+#include <climits>
 #include <cstdlib>
 #include <fstream>
 #include <getopt.h>
 #include <iostream>
+#include <set>
+#include <stdlib.h>
 #include <string>
+#include <thread>
 
 #include "error.h"
 
@@ -40,13 +44,35 @@ void printHelp(
   os_ << std::endl;
   os_ << "  OTest2 preprocessor" << std::endl;
   os_ << std::endl;
-  os_ << "Usage: otest2 -s srcfile [-o outfile] [-d domain] [-- compiler options...]" << std::endl;
+  os_ << "Usage: otest2 -s srcfile [-o outfile] [-s srcfile [-o outfile]...]" << std::endl;
+  os_ << "              [-b listfile] [-j jobs] [-p header [-P pchfile]] [-c dir]" << std::endl;
+  os_ << "              [-d domain] [-- compiler options...]" << std::endl;
   os_ << std::endl;
   os_ << "  -h          --help             Print this help message." << std::endl;
   os_ << "  -s infile   --srcfile=infile   Name of the input file." << std::endl;
   os_ << "  -o outfile  --outfile=outfile  Name of the output file. By default, the name" << std::endl;
   os_ << "                                 is derived from the input filename by adding" << std::endl;
-  os_ << "                                 .cpp suffix." << std::endl;
+  os_ << "                                 .cpp suffix. The option belongs to the last" << std::endl;
+  os_ << "                                 preceding input file." << std::endl;
+  os_ << "  -b listfile --batch=listfile   Name of a file containing list of processed" << std::endl;
+  os_ << "                                 files. One file per line, the input file name" << std::endl;
+  os_ << "                                 is optionally followed by a tabulator and" << std::endl;
+  os_ << "                                 the output file name." << std::endl;
+  os_ << "  -j jobs     --jobs=jobs        Number of files parsed in parallel. The default" << std::endl;
+  os_ << "                                 value is number of available processors." << std::endl;
+  os_ << "  -p header   --pch=header       Precompile the header and include it into" << std::endl;
+  os_ << "                                 all processed files. The header should" << std::endl;
+  os_ << "                                 include the headers common for the test" << std::endl;
+  os_ << "                                 files. The precompiled header is built" << std::endl;
+  os_ << "                                 again only if it's out of date." << std::endl;
+  os_ << "  -P pchfile  --pch-file=pchfile Name of the precompiled file. By default," << std::endl;
+  os_ << "                                 the name is derived from the header name" << std::endl;
+  os_ << "                                 by adding .pch suffix." << std::endl;
+  os_ << "  -c dir      --cache-dir=dir    Directory of the cache of generated files." << std::endl;
+  os_ << "                                 The default value is taken from" << std::endl;
+  os_ << "                                 the OTEST2_CACHE_DIR environment variable." << std::endl;
+  os_ << "                                 The cache is not used if no directory is" << std::endl;
+  os_ << "                                 set." << std::endl;
   os_ << "  -d domain   --domain=domain    Name of the test domain. The default value is" << std::endl;
   os_ << "                                 'default'." << std::endl;
   os_ << std::endl;
@@ -77,12 +103,59 @@ void fillConfiguredIncludeDirectories(
   }
 }
 
+void addSourceFile(
+    std::vector<Options::SourceFile>& sources_,
+    const std::string& infile_,
+    const std::string& outfile_) {
+  if(infile_.empty())
+    throw Error("empty name of an input file");
+  sources_.push_back({infile_, outfile_});
+}
+
+void readBatchFile(
+    std::vector<Options::SourceFile>& sources_,
+    const std::string& batch_file_) {
+  std::ifstream ifs_(batch_file_);
+  if(!ifs_)
+    throw Error("cannot open the batch file '" + batch_file_ + "'");
+  std::string line_;
+  while(std::getline(ifs_, line_)) {
+    std::string infile_;
+    std::string outfile_;
+    const auto tab_(line_.find('\t'));
+    if(tab_ != std::string::npos) {
+      infile_ = line_.substr(0, tab_);
+      outfile_ = line_.substr(tab_ + 1);
+      trimString(outfile_);
+    }
+    else
+      infile_ = line_;
+    trimString(infile_);
+    if(!infile_.empty())
+      addSourceFile(sources_, infile_, outfile_);
+  }
+}
+
+std::string canonicalSourcePath(
+    const std::string& infile_) {
+  /* -- The parser identifies the files by their absolute paths. If the file
+   *    cannot be resolved, it's left to the parser to complain. */
+  char resolved_[PATH_MAX];
+  if(::realpath(infile_.c_str(), resolved_) != nullptr)
+    return resolved_;
+  return infile_;
+}
+
 } /* -- namespace */
 
 Options::Options(
     int argc_,
     char* argv_[]) :
-  domain("default") {
+  domain("default"),
+  jobs(0) {
+  const char* cache_dir_(std::getenv("OTEST2_CACHE_DIR"));
+  if(cache_dir_ != nullptr)
+    cache_dir = cache_dir_;
 
   /* -- parse command line options */
   struct option longopts_[] = {
@@ -90,10 +163,16 @@ Options::Options(
       {"domain", required_argument, nullptr, 'd'},
       {"srcfile", required_argument, nullptr, 's'},
       {"outfile", required_argument, nullptr, 'o'},
+      {"batch", required_argument, nullptr, 'b'},
+      {"jobs", required_argument, nullptr, 'j'},
+      {"pch", required_argument, nullptr, 'p'},
+      {"pch-file", required_argument, nullptr, 'P'},
+      {"cache-dir", required_argument, nullptr, 'c'},
       {nullptr, 0, nullptr, 0}
   };
+  std::string pending_outfile_;
   int opt_;
-  while((opt_ = getopt_long(argc_, argv_, "hd:s:o:", longopts_, nullptr)) != EOF) {
+  while((opt_ = getopt_long(argc_, argv_, "hd:s:o:b:j:p:P:c:", longopts_, nullptr)) != EOF) {
     switch(opt_) {
       case 'h':
         printHelp(std::cout);
@@ -102,10 +181,32 @@ Options::Options(
         domain = optarg;
         break;
       case 's':
-        infile = optarg;
+        /* -- the output file may precede the input file */
+        addSourceFile(sources, optarg, pending_outfile_);
+        pending_outfile_.clear();
         break;
       case 'o':
-        outfile = optarg;
+        if(!sources.empty() && sources.back().outfile.empty())
+          sources.back().outfile = optarg;
+        else
+          pending_outfile_ = optarg;
+        break;
+      case 'b':
+        readBatchFile(sources, optarg);
+        break;
+      case 'j':
+        jobs = std::atoi(optarg);
+        if(jobs <= 0)
+          throw Error("invalid number of jobs");
+        break;
+      case 'p':
+        pch_header = optarg;
+        break;
+      case 'P':
+        pch_file = optarg;
+        break;
+      case 'c':
+        cache_dir = optarg;
         break;
       default:
         printHelp(std::cerr);
@@ -113,15 +214,33 @@ Options::Options(
     }
   }
 
-  /* -- check name of the source file */
-  if(infile.empty())
+  /* -- check names of the source files */
+  if(sources.empty())
     throw Error("no input file is specified");
+  if(!pending_outfile_.empty())
+    throw Error("the output file '" + pending_outfile_ + "' has no input file");
+  std::set<std::string> known_sources_;
+  for(const auto& source_ : sources) {
+    if(!known_sources_.insert(canonicalSourcePath(source_.infile)).second)
+      throw Error("the input file '" + source_.infile + "' is specified more than once");
+  }
 
-  /* -- compute name of the output file, if it's not specified */
-  if(outfile.empty()) {
-    outfile = infile + ".cpp";
+  /* -- compute names of the output files, if they're not specified */
+  for(auto& source_ : sources) {
+    if(source_.outfile.empty())
+      source_.outfile = source_.infile + ".cpp";
   }
 
+  /* -- compute name of the precompiled file */
+  if(!pch_header.empty() && pch_file.empty())
+    pch_file = pch_header + ".pch";
+
+  /* -- by default, the files are parsed by all available processors */
+  if(jobs <= 0)
+    jobs = static_cast<int>(std::thread::hardware_concurrency());
+  if(jobs <= 0)
+    jobs = 1;
+
   /* -- store options of the compiler */
   for(int i_(optind); i_ < argc_; ++i_)
     compiler_options.emplace_back(argv_[i_]);
@@ -131,12 +250,38 @@ Options::~Options() {
 
 }
 
-const std::string& Options::getInfile() const noexcept {
-  return infile;
+const std::vector<Options::SourceFile>& Options::getSources() const noexcept {
+  return sources;
+}
+
+int Options::getJobs() const noexcept {
+  return jobs;
 }
 
-const std::string& Options::getOutfile() const noexcept {
-  return outfile;
+const std::string& Options::getPCHHeader() const noexcept {
+  return pch_header;
+}
+
+const std::string& Options::getPCHFile() const noexcept {
+  return pch_file;
+}
+
+const std::string& Options::getCacheDir() const noexcept {
+  return cache_dir;
+}
+
+std::string Options::getCacheKey() const {
+  std::vector<std::string> options_;
+  fillCompilerOptions(options_);
+  options_.push_back("--domain=" + domain);
+  options_.push_back("--pch=" + pch_header);
+
+  std::string key_;
+  for(const auto& option_ : options_) {
+    key_ += option_;
+    key_ += '\n';
+  }
+  return key_;
 }
 
 const std::string& Options::getDomain() const noexcept {
@@ -145,6 +290,18 @@ const std::string& Options::getDomain() const noexcept {
 
 void Options::fillClangToolOptions(
     std::vector<std::string>& options_) const {
+  fillCompilerOptions(options_);
+
+  /* -- add the input files */
+  for(const auto& source_ : sources)
+    options_.push_back(source_.infile);
+
+  /* -- this avoid searching for the Clang's compilation database */
+  options_.emplace_back("--");
+}
+
+void Options::fillCompilerOptions(
+    std::vector<std::string>& options_) const {
   /* -- name of the application shown in the output messages */
   options_.emplace_back("otest2");
 
@@ -176,12 +333,6 @@ void Options::fillClangToolOptions(
     fillConfiguredIncludeDirectories(options_, home_cfg_);
   }
   fillConfiguredIncludeDirectories(options_, GLOBAL_CONFIG_FILE);
-
-  /* -- add the input file */
-  options_.push_back(infile);
-
-  /* -- this avoid searching for the Clang's compilation database */
-  options_.emplace_back("--");
 }
 
 } /* namespace OTest2 */
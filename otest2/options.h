@@ -29,11 +29,23 @@ namespace OTest2 {
  * @brief Options of the otest2 parser
  */
 struct Options {
+  public:
+    /**
+     * @brief One processed source file
+     */
+    struct SourceFile {
+        std::string infile;     /**< name of the input file */
+        std::string outfile;    /**< name of the output file */
+    };
+
   private:
     std::string config_file;
     std::string domain;
-    std::string infile;
-    std::string outfile;
+    std::vector<SourceFile> sources;
+    int jobs;
+    std::string pch_header;
+    std::string pch_file;
+    std::string cache_dir;
     std::vector<std::string> compiler_options;
 
   public:
@@ -59,14 +71,40 @@ struct Options {
         const Options&) = delete;
 
     /**
-     * @brief Get input file name
+     * @brief Get list of processed source files
+     *
+     * @note The list is never empty.
+     */
+    const std::vector<SourceFile>& getSources() const noexcept;
+
+    /**
+     * @brief Get number of parallel parser jobs
+     */
+    int getJobs() const noexcept;
+
+    /**
+     * @brief Get name of the precompiled header
+     *
+     * @return The name or an empty string if no header is precompiled
+     */
+    const std::string& getPCHHeader() const noexcept;
+
+    /**
+     * @brief Get name of the file of the precompiled header
      */
-    const std::string& getInfile() const noexcept;
+    const std::string& getPCHFile() const noexcept;
 
     /**
-     * @brief Get output file name
+     * @brief Get directory of the cache of generated files
+     *
+     * @return The directory or an empty string if the cache is not used
      */
-    const std::string& getOutfile() const noexcept;
+    const std::string& getCacheDir() const noexcept;
+
+    /**
+     * @brief Get a key describing all options affecting the generated files
+     */
+    std::string getCacheKey() const;
 
     /**
      * @brief Get the OTest2 registration domain
@@ -80,6 +118,10 @@ struct Options {
      */
     void fillClangToolOptions(
         std::vector<std::string>& options_) const;
+
+  private:
+    void fillCompilerOptions(
+        std::vector<std::string>& options_) const;
 };
 
 } /* namespace OTest2 */
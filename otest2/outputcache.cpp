@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "outputcache.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "error.h"
+#include "sha256.h"
+
+namespace OTest2 {
+
+namespace {
+
+const char MANIFEST_SUFFIX[] = ".manifest";
+const char OUTPUT_SUFFIX[] = ".cpp";
+
+/* -- a version tag of the cache format and of the generator */
+const char CACHE_VERSION[] = "otest2-cache-1";
+
+void makeDirectories(
+    const std::string& dir_) {
+  std::string::size_type pos_(0);
+  while(pos_ != std::string::npos) {
+    pos_ = dir_.find('/', pos_ + 1);
+    const std::string part_(dir_.substr(0, pos_));
+    if(::mkdir(part_.c_str(), 0777) < 0 && errno != EEXIST)
+      throw Error("cannot create the cache directory '" + dir_ + "'");
+  }
+}
+
+bool writeFileAtomically(
+    const std::string& file_,
+    const std::string& content_) {
+  static std::atomic<unsigned int> counter_(0);
+  std::ostringstream tmp_;
+  tmp_ << file_ << '.' << ::getpid() << '.' << counter_++ << ".tmp";
+  {
+    std::ofstream ofs_(tmp_.str(), std::ios::binary);
+    ofs_.write(content_.data(), content_.size());
+    if(!ofs_) {
+      std::remove(tmp_.str().c_str());
+      return false;
+    }
+  }
+  if(std::rename(tmp_.str().c_str(), file_.c_str()) != 0) {
+    std::remove(tmp_.str().c_str());
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Identify the running preprocessor
+ *
+ * The outputs of different builds of the preprocessor may differ.
+ */
+std::string getGeneratorKey() {
+  struct stat stat_;
+  if(::stat("/proc/self/exe", &stat_) < 0)
+    return std::string();
+  std::ostringstream oss_;
+  oss_ << stat_.st_size << ':' << stat_.st_mtim.tv_sec << '.'
+      << stat_.st_mtim.tv_nsec;
+  return oss_.str();
+}
+
+} /* -- namespace */
+
+bool readFileContent(
+    const std::string& file_,
+    std::string& content_) {
+  std::ifstream ifs_(file_, std::ios::binary);
+  if(!ifs_)
+    return false;
+  content_.assign(
+      std::istreambuf_iterator<char>(ifs_),
+      std::istreambuf_iterator<char>());
+  return !ifs_.bad();
+}
+
+bool writeFileIfChanged(
+    const std::string& file_,
+    const std::string& content_) {
+  std::string current_;
+  if(readFileContent(file_, current_) && current_ == content_)
+    return true;
+  std::ofstream ofs_(file_, std::ios::binary | std::ios::trunc);
+  ofs_.write(content_.data(), content_.size());
+  return !!ofs_;
+}
+
+OutputCache::OutputCache(
+    const std::string& cache_dir_,
+    const std::string& options_key_) :
+  cache_dir(cache_dir_),
+  options_key(options_key_),
+  generator_key(getGeneratorKey()) {
+  makeDirectories(cache_dir);
+}
+
+OutputCache::~OutputCache() {
+
+}
+
+bool OutputCache::getFileDigest(
+    const std::string& file_,
+    std::string& digest_) {
+  {
+    std::lock_guard<std::mutex> guard_(lock);
+    auto iter_(file_digests.find(file_));
+    if(iter_ != file_digests.end()) {
+      digest_ = iter_->second;
+      return true;
+    }
+  }
+
+  std::string content_;
+  if(!readFileContent(file_, content_))
+    return false;
+  Sha256 sha_;
+  sha_.addData(content_.data(), content_.size());
+  digest_ = sha_.finish();
+
+  std::lock_guard<std::mutex> guard_(lock);
+  file_digests[file_] = digest_;
+  return true;
+}
+
+bool OutputCache::getManifestKey(
+    const std::string& infile_,
+    const std::string& outfile_,
+    std::string& key_) {
+  std::string content_;
+  if(!readFileContent(infile_, content_))
+    return false;
+
+  Sha256 sha_;
+  sha_.addString(CACHE_VERSION);
+  sha_.addString(generator_key);
+  sha_.addString(options_key);
+  sha_.addString(infile_);
+  sha_.addString(outfile_);
+  sha_.addData(content_.data(), content_.size());
+  key_ = sha_.finish();
+  return true;
+}
+
+bool OutputCache::getOutputKey(
+    const std::string& manifest_key_,
+    const std::vector<std::string>& deps_,
+    std::string& key_) {
+  Sha256 sha_;
+  sha_.addString(manifest_key_);
+  for(const auto& dep_ : deps_) {
+    std::string digest_;
+    if(!getFileDigest(dep_, digest_))
+      return false;
+    sha_.addString(dep_);
+    sha_.addString(digest_);
+  }
+  key_ = sha_.finish();
+  return true;
+}
+
+bool OutputCache::lookup(
+    const std::string& infile_,
+    const std::string& outfile_,
+    std::string& output_) {
+  std::string manifest_key_;
+  if(!getManifestKey(infile_, outfile_, manifest_key_))
+    return false;
+
+  /* -- read the list of dependencies */
+  std::ifstream manifest_(cache_dir + "/" + manifest_key_ + MANIFEST_SUFFIX);
+  if(!manifest_)
+    return false;
+  std::vector<std::string> deps_;
+  std::string dep_;
+  while(std::getline(manifest_, dep_)) {
+    if(!dep_.empty())
+      deps_.push_back(dep_);
+  }
+
+  /* -- look up the output */
+  std::string output_key_;
+  if(!getOutputKey(manifest_key_, deps_, output_key_))
+    return false;
+  return readFileContent(cache_dir + "/" + output_key_ + OUTPUT_SUFFIX, output_);
+}
+
+void OutputCache::store(
+    const std::string& infile_,
+    const std::string& outfile_,
+    const std::vector<std::string>& deps_,
+    const std::string& output_) {
+  /* -- Failures of the cache are not fatal. The file is just generated
+   *    again next time. */
+  std::string manifest_key_;
+  std::string output_key_;
+  if(!getManifestKey(infile_, outfile_, manifest_key_)
+      || !getOutputKey(manifest_key_, deps_, output_key_))
+    return;
+
+  std::ostringstream manifest_;
+  for(const auto& dep_ : deps_)
+    manifest_ << dep_ << '\n';
+  if(writeFileAtomically(cache_dir + "/" + output_key_ + OUTPUT_SUFFIX, output_))
+    writeFileAtomically(
+        cache_dir + "/" + manifest_key_ + MANIFEST_SUFFIX, manifest_.str());
+}
+
+} /* -- namespace OTest2 */
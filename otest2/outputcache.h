@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__OTEST2_OUTPUTCACHE_H_
+#define OTest2__OTEST2_OUTPUTCACHE_H_
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace OTest2 {
+
+/**
+ * @brief Content-addressed cache of generated files
+ *
+ * The cache works in two steps. Firstly, a manifest is looked up by a digest
+ * of the input file, its names and the preprocessor options. The manifest
+ * contains list of files the input file depends on (the included headers).
+ * Secondly, the generated output is looked up by a digest combining
+ * the manifest key and current contents of the dependencies.
+ *
+ * All methods are thread-safe.
+ */
+class OutputCache {
+  private:
+    std::string cache_dir;
+    std::string options_key;
+    std::string generator_key;
+
+    std::mutex lock;
+    std::map<std::string, std::string> file_digests;
+
+  public:
+    /**
+     * @brief Ctor
+     *
+     * @param cache_dir_ The cache directory. It's created if it doesn't exist.
+     * @param options_key_ A string describing all options which affect
+     *     the generated output
+     */
+    explicit OutputCache(
+        const std::string& cache_dir_,
+        const std::string& options_key_);
+
+    /**
+     * @brief Dtor
+     */
+    ~OutputCache();
+
+    /* -- avoid copying */
+    OutputCache(
+        const OutputCache&) = delete;
+    OutputCache& operator =(
+        const OutputCache&) = delete;
+
+    /**
+     * @brief Look up a cached output
+     *
+     * @param infile_ Name of the input file
+     * @param outfile_ Name of the output file
+     * @param[out] output_ The cached output
+     * @return True if the output has been found
+     */
+    bool lookup(
+        const std::string& infile_,
+        const std::string& outfile_,
+        std::string& output_);
+
+    /**
+     * @brief Store a generated output
+     *
+     * @param infile_ Name of the input file
+     * @param outfile_ Name of the output file
+     * @param deps_ Files the output depends on
+     * @param output_ The generated output
+     */
+    void store(
+        const std::string& infile_,
+        const std::string& outfile_,
+        const std::vector<std::string>& deps_,
+        const std::string& output_);
+
+  private:
+    bool getFileDigest(
+        const std::string& file_,
+        std::string& digest_);
+    bool getManifestKey(
+        const std::string& infile_,
+        const std::string& outfile_,
+        std::string& key_);
+    bool getOutputKey(
+        const std::string& manifest_key_,
+        const std::vector<std::string>& deps_,
+        std::string& key_);
+};
+
+/**
+ * @brief Read content of a file
+ *
+ * @param file_ Name of the file
+ * @param[out] content_ The content
+ * @return False if the file cannot be read
+ */
+bool readFileContent(
+    const std::string& file_,
+    std::string& content_);
+
+/**
+ * @brief Write a file unless it already contains the same content
+ *
+ * Keeping of the file untouched preserves its modification time. Hence,
+ * build systems don't rebuild anything depending on the file.
+ *
+ * @param file_ Name of the file
+ * @param content_ The new content
+ * @return False if the file cannot be written
+ */
+bool writeFileIfChanged(
+    const std::string& file_,
+    const std::string& content_);
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__OTEST2_OUTPUTCACHE_H_ */
@@ -25,24 +25,33 @@
 #include <clang/Basic/SourceManager.h>
 #include <clang/Frontend/FrontendAction.h>
 #include <clang/Frontend/CompilerInstance.h>
+#include <clang/Tooling/ArgumentsAdjusters.h>
 #include <clang/Tooling/CommonOptionsParser.h>
 #include <clang/Tooling/Tooling.h>
 #include <llvm/Support/CommandLine.h>
 #include <otest2/exc.h>
 #include <otest2/utils.h>
+#include <algorithm>
+#include <cstddef>
 #include <fstream>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <unistd.h>
 #include <vector>
 
+#include "error.h"
 #include "excparser.h"
 #include "filereader.h"
 #include "generatorstd.h"
 #include "options.h"
+#include "outputcache.h"
 #include "parsercontext.h"
 #include "parsersuite.h"
+#include "pch.h"
 
 namespace OTest2 {
 
@@ -65,6 +74,8 @@ class ParserConsumer : public clang::ASTConsumer {
 
     void HandleTranslationUnit(
         clang::ASTContext& context_) final;
+    bool shouldSkipFunctionBody(
+        clang::Decl* decl_) final;
 };
 
 ParserConsumer::ParserConsumer(
@@ -97,17 +108,41 @@ void ParserConsumer::HandleTranslationUnit(
     context.generator->endFile(context.last_location);
 }
 
+bool ParserConsumer::shouldSkipFunctionBody(
+    clang::Decl* decl_) {
+  /* -- only bodies written in the test file are needed */
+  return !context.isInMainFile(decl_->getLocation());
+}
+
+/**
+ * @brief State of one parsed source file
+ */
+struct SourceJob {
+    const Options::SourceFile* source;
+    bool cached;                /**< the output is taken from the cache */
+    bool compiled;              /**< the clang has compiled the file */
+    bool failure;               /**< the otest2 parser has failed */
+    ParserException exception;  /**< the otest2 parser error */
+    std::string output;         /**< the generated output */
+    std::vector<std::string> deps;  /**< files the output depends on */
+};
+
+typedef std::map<std::string, SourceJob*> SourceJobs;
+
 class ParserAction : public clang::ASTFrontendAction {
   private:
-    Generator* generator;
-    bool* failure;
-    ParserException* exception;
+    const std::string* domain;
+    const SourceJobs* jobs;
+    SourceJob* job;
+    std::ifstream ifs;
+    std::unique_ptr<FileReader> reader;
+    std::ostringstream output;
+    std::unique_ptr<GeneratorStd> generator;
 
   public:
     explicit ParserAction(
-        Generator* generator_,
-        bool* failure_,
-        ParserException* exception_);
+        const std::string* domain_,
+        const SourceJobs* jobs_);
     virtual ~ParserAction();
 
     /* -- avoid copying */
@@ -118,16 +153,16 @@ class ParserAction : public clang::ASTFrontendAction {
 
     std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(
         clang::CompilerInstance& ci_,
-        clang::StringRef) final;
+        clang::StringRef strref_) final;
+    void EndSourceFileAction() final;
 };
 
 ParserAction::ParserAction(
-    Generator* generator_,
-    bool* failure_,
-    ParserException* exception_) :
-  generator(generator_),
-  failure(failure_),
-  exception(exception_) {
+    const std::string* domain_,
+    const SourceJobs* jobs_) :
+  domain(domain_),
+  jobs(jobs_),
+  job(nullptr) {
 
 }
 
@@ -138,38 +173,71 @@ ParserAction::~ParserAction() {
 std::unique_ptr<clang::ASTConsumer> ParserAction::CreateASTConsumer(
     clang::CompilerInstance& ci_,
     clang::StringRef strref_) {
+  /* -- find the processed file */
+  auto iter_(jobs->find(clang::tooling::getAbsolutePath(strref_)));
+  if(iter_ == jobs->end())
+    return nullptr;
+  job = iter_->second;
+
+  /* -- prepare the reader and the output generator */
+  ifs.open(job->source->infile);
+  reader = ::OTest2::make_unique<FileReader>(&ifs);
+
+  /* -- Skip bodies of functions declared in the headers. The consumer
+   *    decides which bodies are skipped. */
+  ci_.getFrontendOpts().SkipFunctionBodies = true;
+
+  /* -- The output is generated into a buffer. The output file is written
+   *    only if its content changes. */
+  generator = ::OTest2::make_unique<GeneratorStd>(
+      &output,
+      reader.get(),
+      *domain,
+      job->source->infile,
+      job->source->outfile);
+
   return ::OTest2::make_unique<ParserConsumer>(
-      generator,
-      failure,
-      exception,
+      generator.get(),
+      &job->failure,
+      &job->exception,
       &ci_.getASTContext(),
       &ci_.getSourceManager(),
       &ci_.getLangOpts());
 }
 
+void ParserAction::EndSourceFileAction() {
+  if(job != nullptr) {
+    clang::CompilerInstance& ci_(getCompilerInstance());
+    job->compiled = !ci_.getDiagnostics().hasErrorOccurred();
+
+    /* -- collect the generated output and its dependencies */
+    generator.reset();
+    job->output = output.str();
+    clang::SourceManager& srcmgr_(ci_.getSourceManager());
+    for(auto iter_(srcmgr_.fileinfo_begin()); iter_ != srcmgr_.fileinfo_end(); ++iter_)
+      job->deps.push_back(iter_->first->getName().str());
+  }
+}
+
 class FrontendFactory : public clang::tooling::FrontendActionFactory {
   private:
-    Generator* generator;
-    bool* failure;
-    ParserException* exception;
+    const std::string* domain;
+    const SourceJobs* jobs;
 
   public:
     explicit FrontendFactory(
-        Generator* generator_,
-        bool* failure_,
-        ParserException* exception_);
+        const std::string* domain_,
+        const SourceJobs* jobs_);
     virtual ~FrontendFactory();
 
     clang::FrontendAction* create();
 };
 
 FrontendFactory::FrontendFactory(
-    Generator* generator_,
-    bool* failure_,
-    ParserException* exception_) :
-  generator(generator_),
-  failure(failure_),
-  exception(exception_) {
+    const std::string* domain_,
+    const SourceJobs* jobs_) :
+  domain(domain_),
+  jobs(jobs_) {
 
 }
 
@@ -178,7 +246,7 @@ FrontendFactory::~FrontendFactory() {
 }
 
 clang::FrontendAction* FrontendFactory::create() {
-  return new ParserAction(generator, failure, exception);
+  return new ParserAction(domain, jobs);
 }
 
 class ParserFailure : public Exception {
@@ -238,26 +306,7 @@ void parse(
   for(const auto& arg_ : opts_)
     argv_.push_back(arg_.c_str());
 
-  /* -- prepare the reader and the output generator */
-  std::ifstream ifs_(options_.getInfile());
-  FileReader reader_(&ifs_);
-  std::ostream *os_(nullptr);
-  std::ofstream ofs_;
-  if(options_.getOutfile() == "-") {
-    os_ = &std::cout;
-  }
-  else {
-    ofs_.open(options_.getOutfile());
-    os_ = &ofs_;
-  }
-  GeneratorStd generator_(
-      os_,
-      &reader_,
-      options_.getDomain(),
-      options_.getInfile(),
-      options_.getOutfile());
-
-  /* -- parse the file */
+  /* -- parse the options */
   llvm::cl::OptionCategory ParserOptCategory("otest2 options");
   llvm::cl::extrahelp CommonHelp(
       clang::tooling::CommonOptionsParser::HelpMessage);
@@ -265,24 +314,113 @@ void parse(
   int argc_(static_cast<int>(argv_.size()));
   clang::tooling::CommonOptionsParser parseropts_(
       argc_, argv_.data(), ParserOptCategory);
-  clang::tooling::ClangTool tool_(
-      parseropts_.getCompilations(),
-      parseropts_.getSourcePathList());
-  bool failure_(false);
-  ParserException exception_;
-  int retval_(
-      tool_.run(new Parser::FrontendFactory(&generator_, &failure_, &exception_)));
-  if(retval_ != 0) {
-    /* -- remove the half created file */
-    if(options_.getOutfile() != "-")
-      unlink(options_.getOutfile().c_str());
-
-    throw Parser::ParserFailure();
+
+  /* -- prepare the precompiled header */
+  const std::string& pch_header_(options_.getPCHHeader());
+  if(!pch_header_.empty()) {
+    preparePrecompiledHeader(
+        parseropts_.getCompilations(), pch_header_, options_.getPCHFile());
   }
 
-  /* -- report an error */
-  if(failure_)
-    throw ParserException(std::move(exception_));
+  /* -- prepare the jobs */
+  const auto& sources_(options_.getSources());
+  std::vector<Parser::SourceJob> jobs_(sources_.size());
+  for(std::size_t i_(0); i_ < sources_.size(); ++i_) {
+    jobs_[i_].source = &sources_[i_];
+    jobs_[i_].cached = false;
+    jobs_[i_].compiled = false;
+    jobs_[i_].failure = false;
+  }
+
+  /* -- look up the generated files in the cache */
+  std::unique_ptr<OutputCache> cache_;
+  if(!options_.getCacheDir().empty()) {
+    cache_ = ::OTest2::make_unique<OutputCache>(
+        options_.getCacheDir(), options_.getCacheKey());
+  }
+  std::vector<Parser::SourceJob*> pending_;
+  for(auto& job_ : jobs_) {
+    if(cache_ != nullptr
+        && cache_->lookup(job_.source->infile, job_.source->outfile, job_.output)) {
+      job_.cached = true;
+      job_.compiled = true;
+    }
+    else
+      pending_.push_back(&job_);
+  }
+
+  /* -- Split the files among the parser threads. Each thread runs its own
+   *    clang tool, hence the file manager and its cache of the headers
+   *    are shared by all files parsed in the thread. */
+  const std::size_t threads_(std::min(
+      static_cast<std::size_t>(options_.getJobs()), pending_.size()));
+  auto parse_chunk_([&](std::size_t chunk_) {
+    std::vector<std::string> paths_;
+    Parser::SourceJobs chunk_jobs_;
+    for(std::size_t i_(chunk_); i_ < pending_.size(); i_ += threads_) {
+      Parser::SourceJob* job_(pending_[i_]);
+      paths_.push_back(job_->source->infile);
+      chunk_jobs_[clang::tooling::getAbsolutePath(job_->source->infile)] = job_;
+    }
+    clang::tooling::ClangTool tool_(parseropts_.getCompilations(), paths_);
+    if(!pch_header_.empty()) {
+      tool_.appendArgumentsAdjuster(
+          clang::tooling::getInsertArgumentAdjuster(
+              {"-include-pch", options_.getPCHFile()},
+              clang::tooling::ArgumentInsertPosition::BEGIN));
+    }
+    Parser::FrontendFactory factory_(&options_.getDomain(), &chunk_jobs_);
+    tool_.run(&factory_);
+  });
+  std::vector<std::thread> workers_;
+  for(std::size_t chunk_(1); chunk_ < threads_; ++chunk_)
+    workers_.emplace_back(parse_chunk_, chunk_);
+  if(threads_ > 0)
+    parse_chunk_(0);
+  for(auto& worker_ : workers_)
+    worker_.join();
+
+  /* -- Write the generated files. The files with unchanged content are
+   *    not touched to avoid unnecessary recompilation. */
+  std::vector<Parser::SourceJob*> failed_;
+  for(auto& job_ : jobs_) {
+    if(!job_.compiled || job_.failure) {
+      /* -- remove the out of date file */
+      if(job_.source->outfile != "-")
+        unlink(job_.source->outfile.c_str());
+      failed_.push_back(&job_);
+      continue;
+    }
+
+    if(job_.source->outfile == "-")
+      std::cout << job_.output;
+    else if(!writeFileIfChanged(job_.source->outfile, job_.output))
+      throw Error("cannot write the file '" + job_.source->outfile + "'");
+
+    if(cache_ != nullptr && !job_.cached) {
+      if(!pch_header_.empty())
+        job_.deps.push_back(options_.getPCHFile());
+      cache_->store(
+          job_.source->infile, job_.source->outfile, job_.deps, job_.output);
+    }
+  }
+  if(failed_.empty())
+    return;
+
+  /* -- report the errors */
+  if(failed_.size() == 1) {
+    if(failed_.front()->failure)
+      throw ParserException(std::move(failed_.front()->exception));
+    else
+      throw Parser::ParserFailure();
+  }
+  for(const auto* job_ : failed_) {
+    if(job_->failure)
+      std::cerr << job_->exception.reason() << std::endl;
+    else
+      std::cerr << job_->source->infile << ": the parser failed" << std::endl;
+  }
+  throw Parser::ParserFailure();
 }
 
 } /* -- namespace OTest2 */
@@ -19,6 +19,7 @@
 #include "parserassert.h"
 
 #include <clang/AST/Decl.h>
+#include <clang/Tooling/Tooling.h>
 #include <string>
 
 #include "generator.h"
@@ -127,7 +128,19 @@ bool AssertVisitor::generateAssertion(
     auto arg_end_(context->createLocation(range_.getEnd()));
     args_ranges_.push_back({arg_begin_, arg_end_});
   }
-  context->generator->makeAssertion(class_arg_, method_arg_, args_ranges_);
+
+  /* -- the header declaring the assertion function */
+  std::string declaration_file_;
+  const clang::SourceLocation decl_loc_(
+      context->srcmgr->getFileLoc(fce_->getLocation()));
+  if(!context->srcmgr->isWrittenInMainFile(decl_loc_)) {
+    const auto file_(context->srcmgr->getFilename(decl_loc_));
+    if(!file_.empty())
+      declaration_file_ = clang::tooling::getAbsolutePath(file_);
+  }
+
+  context->generator->makeAssertion(
+      class_arg_, method_arg_, args_ranges_, declaration_file_);
 
   /* -- keep last position for next source copying */
   auto endarg_(expr_->getArg(last_index_));
@@ -261,7 +274,7 @@ bool AssertVisitor::visitSwitchState(
     clang::FunctionDecl* fce_) {
   /* -- find first and last non-default argument */
   const int argnum_(expr_->getNumArgs());
-  if(argnum_ != 2) {
+  if(argnum_ < 2) {
     context->setError("invalid count of the state switching function", fce_);
     return false;
   }
@@ -282,12 +295,22 @@ bool AssertVisitor::visitSwitchState(
   auto delay_begin_(context->createLocation(delay_range_.getBegin()));
   auto delay_end_(context->createLocation(delay_range_.getEnd()));
 
+  /* -- optional wait sources */
+  std::vector<Generator::AssertionArg> wait_sources_;
+  for(int i_(2); i_ < argnum_; ++i_) {
+    clang::SourceRange source_range_(context->getNodeRange(expr_->getArg(i_)));
+    wait_sources_.push_back({
+        context->createLocation(source_range_.getBegin()),
+        context->createLocation(source_range_.getEnd())});
+  }
+
   /* -- generate the state switch */
   context->generator->makeStateSwitch(
       state_begin_,
       state_end_,
       delay_begin_,
-      delay_end_);
+      delay_end_,
+      wait_sources_);
 
   /* -- keep last position for next source copying */
   current = expr_end_;
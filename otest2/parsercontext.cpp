@@ -48,4 +48,13 @@ Location ParserContext::createLocation(
   return Location(ploc_.getLine(), ploc_.getColumn());
 }
 
+bool ParserContext::isInMainFile(
+    const clang::SourceLocation& loc_) const {
+  /* -- The DSL macros are expanded in the main file. Hence, the location
+   *    of the expansion is checked. */
+  if(loc_.isInvalid())
+    return false;
+  return srcmgr->isWrittenInMainFile(srcmgr->getExpansionLoc(loc_));
+}
+
 } /* -- namespace OTest2 */
@@ -63,6 +63,8 @@ struct ParserContext {
 
     Location createLocation(
         const clang::SourceLocation& loc_);
+    bool isInMainFile(
+        const clang::SourceLocation& loc_) const;
     template<typename Node_>
     clang::SourceRange getNodeRange(
         Node_* node_);
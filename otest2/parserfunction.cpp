@@ -179,8 +179,15 @@ std::pair<bool, bool> parseFunction(
 
       return {true, false};
     }
-    else if(hasAnnotation(fce_, STATE_ANNOTATION) || hasAnnotation(fce_, SCENARIO_ANNOTATION)) {
-      const bool scenario_flag_(hasAnnotation(fce_, SCENARIO_ANNOTATION));
+    else if(hasAnnotation(fce_, STATE_ANNOTATION)
+        || hasAnnotation(fce_, SCENARIO_ANNOTATION)
+        || hasAnnotation(fce_, BENCHMARK_ANNOTATION)) {
+      /* -- The benchmark is a scenario state whose body is measured
+       *    in a loop. Sections are not allowed in it as the body
+       *    runs many times in one run of the case. */
+      const bool benchmark_flag_(hasAnnotation(fce_, BENCHMARK_ANNOTATION));
+      const bool scenario_flag_(
+          benchmark_flag_ || hasAnnotation(fce_, SCENARIO_ANNOTATION));
       if(!fce_flags_.test_state) {
         context_->setError("unexpected test state function", fce_);
         return {false, true};
@@ -205,8 +212,13 @@ std::pair<bool, bool> parseFunction(
 
       /* -- enter the test case */
       context_->generator->enterState(
-          fce_->getNameAsString(), entering_state_, function_, decl_begin_, decl_end_);
-      if(!parseCodeBlock(context_, body_, scenario_flag_))
+          fce_->getNameAsString(),
+          entering_state_,
+          benchmark_flag_,
+          function_,
+          decl_begin_,
+          decl_end_);
+      if(!parseCodeBlock(context_, body_, scenario_flag_ && !benchmark_flag_))
         return {false, true};
       context_->generator->leaveState();
 
@@ -222,6 +222,18 @@ bool parseRootObject(
   return true;
 }
 
+bool SuiteVisitor::TraverseDecl(
+    clang::Decl* decl_) {
+  /* -- The suites and cases can be declared only in the main file. Don't
+   *    waste time by traversing the included headers. */
+  if(decl_ != nullptr
+      && !clang::isa<clang::TranslationUnitDecl>(decl_)
+      && !context->isInMainFile(decl_->getLocation())) {
+    return true;
+  }
+  return Parent::TraverseDecl(decl_);
+}
+
 bool SuiteVisitor::TraverseNamespaceDecl(
     clang::NamespaceDecl* ns_) {
   /* -- at this level suites and cases are allowed */
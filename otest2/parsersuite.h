@@ -24,6 +24,7 @@
 
 namespace clang {
 
+class Decl;
 class NamespaceDecl;
 
 } /* -- namespace clang */
@@ -52,6 +53,8 @@ class SuiteVisitor : public clang::RecursiveASTVisitor<SuiteVisitor> {
         ParserContext* context_);
     virtual ~SuiteVisitor();
 
+    bool TraverseDecl(
+        clang::Decl* decl_);
     bool TraverseNamespaceDecl(
         clang::NamespaceDecl* ns_);
 };
@@ -0,0 +1,314 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "pch.h"
+
+#include <clang/Basic/FileManager.h>
+#include <clang/Basic/SourceManager.h>
+#include <clang/Frontend/CompilerInstance.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Tooling/ArgumentsAdjusters.h>
+#include <clang/Tooling/Tooling.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "error.h"
+
+namespace OTest2 {
+
+namespace {
+
+const char DEPS_SUFFIX[] = ".deps";
+const char PCH_HEADER[] = "pch ";
+const char ARGS_HEADER[] = "args ";
+
+/**
+ * @brief Get modification time of a file
+ *
+ * @return False if the file doesn't exist
+ */
+bool getModificationTime(
+    const std::string& file_,
+    struct timespec& mtime_) {
+  struct stat stat_;
+  if(::stat(file_.c_str(), &stat_) < 0)
+    return false;
+  mtime_ = stat_.st_mtim;
+  return true;
+}
+
+/**
+ * @brief Get a stamp identifying the precompiled file
+ *
+ * The precompiled file and the .deps file cannot be replaced at once.
+ * The .deps file is replaced as the second one and it keeps the stamp
+ * of the precompiled file it belongs to. A mismatched pair left by
+ * an interrupted or a concurrent build is never considered up to date.
+ *
+ * @return False if the file doesn't exist
+ */
+bool getFileStamp(
+    const std::string& file_,
+    std::string& stamp_) {
+  struct stat stat_;
+  if(::stat(file_.c_str(), &stat_) < 0)
+    return false;
+  std::ostringstream oss_;
+  oss_ << stat_.st_dev << ':' << stat_.st_ino << ':' << stat_.st_size << ':'
+      << stat_.st_mtim.tv_sec << '.' << stat_.st_mtim.tv_nsec;
+  stamp_ = oss_.str();
+  return true;
+}
+
+bool isNewer(
+    const struct timespec& a_,
+    const struct timespec& b_) {
+  return a_.tv_sec > b_.tv_sec
+      || (a_.tv_sec == b_.tv_sec && a_.tv_nsec > b_.tv_nsec);
+}
+
+/**
+ * @brief Get the compiler arguments the header is built with
+ *
+ * The arguments are listed in the .deps file. The precompiled header is
+ * built again if the arguments change (e.g. a new macro definition).
+ */
+std::vector<std::string> getCompilerArguments(
+    const clang::tooling::CompilationDatabase& compilations_,
+    const std::string& header_) {
+  std::vector<std::string> args_;
+  for(const auto& command_ : compilations_.getCompileCommands(
+      clang::tooling::getAbsolutePath(header_))) {
+    args_.insert(
+        args_.end(), command_.CommandLine.begin(), command_.CommandLine.end());
+  }
+  return args_;
+}
+
+bool isUpToDate(
+    const std::vector<std::string>& args_,
+    const std::string& header_,
+    const std::string& pch_file_) {
+  struct timespec pch_time_;
+  if(!getModificationTime(pch_file_, pch_time_))
+    return false;
+
+  /* -- The header itself is listed in the dependencies too. However,
+   *    the check is cheap and it covers a missing list. */
+  struct timespec dep_time_;
+  if(!getModificationTime(header_, dep_time_) || isNewer(dep_time_, pch_time_))
+    return false;
+
+  std::ifstream deps_(pch_file_ + DEPS_SUFFIX);
+  if(!deps_)
+    return false;
+  std::string dep_;
+
+  /* -- the list must belong to the current precompiled file */
+  std::string stamp_;
+  if(!getFileStamp(pch_file_, stamp_)
+      || !std::getline(deps_, dep_)
+      || dep_ != PCH_HEADER + stamp_)
+    return false;
+
+  /* -- compare the compiler arguments */
+  if(!std::getline(deps_, dep_) || dep_ != ARGS_HEADER + std::to_string(args_.size()))
+    return false;
+  for(const auto& arg_ : args_) {
+    if(!std::getline(deps_, dep_) || dep_ != arg_)
+      return false;
+  }
+
+  /* -- check modification times of the dependencies */
+  while(std::getline(deps_, dep_)) {
+    if(dep_.empty())
+      continue;
+    if(!getModificationTime(dep_, dep_time_) || isNewer(dep_time_, pch_time_))
+      return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Generating action of the precompiled header
+ *
+ * The action redirects the output into a temporary file and it collects
+ * names of all files the header consists of.
+ */
+class PCHAction : public clang::GeneratePCHAction {
+  private:
+    std::string outfile;
+    std::vector<std::string>* deps;
+    bool* success;
+
+  public:
+    explicit PCHAction(
+        const std::string& outfile_,
+        std::vector<std::string>* deps_,
+        bool* success_);
+    virtual ~PCHAction();
+
+    /* -- avoid copying */
+    PCHAction(
+        const PCHAction&) = delete;
+    PCHAction& operator =(
+        const PCHAction&) = delete;
+
+    bool BeginInvocation(
+        clang::CompilerInstance& ci_) final;
+    void EndSourceFileAction() final;
+};
+
+PCHAction::PCHAction(
+    const std::string& outfile_,
+    std::vector<std::string>* deps_,
+    bool* success_) :
+  outfile(outfile_),
+  deps(deps_),
+  success(success_) {
+
+}
+
+PCHAction::~PCHAction() {
+
+}
+
+bool PCHAction::BeginInvocation(
+    clang::CompilerInstance& ci_) {
+  /* -- the clang tool strips the output file from the command line */
+  ci_.getFrontendOpts().OutputFile = outfile;
+  return clang::GeneratePCHAction::BeginInvocation(ci_);
+}
+
+void PCHAction::EndSourceFileAction() {
+  clang::CompilerInstance& ci_(getCompilerInstance());
+  *success = !ci_.getDiagnostics().hasErrorOccurred();
+
+  /* -- collect the dependencies */
+  clang::SourceManager& srcmgr_(ci_.getSourceManager());
+  for(auto iter_(srcmgr_.fileinfo_begin()); iter_ != srcmgr_.fileinfo_end(); ++iter_)
+    deps->push_back(iter_->first->getName().str());
+
+  clang::GeneratePCHAction::EndSourceFileAction();
+}
+
+class PCHFactory : public clang::tooling::FrontendActionFactory {
+  private:
+    std::string outfile;
+    std::vector<std::string>* deps;
+    bool* success;
+
+  public:
+    explicit PCHFactory(
+        const std::string& outfile_,
+        std::vector<std::string>* deps_,
+        bool* success_);
+    virtual ~PCHFactory();
+
+    clang::FrontendAction* create();
+};
+
+PCHFactory::PCHFactory(
+    const std::string& outfile_,
+    std::vector<std::string>* deps_,
+    bool* success_) :
+  outfile(outfile_),
+  deps(deps_),
+  success(success_) {
+
+}
+
+PCHFactory::~PCHFactory() {
+
+}
+
+clang::FrontendAction* PCHFactory::create() {
+  return new PCHAction(outfile, deps, success);
+}
+
+} /* -- namespace */
+
+void preparePrecompiledHeader(
+    const clang::tooling::CompilationDatabase& compilations_,
+    const std::string& header_,
+    const std::string& pch_file_) {
+  const std::vector<std::string> args_(
+      getCompilerArguments(compilations_, header_));
+  if(isUpToDate(args_, header_, pch_file_))
+    return;
+
+  /* -- Build the header into temporary files. Several preprocessors may
+   *    run in parallel, the final files are replaced atomically. */
+  const std::string suffix_("." + std::to_string(::getpid()) + ".tmp");
+  const std::string tmp_pch_(pch_file_ + suffix_);
+  const std::string tmp_deps_(pch_file_ + DEPS_SUFFIX + suffix_);
+
+  std::vector<std::string> deps_;
+  bool success_(false);
+  clang::tooling::ClangTool tool_(compilations_, {header_});
+  /* -- the header is compiled as a header, not as a C++ source */
+  tool_.appendArgumentsAdjuster(
+      [](const clang::tooling::CommandLineArguments& args_, clang::StringRef) {
+        clang::tooling::CommandLineArguments adjusted_;
+        for(const auto& arg_ : args_) {
+          if(arg_ == "-xc++")
+            adjusted_.push_back("-xc++-header");
+          else
+            adjusted_.push_back(arg_);
+        }
+        return adjusted_;
+      });
+  PCHFactory factory_(tmp_pch_, &deps_, &success_);
+  if(tool_.run(&factory_) != 0 || !success_) {
+    std::remove(tmp_pch_.c_str());
+    throw Error("cannot build the precompiled header '" + header_ + "'");
+  }
+
+  /* -- Store the stamp of the precompiled file, the compiler arguments
+   *    and the dependencies. The renaming keeps the stamp of the file. */
+  std::string stamp_;
+  bool stored_(getFileStamp(tmp_pch_, stamp_));
+  if(stored_) {
+    std::ofstream ofs_(tmp_deps_);
+    ofs_ << PCH_HEADER << stamp_ << '\n';
+    ofs_ << ARGS_HEADER << args_.size() << '\n';
+    for(const auto& arg_ : args_)
+      ofs_ << arg_ << '\n';
+    for(const auto& dep_ : deps_)
+      ofs_ << dep_ << '\n';
+    ofs_.close();
+    stored_ = !!ofs_;
+  }
+
+  /* -- the precompiled file first, the list of dependencies as the last */
+  if(!stored_
+      || std::rename(tmp_pch_.c_str(), pch_file_.c_str()) != 0
+      || std::rename(tmp_deps_.c_str(), (pch_file_ + DEPS_SUFFIX).c_str()) != 0) {
+    std::remove(tmp_deps_.c_str());
+    std::remove(tmp_pch_.c_str());
+    throw Error("cannot store the precompiled header '" + pch_file_ + "'");
+  }
+}
+
+} /* -- namespace OTest2 */
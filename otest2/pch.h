@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__OTEST2_PCH_H_
+#define OTest2__OTEST2_PCH_H_
+
+#include <string>
+
+namespace clang {
+namespace tooling {
+
+class CompilationDatabase;
+
+} /* -- namespace tooling */
+} /* -- namespace clang */
+
+namespace OTest2 {
+
+/**
+ * @brief Prepare the precompiled header
+ *
+ * The function checks whether the precompiled header is up to date. If it's
+ * not, the header is compiled again. The precompiled header is considered
+ * up to date if it's newer than all files which it has been built from
+ * and if it has been built with the same compiler arguments. The arguments
+ * and the list of the files are stored beside the precompiled header
+ * in a file with the .deps suffix. The file keeps a stamp of the precompiled
+ * header too, so a list which doesn't belong to the current precompiled
+ * header (e.g. after an interrupted build) is never trusted.
+ *
+ * @param compilations_ Compilation database - the same one which is used
+ *     for the parsing of the test files
+ * @param header_ The precompiled header
+ * @param pch_file_ Name of the precompiled file
+ * @exception Error if the precompiled header cannot be built
+ */
+void preparePrecompiledHeader(
+    const clang::tooling::CompilationDatabase& compilations_,
+    const std::string& header_,
+    const std::string& pch_file_);
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__OTEST2_PCH_H_ */
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sha256.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OTest2 {
+
+namespace {
+
+const std::uint32_t ROUND_CONSTANTS[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+    0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+    0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+    0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+    0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+    0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+    0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+    0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+    0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline std::uint32_t rotateRight(
+    std::uint32_t value_,
+    int bits_) {
+  return (value_ >> bits_) | (value_ << (32 - bits_));
+}
+
+} /* -- namespace */
+
+Sha256::Sha256() :
+  state{
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19},
+  block(),
+  block_size(0),
+  total_size(0) {
+
+}
+
+Sha256::~Sha256() {
+
+}
+
+void Sha256::processBlock(
+    const std::uint8_t* block_) {
+  std::uint32_t w_[64];
+  for(int i_(0); i_ < 16; ++i_) {
+    w_[i_] = (static_cast<std::uint32_t>(block_[4 * i_]) << 24)
+        | (static_cast<std::uint32_t>(block_[4 * i_ + 1]) << 16)
+        | (static_cast<std::uint32_t>(block_[4 * i_ + 2]) << 8)
+        | static_cast<std::uint32_t>(block_[4 * i_ + 3]);
+  }
+  for(int i_(16); i_ < 64; ++i_) {
+    const std::uint32_t s0_(rotateRight(w_[i_ - 15], 7)
+        ^ rotateRight(w_[i_ - 15], 18) ^ (w_[i_ - 15] >> 3));
+    const std::uint32_t s1_(rotateRight(w_[i_ - 2], 17)
+        ^ rotateRight(w_[i_ - 2], 19) ^ (w_[i_ - 2] >> 10));
+    w_[i_] = w_[i_ - 16] + s0_ + w_[i_ - 7] + s1_;
+  }
+
+  std::uint32_t a_(state[0]);
+  std::uint32_t b_(state[1]);
+  std::uint32_t c_(state[2]);
+  std::uint32_t d_(state[3]);
+  std::uint32_t e_(state[4]);
+  std::uint32_t f_(state[5]);
+  std::uint32_t g_(state[6]);
+  std::uint32_t h_(state[7]);
+  for(int i_(0); i_ < 64; ++i_) {
+    const std::uint32_t s1_(
+        rotateRight(e_, 6) ^ rotateRight(e_, 11) ^ rotateRight(e_, 25));
+    const std::uint32_t ch_((e_ & f_) ^ (~e_ & g_));
+    const std::uint32_t t1_(h_ + s1_ + ch_ + ROUND_CONSTANTS[i_] + w_[i_]);
+    const std::uint32_t s0_(
+        rotateRight(a_, 2) ^ rotateRight(a_, 13) ^ rotateRight(a_, 22));
+    const std::uint32_t maj_((a_ & b_) ^ (a_ & c_) ^ (b_ & c_));
+    const std::uint32_t t2_(s0_ + maj_);
+    h_ = g_;
+    g_ = f_;
+    f_ = e_;
+    e_ = d_ + t1_;
+    d_ = c_;
+    c_ = b_;
+    b_ = a_;
+    a_ = t1_ + t2_;
+  }
+  state[0] += a_;
+  state[1] += b_;
+  state[2] += c_;
+  state[3] += d_;
+  state[4] += e_;
+  state[5] += f_;
+  state[6] += g_;
+  state[7] += h_;
+}
+
+void Sha256::addData(
+    const void* data_,
+    std::size_t size_) {
+  const std::uint8_t* bytes_(static_cast<const std::uint8_t*>(data_));
+  total_size += size_;
+
+  /* -- fill the pending block */
+  if(block_size > 0) {
+    const std::size_t chunk_(std::min(size_, sizeof(block) - block_size));
+    std::memcpy(block + block_size, bytes_, chunk_);
+    block_size += chunk_;
+    bytes_ += chunk_;
+    size_ -= chunk_;
+    if(block_size < sizeof(block))
+      return;
+    processBlock(block);
+    block_size = 0;
+  }
+
+  /* -- process whole blocks directly from the data */
+  while(size_ >= sizeof(block)) {
+    processBlock(bytes_);
+    bytes_ += sizeof(block);
+    size_ -= sizeof(block);
+  }
+
+  /* -- keep the rest */
+  std::memcpy(block, bytes_, size_);
+  block_size = size_;
+}
+
+void Sha256::addString(
+    const std::string& string_) {
+  addData(string_.c_str(), string_.size() + 1);
+}
+
+std::string Sha256::finish() {
+  /* -- the padding */
+  const std::uint64_t bits_(total_size * 8);
+  const std::uint8_t pad_start_(0x80);
+  addData(&pad_start_, 1);
+  const std::uint8_t zero_(0);
+  while(block_size != 56)
+    addData(&zero_, 1);
+  std::uint8_t length_[8];
+  for(int i_(0); i_ < 8; ++i_)
+    length_[i_] = static_cast<std::uint8_t>(bits_ >> (56 - 8 * i_));
+  addData(length_, sizeof(length_));
+
+  /* -- format the digest */
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+  std::string digest_;
+  for(std::uint32_t word_ : state) {
+    for(int shift_(28); shift_ >= 0; shift_ -= 4)
+      digest_ += HEX_DIGITS[(word_ >> shift_) & 0x0f];
+  }
+  return digest_;
+}
+
+} /* -- namespace OTest2 */
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2021 Ondrej Starek
+ *
+ * This file is part of OTest2.
+ *
+ * OTest2 is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License,
+ * or (at your option) any later version.
+ *
+ * OTest2 is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ * or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with OTest2.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OTest2__OTEST2_SHA256_H_
+#define OTest2__OTEST2_SHA256_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OTest2 {
+
+/**
+ * @brief SHA-256 digest
+ *
+ * The digest is used for addressing of cached outputs of the preprocessor.
+ */
+class Sha256 {
+  private:
+    std::uint32_t state[8];
+    std::uint8_t block[64];
+    std::size_t block_size;
+    std::uint64_t total_size;
+
+    void processBlock(
+        const std::uint8_t* block_);
+
+  public:
+    /**
+     * @brief Ctor
+     */
+    Sha256();
+
+    /**
+     * @brief Dtor
+     */
+    ~Sha256();
+
+    /* -- avoid copying */
+    Sha256(
+        const Sha256&) = delete;
+    Sha256& operator =(
+        const Sha256&) = delete;
+
+    /**
+     * @brief Append a piece of data
+     *
+     * @param data_ The data
+     * @param size_ Size of the data in bytes
+     */
+    void addData(
+        const void* data_,
+        std::size_t size_);
+
+    /**
+     * @brief Append a string including its terminating character
+     */
+    void addString(
+        const std::string& string_);
+
+    /**
+     * @brief Finish the digest
+     *
+     * @return The digest as a hexadecimal string. The object cannot be
+     *     used for next computations.
+     */
+    std::string finish();
+};
+
+} /* -- namespace OTest2 */
+
+#endif /* -- OTest2__OTEST2_SHA256_H_ */
@@ -19,6 +19,7 @@
 
 #include "reportermock.h"
 
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -26,9 +27,11 @@
 
 #include <otest2/assertbean.h>
 #include <otest2/assertbufferstr.h>
+#include <otest2/benchmarkresult.h>
 #include <otest2/context.h>
 #include <otest2/objectpath.h>
 #include <otest2/parameters.h>
+#include <otest2/resourceusage.h>
 #include <otest2/utils.h>
 
 namespace OTest2 {
@@ -62,6 +65,8 @@ struct ReporterMock::Impl : public AssertBufferListener {
     Records records;
     std::ostringstream oss;
     bool report_paths;
+    bool report_resources;
+    bool report_fixtures;
 
     AssertBufferStrPtr assert_buffer;
 
@@ -106,6 +111,8 @@ struct ReporterMock::Impl : public AssertBufferListener {
 ReporterMock::Impl::Impl(
     bool report_paths_) :
   report_paths(report_paths_),
+  report_resources(false),
+  report_fixtures(false),
   assert_buffer(std::make_shared<AssertBufferStr>(this)){
 
 }
@@ -204,12 +211,28 @@ void ReporterMock::reportDelay(
   pimpl->addRecord();
 }
 
+void ReporterMock::reportWaitSources(
+    int count_) {
+  pimpl->oss << "waitSources<" << count_ << ">";
+  pimpl->addRecord();
+}
+
 void ReporterMock::reportDebugMessage(
     const std::string& message_) {
   pimpl->oss << "debug<" << message_ << ">";
   pimpl->addRecord();
 }
 
+void ReporterMock::setReportResources(
+    bool report_resources_) {
+  pimpl->report_resources = report_resources_;
+}
+
+void ReporterMock::setReportFixtures(
+    bool report_fixtures_) {
+  pimpl->report_fixtures = report_fixtures_;
+}
+
 std::ostream& ReporterMock::dumpRecords(
     std::ostream& os_) const {
   os_ << "std::vector<const char*> data_{" << std::endl;
@@ -241,6 +264,24 @@ AssertBean ReporterMock::checkRecords(
   return AssertBean(true, "OK");
 }
 
+AssertBean ReporterMock::checkRecordPrefixes(
+    const std::vector<const char*>& data_) const {
+  /* -- check the size */
+  if(pimpl->records.size() != data_.size())
+    return AssertBean(false, "different data size");
+
+  for(std::vector<const char*>::size_type i_(0); i_ < data_.size(); ++i_) {
+    if(pimpl->records[i_].compare(0, std::strlen(data_[i_]), data_[i_]) != 0) {
+      std::ostringstream oss_;
+      oss_ << "different item " << i_ << ": '" << pimpl->records[i_]
+           << "' doesn't start with '" << data_[i_] << "'";
+      return AssertBean(false, oss_.str());
+    }
+  }
+
+  return AssertBean(true, "OK");
+}
+
 void ReporterMock::enterTest(
     const Context& context_,
     const std::string& name_,
@@ -291,6 +332,48 @@ AssertBufferPtr ReporterMock::enterError(
   return pimpl->assert_buffer;
 }
 
+void ReporterMock::reportBenchmark(
+    const Context& context_,
+    const BenchmarkResult& result_) {
+  pimpl->oss << "benchmark<samples: " << result_.samples << ">";
+  pimpl->addRecord();
+  pimpl->reportObjectPath(context_);
+}
+
+void ReporterMock::reportResourceUsage(
+    const Context& context_,
+    const ResourceUsage& usage_) {
+  if(pimpl->report_resources) {
+    const bool valid_(
+        usage_.cpu_time >= 0
+        && usage_.user_time >= 0
+        && usage_.system_time >= 0
+        && usage_.max_rss >= 0
+        && usage_.minor_faults >= 0
+        && usage_.major_faults >= 0
+        && usage_.voluntary_switches >= 0
+        && usage_.involuntary_switches >= 0
+        && usage_.allocations >= 0
+        && usage_.deallocations >= 0
+        && usage_.allocated_bytes >= 0);
+    pimpl->oss << "resources<" << (valid_ ? "valid" : "invalid") << ">";
+    pimpl->addRecord();
+    pimpl->reportObjectPath(context_);
+  }
+}
+
+void ReporterMock::reportFixture(
+    const Context& context_,
+    bool start_up_,
+    int index_,
+    TimeSource::time_point begin_) {
+  if(pimpl->report_fixtures) {
+    pimpl->oss << (start_up_ ? "startUp<" : "tearDown<") << index_ << ">";
+    pimpl->addRecord();
+    pimpl->reportObjectPath(context_);
+  }
+}
+
 void ReporterMock::leaveState(
     const Context& context_,
     const std::string& name_,
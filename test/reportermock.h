@@ -69,6 +69,14 @@ class ReporterMock : public Reporter {
     void reportDelay(
         int delay_ms_);
 
+    /**
+     * @brief Add a record for wait sources of a delay between test steps
+     *
+     * @param count_ Number of the wait sources
+     */
+    void reportWaitSources(
+        int count_);
+
     /**
      * @brief Report a generic message
      *
@@ -77,6 +85,29 @@ class ReporterMock : public Reporter {
     void reportDebugMessage(
         const std::string& message_);
 
+    /**
+     * @brief Enable records of the resource usage
+     *
+     * The usage is not reported by default as it would change records
+     * of all other tests. The measured values are not predictable, so just
+     * their sanity is recorded.
+     *
+     * @param report_resources_ Enable/disable the records
+     */
+    void setReportResources(
+        bool report_resources_);
+
+    /**
+     * @brief Enable records of the start-up and tear-down functions
+     *
+     * The functions are not reported by default as it would change
+     * records of all other tests.
+     *
+     * @param report_fixtures_ Enable/disable the records
+     */
+    void setReportFixtures(
+        bool report_fixtures_);
+
     /**
      * @brief Print the records into an output stream
      *
@@ -92,6 +123,15 @@ class ReporterMock : public Reporter {
     AssertBean checkRecords(
         const std::vector<const char*>& data_) const;
 
+    /**
+     * @brief Check whether the records start with the expected texts
+     *
+     * This check is used if the end of some records is not predictable
+     * (e.g. measured times).
+     */
+    AssertBean checkRecordPrefixes(
+        const std::vector<const char*>& data_) const;
+
     /* -- reporter interface */
     virtual void enterTest(
         const Context& context_,
@@ -115,6 +155,17 @@ class ReporterMock : public Reporter {
         int lineno_);
     virtual AssertBufferPtr enterError(
         const Context& context_);
+    virtual void reportBenchmark(
+        const Context& context_,
+        const BenchmarkResult& result_);
+    virtual void reportResourceUsage(
+        const Context& context_,
+        const ResourceUsage& usage_);
+    virtual void reportFixture(
+        const Context& context_,
+        bool start_up_,
+        int index_,
+        TimeSource::time_point begin_);
     virtual void leaveState(
         const Context& context_,
         const std::string& name_,
@@ -187,6 +187,8 @@ bool Runtime::runTheTest() {
     if(result_.isFinished())
       break;
     reporter.reportDelay(result_.getDelayMS());
+    if(!result_.getWaitSources().empty())
+      reporter.reportWaitSources(result_.getWaitSources().size());
   };
 
   return result_.getResult();
@@ -24,7 +24,8 @@ namespace OTest2 {
 namespace Test {
 
 TimeSourceMock::TimeSourceMock() :
-  just_now(std::chrono::minutes(60 * 27 + 31)) {
+  just_now(std::chrono::minutes(60 * 27 + 31)),
+  fast_forward(false) {
 
 }
 
@@ -42,10 +43,22 @@ void TimeSourceMock::addTime(
   just_now += shift_;
 }
 
+void TimeSourceMock::setFastForward(
+    bool enabled_) {
+  fast_forward = enabled_;
+}
+
 TimeSourceMock::time_point TimeSourceMock::now() {
   return just_now;
 }
 
+bool TimeSourceMock::fastForward(
+    TimeSourceMock::duration delay_) {
+  if(fast_forward)
+    just_now += delay_;
+  return fast_forward;
+}
+
 } /* -- namespace Test */
 
 } /* -- namespace OTest2 */
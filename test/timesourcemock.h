@@ -32,6 +32,7 @@ namespace Test {
 class TimeSourceMock : public TimeSource {
   private:
     time_point just_now;
+    bool fast_forward;
 
   public:
     /**
@@ -66,8 +67,19 @@ class TimeSourceMock : public TimeSource {
     void addTime(
         const duration& shift_);
 
+    /**
+     * @brief Make the mocked time virtual
+     *
+     * @param enabled_ If it's true, the time source fast-forwards
+     *     the delays of the test states.
+     */
+    void setFastForward(
+        bool enabled_);
+
     /* -- time source interface */
     virtual time_point now() override;
+    virtual bool fastForward(
+        duration delay_) override;
 };
 
 } /* -- namespace Test */